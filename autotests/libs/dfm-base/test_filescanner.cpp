@@ -11,8 +11,12 @@
 #include <QSignalSpy>
 #include <QEventLoop>
 #include <QTimer>
+#include <QStandardPaths>
 
 #include <dfm-base/utils/filescanner.h>
+#include <dfm-base/utils/dirsizecache.h>
+
+#include <unistd.h>
 
 using namespace dfmbase;
 
@@ -187,3 +191,72 @@ TEST_F(TestFileScanner, ScanSyncWithCallback_BasicScan)
     EXPECT_EQ(result.directoryCount, 2);
     EXPECT_EQ(result.totalSize, 12);
 }
+
+TEST_F(TestFileScanner, ScanSync_Parallel_MatchesSerial)
+{
+    for (int i = 0; i < 20; ++i) {
+        const QString dir = QString("%1/deep%2/nested").arg(rootPath).arg(i);
+        ASSERT_TRUE(QDir().mkpath(dir));
+        ASSERT_TRUE(writeFile(dir + "/file.txt", "12345"));
+    }
+
+    auto serial = FileScanner::scanSync({QUrl::fromLocalFile(rootPath)});
+    auto parallel = FileScanner::scanSync(
+            {QUrl::fromLocalFile(rootPath)},
+            FileScanner::ScanOption::Parallel);
+
+    EXPECT_EQ(parallel.fileCount, serial.fileCount);
+    EXPECT_EQ(parallel.directoryCount, serial.directoryCount);
+    EXPECT_EQ(parallel.totalSize, serial.totalSize);
+    EXPECT_EQ(parallel.fileCount, 23);
+    EXPECT_EQ(parallel.directoryCount, 42);
+}
+
+TEST_F(TestFileScanner, ScanSync_Parallel_HardlinkCountedOnce)
+{
+    for (int i = 0; i < 8; ++i) {
+        const QString dir = QString("%1/links%2").arg(rootPath).arg(i);
+        ASSERT_TRUE(QDir().mkpath(dir));
+        ASSERT_EQ(::link(fileC.toUtf8().constData(), (dir + "/hardlink").toUtf8().constData()), 0);
+    }
+
+    auto result = FileScanner::scanSync(
+            {QUrl::fromLocalFile(rootPath)},
+            FileScanner::ScanOption::Parallel);
+
+    EXPECT_EQ(result.fileCount, 11);
+    EXPECT_EQ(result.totalSize, 12);
+}
+
+TEST_F(TestFileScanner, ScanSync_SizeCache_InvalidatedByEvent)
+{
+    QStandardPaths::setTestModeEnabled(true);
+
+    const QString bigDir = rootPath + "/big";
+    ASSERT_TRUE(QDir().mkpath(bigDir));
+    for (int i = 0; i < 100; ++i)
+        ASSERT_TRUE(writeFile(QString("%1/f%2").arg(bigDir).arg(i), "x"));
+
+    const auto options = FileScanner::ScanOption::UseSizeCache;
+    auto first = FileScanner::scanSync({QUrl::fromLocalFile(rootPath)}, options);
+    auto second = FileScanner::scanSync({QUrl::fromLocalFile(rootPath)}, options);
+    EXPECT_EQ(first.fileCount, 103);
+    EXPECT_EQ(first.totalSize, 112);
+    EXPECT_EQ(second.fileCount, first.fileCount);
+    EXPECT_EQ(second.directoryCount, first.directoryCount);
+    EXPECT_EQ(second.totalSize, first.totalSize);
+
+    // 原地改写不会改变目录 mtime，依赖事件使缓存失效
+    const QString changed = bigDir + "/f0";
+    {
+        QFile f(changed);
+        ASSERT_TRUE(f.open(QIODevice::ReadWrite));
+        f.seek(1);
+        f.write("yyyy");
+    }
+    DirSizeCache::instance()->invalidate(changed);
+
+    auto third = FileScanner::scanSync({QUrl::fromLocalFile(rootPath)}, options);
+    EXPECT_EQ(third.fileCount, 103);
+    EXPECT_EQ(third.totalSize, 116);
+}
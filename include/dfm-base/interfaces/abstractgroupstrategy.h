@@ -29,6 +29,11 @@ class AbstractGroupStrategy : public QObject
     Q_OBJECT
 
 public:
+    /**
+     * @brief Returned by getGroupOrdinal() when the strategy has no ordinal for a file
+     */
+    static constexpr int kInvalidGroupOrdinal = -1;
+
     explicit AbstractGroupStrategy(QObject *parent = nullptr)
         : QObject(parent) { }
     virtual ~AbstractGroupStrategy() = default;
@@ -60,6 +65,61 @@ public:
         return getGroupKey(info);
     }
 
+    /**
+     * @brief Get a dense integer ordinal identifying the group of a file
+     *
+     * Strategies with a small, enumerable set of groups can override this
+     * together with getGroupKeyOfOrdinal() so the grouping engine can bucket
+     * files by integer instead of building and hashing a key string per file.
+     * Ordinals should be small and dense, starting from 0.
+     *
+     * The default returns kInvalidGroupOrdinal, in which case the engine falls
+     * back to getGroupKey().
+     *
+     * @param info The file info to classify (always non-null)
+     * @param sortInfo The sort info to classify (may be null when not carried)
+     * @return The group ordinal, or kInvalidGroupOrdinal
+     */
+    virtual int getGroupOrdinal(const FileInfoPointer &info, const SortInfoPointer &sortInfo) const
+    {
+        Q_UNUSED(info)
+        Q_UNUSED(sortInfo)
+        return kInvalidGroupOrdinal;
+    }
+
+    /**
+     * @brief Get the group key identified by an ordinal from getGroupOrdinal()
+     * @param ordinal The group ordinal
+     * @return The group key, as getGroupKey() would have returned it
+     */
+    virtual QString getGroupKeyOfOrdinal(int ordinal) const
+    {
+        Q_UNUSED(ordinal)
+        return QString();
+    }
+
+    /**
+     * @brief Prepare for classifying a batch of files
+     *
+     * Called once before a grouping pass, on the grouping thread. Strategies
+     * may capture per-pass state here (e.g. the reference time) so it is not
+     * recomputed for every file, and so every file of the pass is classified
+     * against the same state.
+     */
+    virtual void beginGroupClassification() { }
+
+    /**
+     * @brief Whether getGroupKey()/getGroupOrdinal() may be called concurrently
+     *
+     * When true, the grouping engine may classify large file lists on several
+     * threads at once. Strategies that mutate state during classification
+     * must keep the default.
+     */
+    virtual bool isConcurrentClassificationSafe() const
+    {
+        return false;
+    }
+
     /**
      * @brief Get the display name for a group key
      * @param groupKey The internal group key
@@ -5,9 +5,17 @@
 #include "controllerpipe.h"
 
 #include <QDataStream>
+#include <QMetaMethod>
 #include <QProcess>
+#include <QProcessEnvironment>
 #include <QTimer>
 
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
 EXTRACTOR_BEGIN_NAMESPACE
 
 class ControllerPipePrivate
@@ -17,6 +25,7 @@ public:
     QByteArray inputBuffer;
     bool waitingForComplete = false;
     qint32 expectedSize = 0;
+    int payloadSocket = -1;   // Parent end of the memfd passing socket
 
     void clearState()
     {
@@ -24,6 +33,53 @@ public:
         waitingForComplete = false;
         expectedSize = 0;
     }
+
+    void closePayloadSocket()
+    {
+        if (payloadSocket >= 0) {
+            ::close(payloadSocket);
+            payloadSocket = -1;
+        }
+    }
+
+    /**
+     * @brief Receive the memfd announced by a SharedData message
+     *
+     * The worker sends the descriptor before writing the message to the
+     * pipe, so it is already queued when the message is parsed.
+     */
+    int receivePayloadFd()
+    {
+        if (payloadSocket < 0)
+            return -1;
+
+        char byte = 0;
+        iovec iov { &byte, sizeof(byte) };
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] {};
+
+        msghdr msg {};
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        ssize_t received = -1;
+        do {
+            received = ::recvmsg(payloadSocket, &msg, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+        } while (received < 0 && errno == EINTR);
+
+        if (received <= 0)
+            return -1;
+
+        for (cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+                int fd = -1;
+                memcpy(&fd, CMSG_DATA(cmsg), sizeof(fd));
+                return fd;
+            }
+        }
+        return -1;
+    }
 };
 
 ControllerPipe::ControllerPipe(QObject *parent)
@@ -85,6 +141,7 @@ bool ControllerPipe::start(const QString &extractorPath, const QString &pluginPa
 
                 if (d->process == finishedProcess) {
                     d->process = nullptr;
+                    d->closePayloadSocket();
                 }
 
                 if (finishedProcess) {
@@ -92,6 +149,26 @@ bool ControllerPipe::start(const QString &extractorPath, const QString &pluginPa
                 }
             });
 
+    // Socket used to pass memfds carrying large results. The extractor
+    // still works without it and falls back to sending data inline.
+    d->closePayloadSocket();
+    int sockets[2] = { -1, -1 };
+    if (::socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sockets) == 0) {
+        d->payloadSocket = sockets[0];
+        const int childSocket = sockets[1];
+
+        QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+        env.insert(QString::fromLatin1(kPayloadSocketEnv), QString::number(childSocket));
+        d->process->setProcessEnvironment(env);
+        d->process->setChildProcessModifier([childSocket]() {
+            // Only the child end may survive exec
+            ::fcntl(childSocket, F_SETFD, 0);
+        });
+    } else {
+        fmWarning() << "ControllerPipe: Failed to create payload socket, large results will be sent inline:"
+                    << strerror(errno);
+    }
+
     // Prepare arguments
     QStringList arguments;
     if (!pluginPath.isEmpty()) {
@@ -104,12 +181,17 @@ bool ControllerPipe::start(const QString &extractorPath, const QString &pluginPa
 
     d->process->start(extractorPath, arguments, QIODevice::ReadWrite);
 
-    if (!d->process->waitForStarted(5000)) {
+    const bool started = d->process->waitForStarted(5000);
+    if (sockets[1] >= 0)
+        ::close(sockets[1]);
+
+    if (!started) {
         fmCritical() << "ControllerPipe: Failed to start process:"
                      << d->process->errorString();
         emit errorOccurred(QString("Failed to start process: %1").arg(d->process->errorString()));
         d->process->deleteLater();
         d->process = nullptr;
+        d->closePayloadSocket();
         return false;
     }
 
@@ -175,6 +257,7 @@ void ControllerPipe::handleStatusMessage(const QByteArray &messageData)
 
     QString filePath;
     QByteArray data;
+    qint64 sharedSize = 0;
     QString error;
 
     if (status != ExtractorStatus::BatchDone) {
@@ -183,6 +266,8 @@ void ControllerPipe::handleStatusMessage(const QByteArray &messageData)
 
     if (status == ExtractorStatus::Data) {
         messageStream >> data;
+    } else if (status == ExtractorStatus::SharedData) {
+        messageStream >> sharedSize;
     } else if (status == ExtractorStatus::Failed) {
         // Fix: failed packets now carry an explicit error string after filePath.
         messageStream >> error;
@@ -196,7 +281,7 @@ void ControllerPipe::handleStatusMessage(const QByteArray &messageData)
 
     case ExtractorStatus::Finished:
         fmDebug() << "ControllerPipe: Extraction finished for:" << filePath;
-        emit extractionFinished(filePath, data);
+        deliverPayload(filePath, ExtractionPayload(data));
         break;
 
     case ExtractorStatus::Failed:
@@ -207,8 +292,22 @@ void ControllerPipe::handleStatusMessage(const QByteArray &messageData)
     case ExtractorStatus::Data:
         fmDebug() << "ControllerPipe: Received data for:" << filePath
                   << "size:" << data.size();
-        emit extractionFinished(filePath, data);
+        deliverPayload(filePath, ExtractionPayload(data));
+        break;
+
+    case ExtractorStatus::SharedData: {
+        ExtractionPayload payload = ExtractionPayload::fromMemfd(d->receivePayloadFd(), sharedSize);
+        if (payload.isNull()) {
+            fmWarning() << "ControllerPipe: Failed to receive shared data for:" << filePath
+                        << "size:" << sharedSize;
+            emit extractionFailed(filePath, QStringLiteral("Failed to receive shared extraction result"));
+            break;
+        }
+        fmDebug() << "ControllerPipe: Received shared data for:" << filePath
+                  << "size:" << payload.size();
+        deliverPayload(filePath, payload);
         break;
+    }
 
     case ExtractorStatus::BatchDone:
         fmDebug() << "ControllerPipe: Batch completed";
@@ -243,9 +342,20 @@ void ControllerPipe::stop()
         process->deleteLater();
     }
 
+    d->closePayloadSocket();
     d->clearState();
 }
 
+void ControllerPipe::deliverPayload(const QString &filePath, const ExtractionPayload &payload)
+{
+    emit payloadReady(filePath, payload);
+
+    // Materializing a shared payload costs a full copy, skip it when
+    // nobody listens to the legacy signal.
+    if (isSignalConnected(QMetaMethod::fromSignal(&ControllerPipe::extractionFinished)))
+        emit extractionFinished(filePath, payload.toByteArray());
+}
+
 bool ControllerPipe::hasPendingPartialMessage() const
 {
     return d->waitingForComplete || !d->inputBuffer.isEmpty();
@@ -7,6 +7,7 @@
 
 #include "extractor_global.h"
 #include "extractortypes.h"
+#include "extractionpayload.h"
 
 #include <QObject>
 #include <QProcess>
@@ -75,9 +76,19 @@ signals:
      * @brief Emitted when extraction completes successfully
      * @param filePath The file that was processed
      * @param data The extracted content
+     *
+     * This signal copies shared payloads into a QByteArray and is only
+     * emitted when something is connected to it. Prefer payloadReady().
      */
     void extractionFinished(const QString &filePath, const QByteArray &data);
 
+    /**
+     * @brief Emitted when extraction completes successfully
+     * @param filePath The file that was processed
+     * @param payload The extracted content, possibly mapped from shared memory
+     */
+    void payloadReady(const QString &filePath, const ExtractionPayload &payload);
+
     /**
      * @brief Emitted when extraction fails
      * @param filePath The file that failed
@@ -111,6 +122,7 @@ private:
     void processInputBuffer();
     void handleStatusMessage(const QByteArray &messageData);
     bool hasPendingPartialMessage() const;
+    void deliverPayload(const QString &filePath, const ExtractionPayload &payload);
 
     QScopedPointer<ControllerPipePrivate> d;
 };
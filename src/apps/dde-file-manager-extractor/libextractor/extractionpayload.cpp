@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "extractionpayload.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+EXTRACTOR_BEGIN_NAMESPACE
+
+struct ExtractionPayload::Mapping
+{
+    void *address = nullptr;
+    size_t length = 0;
+
+    ~Mapping()
+    {
+        if (address)
+            ::munmap(address, length);
+    }
+};
+
+ExtractionPayload::ExtractionPayload(const QByteArray &data)
+    : inlineData(data), valid(true)
+{
+}
+
+ExtractionPayload ExtractionPayload::fromMemfd(int fd, qint64 size)
+{
+    if (fd < 0)
+        return ExtractionPayload();
+
+    ExtractionPayload payload;
+
+    // The worker seals the memfd before sending it. Without the shrink seal
+    // the file could be truncated under our mapping and reading it would
+    // raise SIGBUS, so refuse unsealed descriptors.
+    const int seals = ::fcntl(fd, F_GET_SEALS);
+    struct stat st;
+    if (size < 0 || seals < 0 || !(seals & F_SEAL_SHRINK) || !(seals & F_SEAL_WRITE)
+        || ::fstat(fd, &st) != 0 || st.st_size < size) {
+        fmWarning() << "ExtractionPayload: Rejecting shared payload descriptor, size:" << size
+                    << "seals:" << seals;
+        ::close(fd);
+        return payload;
+    }
+
+    if (size == 0) {
+        ::close(fd);
+        payload.valid = true;
+        return payload;
+    }
+
+    void *address = ::mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        fmWarning() << "ExtractionPayload: Failed to map shared payload, size:" << size
+                    << "error:" << strerror(errno);
+        return payload;
+    }
+
+    auto mapping = QSharedPointer<Mapping>::create();
+    mapping->address = address;
+    mapping->length = static_cast<size_t>(size);
+    payload.mapping = mapping;
+    payload.valid = true;
+    return payload;
+}
+
+bool ExtractionPayload::isNull() const
+{
+    return !valid;
+}
+
+bool ExtractionPayload::isShared() const
+{
+    return !mapping.isNull();
+}
+
+const char *ExtractionPayload::constData() const
+{
+    return mapping ? static_cast<const char *>(mapping->address) : inlineData.constData();
+}
+
+qsizetype ExtractionPayload::size() const
+{
+    return mapping ? static_cast<qsizetype>(mapping->length) : inlineData.size();
+}
+
+QByteArrayView ExtractionPayload::view() const
+{
+    return QByteArrayView(constData(), size());
+}
+
+QByteArray ExtractionPayload::toByteArray() const
+{
+    return mapping ? QByteArray(constData(), size()) : inlineData;
+}
+
+EXTRACTOR_END_NAMESPACE
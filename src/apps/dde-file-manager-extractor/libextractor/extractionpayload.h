@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef EXTRACTIONPAYLOAD_H
+#define EXTRACTIONPAYLOAD_H
+
+#include "extractor_global.h"
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QMetaType>
+#include <QSharedPointer>
+
+EXTRACTOR_BEGIN_NAMESPACE
+
+/**
+ * @brief Extracted content received from the extractor subprocess.
+ *
+ * Small results arrive inline over the pipe and are held in a QByteArray.
+ * Large results are passed as a sealed memfd and stay mapped read-only in
+ * this process for as long as any copy of the payload is alive, so
+ * receivers can decode the text straight from the shared pages.
+ *
+ * The class is implicitly shared and safe to pass through queued
+ * connections.
+ */
+class ExtractionPayload
+{
+public:
+    ExtractionPayload() = default;
+    explicit ExtractionPayload(const QByteArray &data);
+
+    /**
+     * @brief Map a sealed memfd sent by the worker
+     * @param fd File descriptor, always closed by this call
+     * @param size Payload size announced by the worker
+     * @return A null payload if the descriptor is unusable
+     */
+    static ExtractionPayload fromMemfd(int fd, qint64 size);
+
+    bool isNull() const;
+    bool isShared() const;
+
+    const char *constData() const;
+    qsizetype size() const;
+    QByteArrayView view() const;
+
+    /**
+     * @brief Deep copy of the payload
+     */
+    QByteArray toByteArray() const;
+
+private:
+    struct Mapping;
+
+    QByteArray inlineData;
+    QSharedPointer<const Mapping> mapping;
+    bool valid { false };
+};
+
+EXTRACTOR_END_NAMESPACE
+
+Q_DECLARE_METATYPE(EXTRACTOR_NAMESPACE::ExtractionPayload)
+
+#endif   // EXTRACTIONPAYLOAD_H
@@ -21,9 +21,25 @@ enum class ExtractorStatus : quint8 {
     Finished = 'F',    // Successfully completed
     Failed = 'f',      // Processing failed
     Data = 'D',        // Data ready (path + data)
+    SharedData = 'M',  // Data ready in a memfd (path + size), fd sent over the payload socket
     BatchDone = 'B'    // Batch completed
 };
 
+/**
+ * @brief Environment variable carrying the worker end of the payload socket
+ *
+ * The controller creates an AF_UNIX socket pair and hands one end to the
+ * worker. Large results are written to a sealed memfd whose descriptor is
+ * passed over this socket, while the pipe only carries a small SharedData
+ * descriptor message.
+ */
+inline constexpr char kPayloadSocketEnv[] = "DFM_EXTRACTOR_PAYLOAD_FD";
+
+/**
+ * @brief Results smaller than this are sent inline over the pipe
+ */
+inline constexpr qsizetype kSharedPayloadThreshold = 64 * 1024;
+
 /**
  * @brief Convert ExtractorStatus to string for logging
  */
@@ -38,6 +54,8 @@ inline const char* statusToString(ExtractorStatus status)
         return "Failed";
     case ExtractorStatus::Data:
         return "Data";
+    case ExtractorStatus::SharedData:
+        return "SharedData";
     case ExtractorStatus::BatchDone:
         return "BatchDone";
     default:
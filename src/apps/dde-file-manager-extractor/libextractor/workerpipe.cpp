@@ -10,7 +10,10 @@
 #include <QSocketNotifier>
 #include <cstdio>
 #include <cerrno>
+#include <cstring>
 #include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
 #include <unistd.h>
 
 EXTRACTOR_BEGIN_NAMESPACE
@@ -28,6 +31,7 @@ public:
     qint32 expectedSize = 0;
     bool initialized = false;
     int outputFd = -1;
+    int payloadFd = -1;   // Worker end of the memfd passing socket, -1 if unavailable
 };
 
 WorkerPipe::WorkerPipe(QObject *parent)
@@ -40,6 +44,9 @@ WorkerPipe::~WorkerPipe()
     if (d->outputFd >= 0) {
         ::close(d->outputFd);
     }
+    if (d->payloadFd >= 0) {
+        ::close(d->payloadFd);
+    }
 }
 
 bool WorkerPipe::initialize()
@@ -60,6 +67,8 @@ bool WorkerPipe::initialize()
         return false;
     }
 
+    setupPayloadChannel();
+
     // Create socket notifier to watch stdin
     d->stdinNotifier = new QSocketNotifier(STDIN_FILENO, QSocketNotifier::Read, this);
     connect(d->stdinNotifier, &QSocketNotifier::activated, this, [this]() {
@@ -161,12 +170,7 @@ bool WorkerPipe::sendStatus(ExtractorStatus status, const QString &filePath, con
         messageStream << QString::fromUtf8(data);
     }
 
-    QByteArray packetData;
-    QDataStream packetStream(&packetData, QIODevice::WriteOnly);
-    packetStream << static_cast<qint32>(messageData.size());
-    packetData.append(messageData);
-
-    if (!writePacket(packetData)) {
+    if (!writeMessage(messageData)) {
         fmCritical() << "WorkerPipe::sendStatus: Failed to write packet";
         return false;
     }
@@ -177,6 +181,89 @@ bool WorkerPipe::sendStatus(ExtractorStatus status, const QString &filePath, con
     return true;
 }
 
+bool WorkerPipe::sendSharedData(const QString &filePath, const QByteArray &data)
+{
+    const int memFd = ::memfd_create("dfm-extractor-payload", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (memFd < 0) {
+        fmWarning() << "WorkerPipe::sendSharedData: memfd_create failed:" << strerror(errno);
+        return false;
+    }
+
+    // Fill and seal the memfd so the controller can map it without fearing
+    // later modification or truncation
+    qint64 totalWritten = 0;
+    while (totalWritten < data.size()) {
+        const ssize_t bytesWritten = ::write(memFd, data.constData() + totalWritten,
+                                             static_cast<size_t>(data.size() - totalWritten));
+        if (bytesWritten < 0 && errno == EINTR)
+            continue;
+        if (bytesWritten <= 0) {
+            fmWarning() << "WorkerPipe::sendSharedData: Failed to fill memfd:" << strerror(errno);
+            ::close(memFd);
+            return false;
+        }
+        totalWritten += bytesWritten;
+    }
+
+    if (::fcntl(memFd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) != 0) {
+        fmWarning() << "WorkerPipe::sendSharedData: Failed to seal memfd:" << strerror(errno);
+        ::close(memFd);
+        return false;
+    }
+
+    // The descriptor goes first so it is already queued on the socket when
+    // the controller parses the SharedData message from the pipe
+    char byte = 0;
+    iovec iov { &byte, sizeof(byte) };
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] {};
+
+    msghdr msg {};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(cmsg), &memFd, sizeof(int));
+
+    ssize_t sent = -1;
+    do {
+        sent = ::sendmsg(d->payloadFd, &msg, MSG_NOSIGNAL);
+    } while (sent < 0 && errno == EINTR);
+    ::close(memFd);
+
+    if (sent < 0) {
+        fmWarning() << "WorkerPipe::sendSharedData: Failed to pass memfd, disabling shared payloads:"
+                    << strerror(errno);
+        ::close(d->payloadFd);
+        d->payloadFd = -1;
+        return false;
+    }
+
+    QByteArray messageData;
+    QDataStream messageStream(&messageData, QIODevice::WriteOnly);
+    messageStream << static_cast<quint8>(ExtractorStatus::SharedData);
+    messageStream << filePath;
+    messageStream << static_cast<qint64>(data.size());
+
+    if (!writeMessage(messageData)) {
+        // The queued descriptor no longer matches any message, stop using
+        // the socket so later results cannot be paired with it
+        fmCritical() << "WorkerPipe::sendSharedData: Failed to write packet";
+        ::close(d->payloadFd);
+        d->payloadFd = -1;
+        return false;
+    }
+
+    fmDebug() << "WorkerPipe::sendSharedData: Sent shared data for" << filePath
+              << "data size:" << data.size();
+
+    return true;
+}
+
 bool WorkerPipe::sendStarted(const QString &filePath)
 {
     return sendStatus(ExtractorStatus::Started, filePath);
@@ -184,6 +271,11 @@ bool WorkerPipe::sendStarted(const QString &filePath)
 
 bool WorkerPipe::sendData(const QString &filePath, const QByteArray &data)
 {
+    if (d->initialized && d->payloadFd >= 0 && data.size() >= kSharedPayloadThreshold
+        && sendSharedData(filePath, data)) {
+        return true;
+    }
+
     return sendStatus(ExtractorStatus::Data, filePath, data);
 }
 
@@ -197,6 +289,16 @@ bool WorkerPipe::sendBatchDone()
     return sendStatus(ExtractorStatus::BatchDone);
 }
 
+bool WorkerPipe::writeMessage(const QByteArray &messageData)
+{
+    QByteArray packetData;
+    QDataStream packetStream(&packetData, QIODevice::WriteOnly);
+    packetStream << static_cast<qint32>(messageData.size());
+    packetData.append(messageData);
+
+    return writePacket(packetData);
+}
+
 bool WorkerPipe::writePacket(const QByteArray &packetData)
 {
     qint64 totalWritten = 0;
@@ -252,4 +354,28 @@ bool WorkerPipe::setupOutputChannel()
     return true;
 }
 
+void WorkerPipe::setupPayloadChannel()
+{
+    const QByteArray value = qgetenv(kPayloadSocketEnv);
+    if (value.isEmpty())
+        return;
+
+    bool ok = false;
+    const int fd = value.toInt(&ok);
+    ::unsetenv(kPayloadSocketEnv);
+
+    int type = 0;
+    socklen_t typeLen = sizeof(type);
+    if (!ok || fd < 0 || ::getsockopt(fd, SOL_SOCKET, SO_TYPE, &type, &typeLen) != 0
+        || type != SOCK_SEQPACKET) {
+        fmWarning() << "WorkerPipe::setupPayloadChannel: Ignoring invalid payload socket:" << value;
+        return;
+    }
+
+    // Do not leak the socket into anything the extractor plugins may spawn
+    ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+    d->payloadFd = fd;
+    fmDebug() << "WorkerPipe: Shared payload channel enabled";
+}
+
 EXTRACTOR_END_NAMESPACE
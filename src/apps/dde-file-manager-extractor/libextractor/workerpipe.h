@@ -53,6 +53,10 @@ public:
 
     /**
      * @brief Send extraction finished with data
+     *
+     * Results of at least kSharedPayloadThreshold bytes are handed to the
+     * controller as a sealed memfd when the payload socket is available,
+     * smaller ones (or when that fails) are sent inline.
      */
     bool sendData(const QString &filePath, const QByteArray &data);
 
@@ -89,9 +93,12 @@ signals:
 private:
     bool readFromStdin();
     void processInputBuffer();
+    bool writeMessage(const QByteArray &messageData);
     bool writePacket(const QByteArray &packetData);
+    bool sendSharedData(const QString &filePath, const QByteArray &data);
     bool hasPendingPartialMessage() const;
     bool setupOutputChannel();
+    void setupPayloadChannel();
 
     QScopedPointer<WorkerPipePrivate> d;
 };
@@ -6,6 +6,7 @@
 #include "private/application_p.h"
 
 #include "base/application/settings.h"
+#include "base/application/viewstatestore.h"
 
 #include <QCoreApplication>
 #include <QMetaEnum>
@@ -147,40 +148,13 @@ void Application::setAppAttribute(Application::ApplicationAttribute aa, const QV
     const QMetaEnum &me = QMetaEnum::fromType<ApplicationAttribute>();
     const QString key = QString::fromLatin1(me.valueToKey(aa)).remove(0, 1);
 
-    // clear all self iconSize, use globbal iconSize
+    // directories with their own level follow the new global level, resolved lazily by the store
     if (key == "IconSizeLevel") {
-        auto settings = appObtuselySetting();
-        const QStringList &keys = settings->keyList("FileViewState");
-        for (const QString &url : keys) {
-            auto map = settings->value("FileViewState", url).toMap();
-            if (map.contains("iconSizeLevel")) {
-                qCDebug(logDFMBase) << "reset" << url << "iconSizeLevel to " << value.toInt();
-                map["iconSizeLevel"] = value;
-                settings->setValue("FileViewState", url, map);
-            }
-        }
+        ViewStateStore::instance()->resetKey("iconSizeLevel", value);
     } else if (key == "GridDensityLevel") {
-        auto settings = appObtuselySetting();
-        const QStringList &keys = settings->keyList("FileViewState");
-        for (const QString &url : keys) {
-            auto map = settings->value("FileViewState", url).toMap();
-            if (map.contains("gridDensityLevel")) {
-                qCDebug(logDFMBase) << "reset" << url << "gridDensityLevel to " << value.toInt();
-                map["gridDensityLevel"] = value;
-                settings->setValue("FileViewState", url, map);
-            }
-        }
+        ViewStateStore::instance()->resetKey("gridDensityLevel", value);
     } else if (key == "ListHeightLevel") {
-        auto settings = appObtuselySetting();
-        const QStringList &keys = settings->keyList("FileViewState");
-        for (const QString &url : keys) {
-            auto map = settings->value("FileViewState", url).toMap();
-            if (map.contains("listHeightLevel")) {
-                qCDebug(logDFMBase) << "reset" << url << "listHeightLevel to " << value.toInt();
-                map["listHeightLevel"] = value;
-                settings->setValue("FileViewState", url, map);
-            }
-        }
+        ViewStateStore::instance()->resetKey("listHeightLevel", value);
     }
 
     appSetting()->setValue(group, key, value);
@@ -306,33 +280,10 @@ void Application::appAttributeTrigger(TriggerAttribute ta, quint64 winId)
     switch (ta) {
     case kRestoreViewMode: {
         auto defaultViewMode = appAttribute(Application::kViewMode).toInt();
-        auto settings = appObtuselySetting();
-
-        const QString &kGroupName = "FileViewState";
-        const QString &kViewModeKey = "viewMode";
-
-        const QStringList &keys = settings->keyList(kGroupName);
-        const QStringList &defaultKeys = settings->defaultConfigkeyList(kGroupName);
-        for (const QString &url : keys) {
-            auto map = settings->value(kGroupName, url).toMap();
-
-            if (defaultKeys.contains(url)) {
-                auto defaultMap = settings->defaultConfigValue(kGroupName, url).toMap();
-                if (defaultMap.contains(kViewModeKey) && defaultMap[kViewModeKey] != defaultViewMode) {
-                    map.insert(kViewModeKey, defaultMap.value(kViewModeKey));
-                    settings->setValue(kGroupName, url, map);
-                    continue;
-                }
-            }
-
-            if (map.contains(kViewModeKey)) {
-                qCDebug(logDFMBase) << "Remove " << url << "viewMode";
-                map.remove(kViewModeKey);
-                settings->setValue(kGroupName, url, map);
-            }
-        }
 
-        settings->sync();
+        // drop every directory's own view mode, directories with a default config keep theirs
+        ViewStateStore::instance()->resetKey("viewMode");
+        ViewStateStore::instance()->sync();
 
         if (instance())
             Q_EMIT instance()->viewModeChanged(defaultViewMode);
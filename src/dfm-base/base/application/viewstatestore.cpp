@@ -0,0 +1,416 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "viewstatestore.h"
+
+#include <dfm-base/base/application/application.h>
+#include <dfm-base/base/application/settings.h>
+#include <dfm-base/base/standardpaths.h>
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QJsonDocument>
+#include <QLockFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QTimer>
+
+#include <sys/stat.h>
+
+namespace dfmbase {
+
+namespace {
+const QString kLegacyGroup { "FileViewState" };
+const QString kRecUrl { "u" };
+const QString kRecKey { "k" };
+const QString kRecValue { "v" };
+const QString kRecReset { "r" };
+
+constexpr int kFlushDelayMs { 500 };
+constexpr int kLockTimeoutMs { 100 };
+// 记录数超过有效条目数的两倍且不少于此值时压缩日志
+constexpr int kMinCompactRecords { 512 };
+}   // namespace
+
+ViewStateStore *ViewStateStore::instance()
+{
+    static ViewStateStore ins;
+    return &ins;
+}
+
+ViewStateStore::ViewStateStore()
+{
+    flushTimer = new QTimer(this);
+    flushTimer->setSingleShot(true);
+    flushTimer->setInterval(kFlushDelayMs);
+    connect(flushTimer, &QTimer::timeout, this, &ViewStateStore::sync);
+
+    if (QCoreApplication::instance())
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &ViewStateStore::sync);
+}
+
+ViewStateStore::~ViewStateStore()
+{
+    sync();
+}
+
+QVariant ViewStateStore::value(const QUrl &url, const QString &key, const QVariant &defaultValue) const
+{
+    ensureLoaded();
+
+    const QString &urlKey = urlToKey(url);
+    Stamped own;
+    auto state = states.constFind(urlKey);
+    if (state != states.constEnd())
+        own = state->value(key);
+
+    const Stamped &reset = resets.value(key);
+    if (own.seq > 0 && own.seq > reset.seq)
+        return own.value;
+
+    // 默认配置中的目录状态（如下载、最近使用）在读取时合并，不写入存储
+    const QVariant &defaultConfig = Application::appObtuselySetting()->defaultConfigValue(kLegacyGroup, urlKey).toMap().value(key);
+    if (reset.seq > 0 && reset.value.isValid() && (own.seq > 0 || defaultConfig.isValid()))
+        return reset.value;
+
+    return defaultConfig.isValid() ? defaultConfig : defaultValue;
+}
+
+void ViewStateStore::setValue(const QUrl &url, const QString &key, const QVariant &value)
+{
+    ensureLoaded();
+
+    const QString &urlKey = urlToKey(url);
+    const QJsonValue &jsonValue = QJsonValue::fromVariant(value);
+    auto state = states.constFind(urlKey);
+    if (state != states.constEnd()) {
+        const Stamped &own = state->value(key);
+        if (own.seq > resets.value(key).seq && QJsonValue::fromVariant(own.value) == jsonValue)
+            return;
+    }
+
+    record({ { kRecUrl, urlKey }, { kRecKey, key }, { kRecValue, jsonValue } });
+}
+
+void ViewStateStore::remove(const QUrl &url, const QString &key)
+{
+    ensureLoaded();
+
+    const QString &urlKey = urlToKey(url);
+    auto state = states.constFind(urlKey);
+    if (state == states.constEnd() || !state->contains(key))
+        return;
+
+    record({ { kRecUrl, urlKey }, { kRecKey, key } });
+}
+
+void ViewStateStore::resetKey(const QString &key, const QVariant &value)
+{
+    ensureLoaded();
+
+    QJsonObject rec { { kRecReset, key } };
+    if (value.isValid())
+        rec.insert(kRecValue, QJsonValue::fromVariant(value));
+    record(rec);
+}
+
+void ViewStateStore::sync()
+{
+    flushTimer->stop();
+    // 只读模式（如文件对话框）下修改只保留在内存中，与 Settings 的只读语义一致
+    if (pending.isEmpty() || isReadOnly())
+        return;
+
+    const QString &path = storeFilePath();
+    if (!QDir().mkpath(QFileInfo(path).absolutePath()))
+        return;
+
+    QLockFile lock(path + ".lock");
+    if (!lock.tryLock(kLockTimeoutMs)) {
+        flushTimer->start();
+        return;
+    }
+
+    // 先回放其他进程追加的记录，保证文件位置与内存一致
+    replay(true);
+
+    QByteArray data;
+    for (const QJsonObject &rec : qAsConst(pending)) {
+        data.append(QJsonDocument(rec).toJson(QJsonDocument::Compact));
+        data.append('\n');
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append) || file.write(data) != data.size()) {
+        qCWarning(logDFMBase) << "ViewStateStore: failed to write" << path << file.errorString();
+        return;
+    }
+    file.close();
+
+    struct stat st;
+    if (::stat(QFile::encodeName(path).constData(), &st) == 0) {
+        fileInode = st.st_ino;
+        fileOffset = st.st_size;
+    }
+    fileRecords += pending.size();
+    pending.clear();
+
+    if (watcher && !watcher->files().contains(path))
+        watcher->addPath(path);
+
+    int live = resets.size();
+    if (fileRecords > kMinCompactRecords) {
+        for (auto it = states.cbegin(); it != states.cend(); ++it)
+            live += it->size();
+        if (fileRecords > live * 2)
+            compact();
+    }
+}
+
+void ViewStateStore::ensureLoaded() const
+{
+    if (!loaded)
+        const_cast<ViewStateStore *>(this)->load();
+}
+
+void ViewStateStore::load()
+{
+    loaded = true;
+
+    const QString &path = storeFilePath();
+    if (!QFile::exists(path))
+        migrate();
+    else
+        replay(false);
+
+#ifndef DFM_NO_FILE_WATCHER
+    watcher = new QFileSystemWatcher(this);
+    watcher->addPath(path);
+    connect(watcher, &QFileSystemWatcher::fileChanged, this, &ViewStateStore::onFileChanged);
+#endif
+}
+
+void ViewStateStore::migrate()
+{
+    Settings *settings = Application::appObtuselySetting();
+    const QStringList &keys = settings->keyList(kLegacyGroup);
+    auto applyLegacy = [this, settings, &keys] {
+        for (const QString &urlKey : keys) {
+            const QVariantMap &map = settings->value(kLegacyGroup, urlKey).toMap();
+            for (auto it = map.cbegin(); it != map.cend(); ++it)
+                apply({ { kRecUrl, urlKey }, { kRecKey, it.key() }, { kRecValue, QJsonValue::fromVariant(it.value()) } }, false);
+        }
+    };
+
+    // 只读模式下既不创建存储文件，也不能删除旧配置组，旧记录只读入内存
+    if (isReadOnly()) {
+        applyLegacy();
+        return;
+    }
+
+    const QString &path = storeFilePath();
+    if (!QDir().mkpath(QFileInfo(path).absolutePath()))
+        return;
+
+    QLockFile lock(path + ".lock");
+    if (!lock.tryLock(kLockTimeoutMs))
+        return;
+
+    // 其他进程可能已经完成迁移
+    if (QFile::exists(path)) {
+        replay(false);
+        return;
+    }
+
+    applyLegacy();
+    compact();
+    if (!QFile::exists(path))
+        return;
+
+    if (!keys.isEmpty()) {
+        qCInfo(logDFMBase) << "ViewStateStore: migrated" << keys.size() << "view states from" << kLegacyGroup;
+        settings->removeGroup(kLegacyGroup);
+        settings->sync();
+    }
+}
+
+void ViewStateStore::record(const QJsonObject &rec)
+{
+    apply(rec, true);
+    pending.append(rec);
+    flushTimer->start();
+}
+
+void ViewStateStore::apply(const QJsonObject &rec, bool notify)
+{
+    const QVariant &value = rec.value(kRecValue).toVariant();
+
+    if (rec.contains(kRecReset)) {
+        const QString &key = rec.value(kRecReset).toString();
+        resets.insert(key, { value, ++seq });
+        if (notify)
+            Q_EMIT valueChanged(QUrl(), key, value);
+        return;
+    }
+
+    const QString &urlKey = rec.value(kRecUrl).toString();
+    const QString &key = rec.value(kRecKey).toString();
+    if (urlKey.isEmpty() || key.isEmpty())
+        return;
+
+    if (rec.contains(kRecValue)) {
+        states[urlKey].insert(key, { value, ++seq });
+    } else {
+        auto state = states.find(urlKey);
+        if (state != states.end()) {
+            state->remove(key);
+            if (state->isEmpty())
+                states.erase(state);
+        }
+    }
+
+    if (notify)
+        Q_EMIT valueChanged(QUrl(urlKey), key, value);
+}
+
+void ViewStateStore::replay(bool notify)
+{
+    QFile file(storeFilePath());
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    struct stat st;
+    if (::fstat(file.handle(), &st) != 0)
+        return;
+
+    // 文件被（其他进程的）压缩替换时整体重新加载，再叠加本进程尚未落盘的记录
+    const bool reload = static_cast<quint64>(st.st_ino) != fileInode || st.st_size < fileOffset;
+    if (reload) {
+        states.clear();
+        resets.clear();
+        fileInode = st.st_ino;
+        fileOffset = 0;
+        fileRecords = 0;
+    }
+
+    bool applied = false;
+    if (st.st_size > fileOffset) {
+        file.seek(fileOffset);
+        while (!file.atEnd()) {
+            const QByteArray &line = file.readLine();
+            // 未写完的行留到下一次回放
+            if (!line.endsWith('\n'))
+                break;
+            fileOffset += line.size();
+            ++fileRecords;
+
+            const QJsonDocument &doc = QJsonDocument::fromJson(line);
+            if (doc.isObject()) {
+                apply(doc.object(), notify && !reload);
+                applied = true;
+            }
+        }
+    }
+
+    // 本进程尚未落盘的记录会写在这些记录之后，重新叠加一次，使内存中的序号与文件顺序一致
+    if (reload || applied) {
+        for (const QJsonObject &rec : qAsConst(pending))
+            apply(rec, notify && !reload);
+    }
+
+    if (reload && notify)
+        Q_EMIT valueChanged(QUrl(), QString(), QVariant());
+}
+
+void ViewStateStore::compact()
+{
+    const QString &path = storeFilePath();
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(logDFMBase) << "ViewStateStore: failed to open" << path;
+        return;
+    }
+
+    auto writeRecord = [&file](const QJsonObject &rec) {
+        file.write(QJsonDocument(rec).toJson(QJsonDocument::Compact));
+        file.write("\n");
+    };
+
+    // 重置写在前面；早于重置的目录记录直接写成重置后的结果
+    int count = 0;
+    for (auto it = resets.cbegin(); it != resets.cend(); ++it) {
+        QJsonObject rec { { kRecReset, it.key() } };
+        if (it->value.isValid())
+            rec.insert(kRecValue, QJsonValue::fromVariant(it->value));
+        writeRecord(rec);
+        ++count;
+    }
+
+    for (auto state = states.cbegin(); state != states.cend(); ++state) {
+        for (auto it = state->cbegin(); it != state->cend(); ++it) {
+            QVariant value = it->value;
+            const Stamped &reset = resets.value(it.key());
+            if (it->seq < reset.seq) {
+                if (!reset.value.isValid())
+                    continue;
+                value = reset.value;
+            }
+            writeRecord({ { kRecUrl, state.key() }, { kRecKey, it.key() }, { kRecValue, QJsonValue::fromVariant(value) } });
+            ++count;
+        }
+    }
+
+    if (!file.commit()) {
+        qCWarning(logDFMBase) << "ViewStateStore: failed to write" << path;
+        return;
+    }
+
+    struct stat st;
+    if (::stat(QFile::encodeName(path).constData(), &st) == 0) {
+        fileInode = st.st_ino;
+        fileOffset = st.st_size;
+    }
+    fileRecords = count;
+
+    // 替换文件后原来的监视失效
+    if (watcher && !watcher->files().contains(path))
+        watcher->addPath(path);
+}
+
+void ViewStateStore::onFileChanged()
+{
+    const QString &path = storeFilePath();
+    if (!watcher->files().contains(path) && QFile::exists(path))
+        watcher->addPath(path);
+
+    replay(true);
+}
+
+bool ViewStateStore::isReadOnly()
+{
+    return Application::appObtuselySetting()->isReadOnly();
+}
+
+QString ViewStateStore::urlToKey(const QUrl &url)
+{
+    // 与 Settings 的键保持一致，迁移过来的记录才能直接命中
+    if (url.isLocalFile()) {
+        const QUrl &standardUrl = StandardPaths::toStandardUrl(url.toLocalFile());
+        if (standardUrl.isValid())
+            return standardUrl.toString();
+    }
+
+    return url.toString();
+}
+
+QString ViewStateStore::storeFilePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericConfigLocation)
+            + "/deepin/dde-file-manager/dde-file-manager.viewstate";
+}
+
+}   // namespace dfmbase
@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef VIEWSTATESTORE_H
+#define VIEWSTATESTORE_H
+
+#include <dfm-base/dfm_base_global.h>
+
+#include <QObject>
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QUrl>
+#include <QVariant>
+
+class QFileSystemWatcher;
+class QTimer;
+
+namespace dfmbase {
+
+/**
+ * @brief 各目录视图状态（视图模式、排序、图标大小等）的独立存储
+ *
+ * 原先保存在 dde-file-manager.obtusely 的 "FileViewState" 组中，每次同步都要重写整个
+ * 配置文件。这里改为单独的日志文件：每次修改追加一行记录，读写都是一次哈希查找；
+ * 日志中的冗余记录超过一定比例后整体压缩一次。
+ *
+ * 全局的图标大小、视图模式等修改不再逐条改写各目录的记录，而是登记一条“重置”，
+ * 早于重置的目录记录在读取时让位于重置值。
+ *
+ * 其他进程追加的记录通过文件监视回放，并同样发出 valueChanged。
+ *
+ * dde-file-manager.obtusely 为只读时（文件对话框）不迁移、不落盘，修改只在内存中生效。
+ *
+ * 只在主线程使用。
+ */
+class ViewStateStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    static ViewStateStore *instance();
+
+    QVariant value(const QUrl &url, const QString &key, const QVariant &defaultValue = QVariant()) const;
+    void setValue(const QUrl &url, const QString &key, const QVariant &value);
+    void remove(const QUrl &url, const QString &key);
+
+    /**
+     * @brief 让所有目录中的 key 让位于全局设置
+     * @param value 已单独设置过 key 的目录在此之后读到的值，无效值表示回落到默认配置
+     */
+    void resetKey(const QString &key, const QVariant &value = QVariant());
+
+    /**
+     * @brief 立即写出尚未落盘的记录
+     */
+    void sync();
+
+Q_SIGNALS:
+    /**
+     * @brief 视图状态发生变化，url 为空表示 resetKey 影响了所有目录
+     */
+    void valueChanged(const QUrl &url, const QString &key, const QVariant &value);
+
+private:
+    struct Stamped
+    {
+        QVariant value;
+        quint64 seq { 0 };   ///< 写入序号，0 表示不存在
+    };
+
+    ViewStateStore();
+    ~ViewStateStore() override;
+    Q_DISABLE_COPY(ViewStateStore)
+
+    void ensureLoaded() const;
+    void load();
+    void migrate();
+    void record(const QJsonObject &rec);
+    void apply(const QJsonObject &rec, bool notify);
+    void replay(bool notify);
+    void compact();
+    void onFileChanged();
+
+    static bool isReadOnly();
+    static QString urlToKey(const QUrl &url);
+    static QString storeFilePath();
+
+    bool loaded { false };
+    quint64 seq { 0 };
+    QHash<QString, QHash<QString, Stamped>> states;   ///< 目录 -> 属性 -> 值
+    QHash<QString, Stamped> resets;   ///< 属性 -> 最近一次全局重置
+    QList<QJsonObject> pending;   ///< 尚未落盘的记录
+    qint64 fileOffset { 0 };   ///< 已回放到的文件位置
+    quint64 fileInode { 0 };   ///< 被其他进程压缩替换后 inode 会变化
+    int fileRecords { 0 };   ///< 文件中的记录数，用于判断是否需要压缩
+    QTimer *flushTimer { nullptr };
+    QFileSystemWatcher *watcher { nullptr };
+};
+
+}
+
+#endif   // VIEWSTATESTORE_H
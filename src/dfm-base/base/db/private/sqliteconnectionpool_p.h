@@ -6,8 +6,12 @@
 #define SQLITECONNECTIONPOOL_P_H
 
 #include <dfm-base/dfm_base_global.h>
+#include <dfm-base/base/db/sqliteconnectionpool.h>
 
 #include <QString>
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
 #include <QtSql>
 
 DFMBASE_BEGIN_NAMESPACE
@@ -17,10 +21,26 @@ class SqliteConnectionPoolPrivate
 public:
     SqliteConnectionPoolPrivate();
     QString makeConnectionName(const QString &databaseName);
+    QString threadConnectionName(const QString &databaseName);
     QSqlDatabase createConnection(const QString &databaseName, const QString &connectionName);
+    void applyOptions(QSqlDatabase &db, const SqliteConnectionOptions &options);
+    void dropStatements(const QString &connectionName);
+    void bumpGeneration(const QString &connectionName);
+    bool optionsFor(const QString &databaseName, SqliteConnectionOptions *out) const;
 
 public:
+    struct StatementCache
+    {
+        int generation { 0 };   // 编译语句时的连接代数，连接重开后旧语句失效
+        QHash<QString, QSharedPointer<QSqlQuery>> statements;
+    };
+
     QString connectionName;
+
+    mutable QMutex mutex;
+    QHash<QString, SqliteConnectionOptions> options;
+    QHash<QString, StatementCache> statementCaches;   // key: 线程连接名
+    QHash<QString, int> generations;   // key: 线程连接名，每次（重新）打开递增
 };
 
 DFMBASE_END_NAMESPACE
@@ -15,6 +15,7 @@ DFMBASE_USE_NAMESPACE
 
 static constexpr char kDatabaseType[] { "QSQLITE" };
 static constexpr char kTestSql[] { "SELECT 1" };
+static constexpr int kMaxCachedStatements { 64 };
 
 SqliteConnectionPoolPrivate::SqliteConnectionPoolPrivate()
 {
@@ -27,6 +28,46 @@ QString SqliteConnectionPoolPrivate::makeConnectionName(const QString &databaseN
     return QString(hash.result().toHex());
 }
 
+QString SqliteConnectionPoolPrivate::threadConnectionName(const QString &databaseName)
+{
+    return "conn_" + QString::number(quint64(QThread::currentThread()), 16) + "_" + makeConnectionName(databaseName);
+}
+
+void SqliteConnectionPoolPrivate::applyOptions(QSqlDatabase &db, const SqliteConnectionOptions &options)
+{
+    static const char *const kSynchronous[] { "OFF", "NORMAL", "FULL" };
+
+    QSqlQuery query { db };
+    if (options.walMode && !query.exec("PRAGMA journal_mode=WAL"))
+        qCWarning(logDFMBase) << "Failed to enable SQLite WAL mode:" << query.lastError().text();
+
+    query.exec(QString("PRAGMA synchronous=%1").arg(kSynchronous[static_cast<int>(options.synchronous)]));
+    if (options.walMode)
+        query.exec(QString("PRAGMA wal_autocheckpoint=%1").arg(options.walAutoCheckpoint));
+}
+
+void SqliteConnectionPoolPrivate::dropStatements(const QString &connectionName)
+{
+    QMutexLocker locker(&mutex);
+    statementCaches.remove(connectionName);
+}
+
+void SqliteConnectionPoolPrivate::bumpGeneration(const QString &connectionName)
+{
+    QMutexLocker locker(&mutex);
+    ++generations[connectionName];
+}
+
+bool SqliteConnectionPoolPrivate::optionsFor(const QString &databaseName, SqliteConnectionOptions *out) const
+{
+    QMutexLocker locker(&mutex);
+    auto it = options.constFind(databaseName);
+    if (it == options.constEnd())
+        return false;
+    *out = it.value();
+    return true;
+}
+
 QSqlDatabase SqliteConnectionPoolPrivate::createConnection(const QString &databaseName, const QString &connectionName)
 {
     static int sn = 0;
@@ -37,6 +78,10 @@ QSqlDatabase SqliteConnectionPoolPrivate::createConnection(const QString &databa
     if (db.open()) {
         qCInfo(logDFMBase) << "SQLite connection created successfully - name:" << connectionName 
                            << "database:" << databaseName << "serial number:" << (++sn);
+        bumpGeneration(connectionName);
+        SqliteConnectionOptions connOptions;
+        if (optionsFor(databaseName, &connOptions))
+            applyOptions(db, connOptions);
         return db;
     } else {
         qCCritical(logDFMBase) << "Failed to create SQLite connection - name:" << connectionName 
@@ -65,10 +110,11 @@ QSqlDatabase SqliteConnectionPool::openConnection(const QString &databaseName)
     assert(!databaseName.isEmpty());
     assert(QUrl::fromLocalFile(databaseName).isValid());
 
-    QString baseConnectionName = "conn_" + QString::number(quint64(QThread::currentThread()), 16);
-    QString fullConnectionName = baseConnectionName + "_" + d->makeConnectionName(databaseName);
+    QString fullConnectionName = d->threadConnectionName(databaseName);
 
     if (QSqlDatabase::contains(fullConnectionName)) {
+        // QSqlDatabase::database() 会自动重开已关闭的连接，需先记下原状态
+        const bool wasOpen = QSqlDatabase::database(fullConnectionName, false).isOpen();
         QSqlDatabase existingDb = QSqlDatabase::database(fullConnectionName);
         qCDebug(logDFMBase) << "Testing existing SQLite connection - connection:" << fullConnectionName 
                             << "test query:" << kTestSql;
@@ -78,11 +124,20 @@ QSqlDatabase SqliteConnectionPool::openConnection(const QString &databaseName)
                                    << fullConnectionName << "error:" << existingDb.lastError().text();
             return QSqlDatabase();
         }
+        if (!wasOpen || query.lastError().type() != QSqlError::NoError) {
+            // 重开后的连接：缓存语句失效，连接级参数需重新设置
+            d->bumpGeneration(fullConnectionName);
+            SqliteConnectionOptions connOptions;
+            if (d->optionsFor(databaseName, &connOptions))
+                d->applyOptions(existingDb, connOptions);
+        }
         qCDebug(logDFMBase) << "Reusing existing SQLite connection:" << fullConnectionName;
         return existingDb;
     } else {
         if (qApp != nullptr) {
-            QObject::connect(QThread::currentThread(), &QThread::finished, qApp, [fullConnectionName] {
+            QObject::connect(QThread::currentThread(), &QThread::finished, qApp, [this, fullConnectionName] {
+                // 语句须先于连接释放
+                d->dropStatements(fullConnectionName);
                 if (QSqlDatabase::contains(fullConnectionName)) {
                     QSqlDatabase::removeDatabase(fullConnectionName);
                     qCInfo(logDFMBase) << "SQLite connection removed on thread cleanup:" << fullConnectionName;
@@ -94,3 +149,67 @@ QSqlDatabase SqliteConnectionPool::openConnection(const QString &databaseName)
         return d->createConnection(databaseName, fullConnectionName);
     }
 }
+
+void SqliteConnectionPool::setConnectionOptions(const QString &databaseName, const SqliteConnectionOptions &options)
+{
+    {
+        QMutexLocker locker(&d->mutex);
+        d->options.insert(databaseName, options);
+    }
+
+    const QString &connectionName = d->threadConnectionName(databaseName);
+    if (QSqlDatabase::contains(connectionName)) {
+        QSqlDatabase db = QSqlDatabase::database(connectionName);
+        if (db.isOpen())
+            d->applyOptions(db, options);
+    }
+}
+
+SqliteConnectionOptions SqliteConnectionPool::connectionOptions(const QString &databaseName) const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->options.value(databaseName);
+}
+
+QSharedPointer<QSqlQuery> SqliteConnectionPool::preparedQuery(const QString &databaseName, const QString &sql)
+{
+    const QString &connectionName = d->threadConnectionName(databaseName);
+
+    // 已打开的连接直接复用，避免 openConnection 每次执行探测语句
+    QSqlDatabase db;
+    if (QSqlDatabase::contains(connectionName))
+        db = QSqlDatabase::database(connectionName, false);
+    if (!db.isOpen())
+        db = openConnection(databaseName);
+    if (!db.isOpen())
+        return {};
+
+    QMutexLocker locker(&d->mutex);
+    auto &cache = d->statementCaches[connectionName];
+    const int generation = d->generations.value(connectionName);
+    if (cache.generation != generation) {
+        // 连接被关闭后重开，旧语句已随之失效
+        cache.statements.clear();
+        cache.generation = generation;
+    }
+
+    auto it = cache.statements.constFind(sql);
+    // 语句仍处于活动状态说明外层调用正在使用（尚未 finish），另外编译一份且不放入缓存
+    const bool inUse = it != cache.statements.constEnd() && it.value()->isActive();
+    if (it != cache.statements.constEnd() && !inUse)
+        return it.value();
+
+    // 只释放缓存持有的引用，外层调用正在使用的语句由其自身持有
+    if (!inUse && cache.statements.size() >= kMaxCachedStatements)
+        cache.statements.clear();
+
+    QSharedPointer<QSqlQuery> query(new QSqlQuery(db));
+    if (!query->prepare(sql)) {
+        qCWarning(logDFMBase).noquote() << "SQL prepare failed:" << sql << query->lastError().text();
+        return {};
+    }
+
+    if (!inUse)
+        cache.statements.insert(sql, query);
+    return query;
+}
@@ -8,10 +8,24 @@
 #include <dfm-base/dfm_base_global.h>
 
 #include <QObject>
+#include <QSharedPointer>
 #include <QtSql>
 
 DFMBASE_BEGIN_NAMESPACE
 
+struct SqliteConnectionOptions
+{
+    enum class Synchronous {
+        kOff,
+        kNormal,
+        kFull
+    };
+
+    bool walMode { false };   // WAL 日志模式：读写互不阻塞，提交时只追加日志
+    Synchronous synchronous { Synchronous::kFull };   // WAL 模式下 kNormal 即可保证一致性
+    int walAutoCheckpoint { 1000 };   // 自动 checkpoint 的 WAL 页数阈值，0 表示只由调用方手动 checkpoint
+};
+
 class SqliteConnectionPoolPrivate;
 class SqliteConnectionPool : public QObject
 {
@@ -22,6 +36,14 @@ public:
     static SqliteConnectionPool &instance();
     QSqlDatabase openConnection(const QString &databaseName);
 
+    // 连接参数对之后新建的连接生效，并立即应用到当前线程已有的连接
+    void setConnectionOptions(const QString &databaseName, const SqliteConnectionOptions &options);
+    SqliteConnectionOptions connectionOptions(const QString &databaseName) const;
+
+    // 当前线程连接上按 SQL 文本缓存的预编译语句，用完须调用 finish()；连接重开后自动重新编译
+    // 调用方在使用期间持有返回的指针，语句被淘汰出缓存也不会被释放
+    QSharedPointer<QSqlQuery> preparedQuery(const QString &databaseName, const QString &sql);
+
 private:
     explicit SqliteConnectionPool(QObject *parent = nullptr);
     ~SqliteConnectionPool();
@@ -32,6 +32,18 @@ public:
         return db.rollback();
     }
 
+    // Connection options (WAL, synchronous, checkpoint policy); call before heavy use
+    inline void setConnectionOptions(const SqliteConnectionOptions &options)
+    {
+        SqliteConnectionPool::instance().setConnectionOptions(databaseName, options);
+    }
+
+    // Manual WAL checkpoint, `truncate` also shrinks the WAL file to zero bytes
+    inline bool checkpoint(bool truncate = false)
+    {
+        return excute(QString("PRAGMA wal_checkpoint(%1);").arg(truncate ? "TRUNCATE" : "PASSIVE"));
+    }
+
     // Create table
     template<typename T, typename... Args>
     bool createTable(const Args &... constraints)
@@ -81,56 +93,80 @@ public:
         const QStringList &fieldNames { SqliteHelper::fieldNames<T>() };
         Q_ASSERT(!fieldNames.isEmpty());
 
-        QString fmtFields;
-        QString fmtValues;
-
-        auto serializeValue = [&entity](const QString &field) -> QString {
-            QVariant &&variant { entity.property(field.toLocal8Bit().data()) };
-            QString &&typeStr { SqliteHelper::typeString(variant.type()) };
-            QString out;
-            if (typeStr.contains("TEXT")) {
-                SerializationHelper::serialize(&out, variant.toString());
-            } else {
-                SerializationHelper::serialize(&out, variant);
-            }
-            return out;
-        };
-
-        int startIndex { 1 };
-        if (customPK)
-            startIndex = 0;
-
-        for (int i = startIndex; i != fieldNames.size(); ++i) {
-            fmtFields += (fieldNames[i] + ",");
-            fmtValues += (serializeValue(fieldNames[i]) + ",");
-        }
+        const QStringList &fields { fieldNames.mid(customPK ? 0 : 1) };
+        Q_ASSERT(!fields.isEmpty());
 
-        if (fmtFields.endsWith(","))
-            fmtFields.chop(1);
-        if (fmtValues.endsWith(","))
-            fmtValues.chop(1);
+        // values are bound, so every insert of T shares one cached statement
+        QVariantList values;
+        values.reserve(fields.size());
+        for (const QString &field : fields)
+            values.append(fieldValue(entity, field));
 
-        Q_ASSERT(!fmtFields.isEmpty() && !fmtValues.isEmpty());
         int lastId { -1 };
-        if (!excute("INSERT INTO " + SqliteHelper::tableName<T>()
-                            + "(" + fmtFields + ") VALUES (" + fmtValues + ");",
-                    [&lastId](QSqlQuery *query) {
-                        Q_ASSERT(query);
-                        lastId = query->lastInsertId().toInt();
-                    }))
+        if (!SqliteHelper::excutePrepared(databaseName, insertSql<T>(fields), values, &lastExcutedSql,
+                                          [&lastId](QSqlQuery *query) {
+                                              Q_ASSERT(query);
+                                              lastId = query->lastInsertId().toInt();
+                                          }))
             return -1;
 
         return lastId;
     }
 
-    // U: Update
+    // Bulk insert: `entities` holds pointers (or smart pointers) to T, bound column-wise
+    template<typename T, typename Container>
+    bool insertMany(const Container &entities, bool customPK = false)
+    {
+        static_assert(std::is_base_of<QObject, T>::value, "Template type T must be derived QObject");
+        const QStringList &fieldNames { SqliteHelper::fieldNames<T>() };
+        Q_ASSERT(!fieldNames.isEmpty());
+
+        const QStringList &fields { fieldNames.mid(customPK ? 0 : 1) };
+        QList<QVariantList> columns;
+        columns.reserve(fields.size());
+        for (const QString &field : fields) {
+            QVariantList column;
+            column.reserve(static_cast<int>(entities.size()));
+            for (const auto &entity : entities)
+                column.append(fieldValue<T>(*entity, field));
+            columns.append(column);
+        }
+
+        return insertColumns<T>(fields, columns);
+    }
+
+    // Bulk insert from column arrays, `columns[i]` holds every row's value of `fields[i]`
+    template<typename T>
+    bool insertColumns(const QStringList &fields, const QList<QVariantList> &columns)
+    {
+        static_assert(std::is_base_of<QObject, T>::value, "Template type T must be derived QObject");
+        Q_ASSERT(fields.size() == columns.size());
+        return SqliteHelper::excuteBatch(databaseName, insertSql<T>(fields), columns, &lastExcutedSql);
+    }
+
+    // U: Update, values of both expressions are bound rather than written into the SQL text
     template<typename T>
     bool update(const Expression::SetExpr &setExpr, const Expression::Expr &whereExpr)
     {
         static_assert(std::is_base_of<QObject, T>::value, "Template type T must be derived QObject");
-        return excute("UPDATE " + SqliteHelper::tableName<T>()
-                      + " SET " + setExpr.toString()
-                      + " WHERE " + whereExpr.toString());
+        return SqliteHelper::excutePrepared(databaseName,
+                                            "UPDATE " + SqliteHelper::tableName<T>()
+                                                    + " SET " + setExpr.toBoundString()
+                                                    + " WHERE " + whereExpr.toBoundString() + ";",
+                                            setExpr.bindValues() + whereExpr.bindValues(), &lastExcutedSql);
+    }
+
+    // Bulk update: SET setField = values[i] WHERE keyField = keys[i]
+    template<typename T>
+    bool updateMany(const QString &setField, const QVariantList &values,
+                    const QString &keyField, const QVariantList &keys)
+    {
+        static_assert(std::is_base_of<QObject, T>::value, "Template type T must be derived QObject");
+        Q_ASSERT(values.size() == keys.size());
+        return SqliteHelper::excuteBatch(databaseName,
+                                         "UPDATE " + SqliteHelper::tableName<T>()
+                                                 + " SET " + setField + "=? WHERE " + keyField + "=?;",
+                                         { values, keys }, &lastExcutedSql);
     }
 
     // R: Query
@@ -161,8 +197,20 @@ public:
     {
         static_assert(std::is_base_of<QObject, T>::value, "Template type T must be derived QObject");
 
-        return excute("DELETE FROM " + SqliteHelper::tableName<T>()
-                      + " WHERE " + whereExpr.toString() + ";");
+        return SqliteHelper::excutePrepared(databaseName,
+                                            "DELETE FROM " + SqliteHelper::tableName<T>()
+                                                    + " WHERE " + whereExpr.toBoundString() + ";",
+                                            whereExpr.bindValues(), &lastExcutedSql);
+    }
+
+    // Bulk delete: WHERE keyField = keys[i]
+    template<typename T>
+    bool removeMany(const QString &keyField, const QVariantList &keys)
+    {
+        static_assert(std::is_base_of<QObject, T>::value, "Template type T must be derived QObject");
+        return SqliteHelper::excuteBatch(databaseName,
+                                         "DELETE FROM " + SqliteHelper::tableName<T>() + " WHERE " + keyField + "=?;",
+                                         { keys }, &lastExcutedSql);
     }
 
     inline bool excute(const QString &sql, std::function<void(QSqlQuery *)> fn = nullptr)
@@ -176,6 +224,27 @@ public:
     }
 
 private:
+    template<typename T>
+    static QVariant fieldValue(const T &entity, const QString &field)
+    {
+        QVariant variant { entity.property(field.toLocal8Bit().data()) };
+        // TEXT columns are always written as strings
+        if (SqliteHelper::typeString(variant.type()).contains("TEXT"))
+            return variant.toString();
+        return variant;
+    }
+
+    template<typename T>
+    static QString insertSql(const QStringList &fields)
+    {
+        QStringList placeholders;
+        placeholders.reserve(fields.size());
+        for (int i = 0; i != fields.size(); ++i)
+            placeholders.append("?");
+        return "INSERT INTO " + SqliteHelper::tableName<T>()
+                + "(" + fields.join(",") + ") VALUES (" + placeholders.join(",") + ");";
+    }
+
     QString databaseName;
     QString lastExcutedSql;
 };
@@ -60,7 +60,12 @@ namespace Expression {
 struct SetExpr
 {
     SetExpr(const QString &fieldOpVal)
-        : expr(fieldOpVal)
+        : expr(fieldOpVal), boundExpr(fieldOpVal)
+    {
+    }
+
+    SetExpr(const QString &fieldOpVal, const QString &boundFieldOp, const QVariant &val)
+        : expr(fieldOpVal), boundExpr(boundFieldOp), values { val }
     {
     }
 
@@ -69,13 +74,28 @@ struct SetExpr
         return expr;
     }
 
+    QString toBoundString() const
+    {
+        return boundExpr;
+    }
+
+    QVariantList bindValues() const
+    {
+        return values;
+    }
+
     inline SetExpr operator&&(const SetExpr &rhs) const
     {
-        return SetExpr { expr + "," + rhs.expr };
+        SetExpr ret { expr + "," + rhs.expr };
+        ret.boundExpr = boundExpr + "," + rhs.boundExpr;
+        ret.values = values + rhs.values;
+        return ret;
     }
 
 private:
     QString expr;
+    QString boundExpr;
+    QVariantList values;
 };
 
 // Field
@@ -95,7 +115,7 @@ struct ExprField
         value.type() == QVariant::Type::String ? SerializationHelper::serialize(&out, value.toString())
                                                : SerializationHelper::serialize(&out, value);
         out = fieldName + "=" + out;
-        return SetExpr(out);
+        return SetExpr(out, fieldName + "=?", value);
     }
 };
 
@@ -116,7 +136,7 @@ struct Aggregate : public ExprField
 struct Expr
 {
     Expr(const QString &fieldName, const QString &op)
-        : expr(fieldName + op)
+        : expr(fieldName + op), boundExpr(expr)
     {
     }
 
@@ -132,6 +152,8 @@ struct Expr
         val.type() == QVariant::Type::String ? SerializationHelper::serialize(&suffix, val.toString())
                                              : SerializationHelper::serialize(&suffix, val);
         expr = prefix + suffix;
+        boundExpr = prefix + "?";
+        values.append(val);
     }
 
     Expr(const ExprField &field, const QString &op, const QVariant &val)
@@ -139,11 +161,23 @@ struct Expr
     {
     }
 
+    // literal form, for places that cannot bind values (e.g. CHECK constraints)
     QString toString() const
     {
         return expr;
     }
 
+    // '?' placeholder form, `bindValues()` holds the values in placeholder order
+    QString toBoundString() const
+    {
+        return boundExpr;
+    }
+
+    QVariantList bindValues() const
+    {
+        return values;
+    }
+
     inline Expr operator&&(const Expr &rhs) const
     {
         return andOr(rhs, " AND ");
@@ -160,10 +194,14 @@ private:
         ret.expr = "(" + ret.expr;
         ret.expr += logOp;
         ret.expr += rhs.expr + ")";
+        ret.boundExpr = "(" + ret.boundExpr + logOp + rhs.boundExpr + ")";
+        ret.values += rhs.values;
         return ret;
     }
 
     QString expr;
+    QString boundExpr;
+    QVariantList values;
 };
 
 // operator (==, !=, >, <, >=, <=)
@@ -465,6 +503,67 @@ public:
 
         return ret;
     }
+
+    // 使用缓存的预编译语句执行，values 依次绑定到 '?' 占位符
+    static inline bool excutePrepared(const QString &databaseName, const QString &sql, const QVariantList &values,
+                                      QString *lastQuery = nullptr, std::function<void(QSqlQuery *)> fn = nullptr)
+    {
+        const QSharedPointer<QSqlQuery> query { SqliteConnectionPool::instance().preparedQuery(databaseName, sql) };
+        if (!query)
+            return false;
+
+        for (int i = 0; i != values.size(); ++i)
+            query->bindValue(i, values.at(i));
+        query->exec();
+
+        bool ret { true };
+        if (lastQuery)
+            *lastQuery = query->lastQuery();
+        if (query->lastError().type() != QSqlError::NoError) {
+            qCWarning(logDFMBase).noquote() << "SQL Error: " << query->lastError().text().trimmed() << sql;
+            ret = false;
+        }
+
+        if (fn)
+            fn(query.data());
+
+        query->finish();
+        return ret;
+    }
+
+    // 批量执行：columns 中每一项为一个占位符对应的整列绑定值，一次编译、一个事务内执行全部行
+    static inline bool excuteBatch(const QString &databaseName, const QString &sql, const QList<QVariantList> &columns,
+                                   QString *lastQuery = nullptr)
+    {
+        if (columns.isEmpty() || columns.first().isEmpty())
+            return true;
+
+        QSqlDatabase db { SqliteConnectionPool::instance().openConnection(databaseName) };
+        // 已处于外层事务中时 BEGIN 会失败，此时由外层负责提交
+        const bool ownTransaction { db.transaction() };
+
+        const QSharedPointer<QSqlQuery> query { SqliteConnectionPool::instance().preparedQuery(databaseName, sql) };
+        bool ret { !query.isNull() };
+        if (query) {
+            for (int i = 0; i != columns.size(); ++i)
+                query->bindValue(i, columns.at(i));
+            ret = query->execBatch();
+            if (lastQuery)
+                *lastQuery = query->lastQuery();
+            if (!ret)
+                qCWarning(logDFMBase).noquote() << "SQL Error: " << query->lastError().text().trimmed() << sql;
+            query->finish();
+        }
+
+        if (ownTransaction) {
+            if (ret)
+                ret = db.commit();
+            else
+                db.rollback();
+        }
+
+        return ret;
+    }
 };
 
 DFMBASE_END_NAMESPACE
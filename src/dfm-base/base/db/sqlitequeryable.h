@@ -50,7 +50,8 @@ public:
 
     inline SqliteQueryable<T> &where(const Expression::Expr &whereExpr)
     {
-        sqlWhere = " WHERE " + whereExpr.toString();
+        sqlWhere = " WHERE " + whereExpr.toBoundString();
+        whereValues = whereExpr.bindValues();
         return *this;
     }
 
@@ -62,7 +63,8 @@ public:
 
     inline SqliteQueryable<T> &having(const Expression::Expr &expr)
     {
-        sqlHaving = " HAVING " + expr.toString();
+        sqlHaving = " HAVING " + expr.toBoundString();
+        havingValues = expr.bindValues();
         return *this;
     }
 
@@ -126,7 +128,7 @@ public:
         const QString &sql { sqlSelect + sqlTarget + getFromSql() + getLimit() + ";" };
         QString lastQuery;
         QList<QVariantMap> maps;
-        SqliteHelper::excute(databaseName, sql, &lastQuery, [&maps](QSqlQuery *query) {
+        SqliteHelper::excutePrepared(databaseName, sql, getFromValues(), &lastQuery, [&maps](QSqlQuery *query) {
             Q_ASSERT(query);
             maps = SqliteQueryable::queryToMaps(query);
         });
@@ -139,7 +141,7 @@ public:
         QString lastQuery;
         QVariant result;
 
-        SqliteHelper::excute(databaseName, sql, &lastQuery, [&result](QSqlQuery *query) {
+        SqliteHelper::excutePrepared(databaseName, sql, getFromValues(), &lastQuery, [&result](QSqlQuery *query) {
             if (query->next())
                 result = query->value(0);
         });
@@ -154,6 +156,12 @@ private:
         return sqlFrom + sqlWhere + sqlGroupBy + sqlHaving;
     }
 
+    // Return values bound to the placeholders of FROM part, in order
+    inline QVariantList getFromValues() const
+    {
+        return whereValues + havingValues;
+    }
+
     // Return ORDER BY & LIMIT part for Query
     inline QString getLimit() const
     {
@@ -188,6 +196,8 @@ private:
     QString sqlWhere;
     QString sqlGroupBy;
     QString sqlHaving;
+    QVariantList whereValues;
+    QVariantList havingValues;
 
     QString sqlOrderBy;
     QString sqlLimit;
@@ -9,11 +9,11 @@
 #include <dfm-base/base/application/settings.h>
 #include <dfm-base/dbusservice/global_server_defines.h>
 #include <dfm-base/dbusservice/opticalshareproxy.h>
-#include <dfm-base/utils/finallyutil.h>
 #include <dfm-base/utils/universalutils.h>
 #include <dfm-base/utils/networkutils.h>
 #include <dfm-base/base/device/deviceproxymanager.h>
 #include <dfm-base/base/device/private/devicehelper.h>
+#include <dfm-base/base/device/private/mountsnapshot.h>
 #include <dfm-base/dbusservice/global_server_defines.h>
 #include <dfm-base/utils/protocolutils.h>
 
@@ -27,8 +27,8 @@
 #include <QMutex>
 #include <QSettings>
 #include <QDir>
+#include <QFileInfo>
 
-#include <libmount.h>
 #include <fstab.h>
 #include <sys/stat.h>
 
@@ -54,28 +54,68 @@ QString DeviceUtils::getMountInfo(const QString &in, bool lookForMpt)
 {
     if (in.isEmpty())
         return {};
-    libmnt_table *tab { mnt_new_table() };
-    if (!tab) {
-        qCWarning(logDFMBase) << "Failed to create mount table for query:" << in;
-        return {};
-    }
-    FinallyUtil finally { [tab]() { if (tab) mnt_free_table(tab); } };
-    if (mnt_table_parse_mtab(tab, nullptr) != 0) {
+    auto snapshot = MountSnapshot::current();
+    if (!snapshot) {
         qCWarning(logDFMBase) << "Failed to parse mount table for query:" << in;
         return {};
     }
 
-    auto query = lookForMpt ? mnt_table_find_source : mnt_table_find_target;
-    auto get = lookForMpt ? mnt_fs_get_target : mnt_fs_get_source;
-    std::string stdPath { in.toStdString() };
-    auto fs = query(tab, stdPath.c_str(), MNT_ITER_BACKWARD);
+    auto query = [&snapshot, lookForMpt](const QString &path) {
+        return lookForMpt ? snapshot->findBySource(path) : snapshot->findByTarget(path);
+    };
+    auto fs = query(in);
+    if (!fs) {
+        // like libmount, retry with the canonicalized path
+        const QString &canonical = QFileInfo(in).canonicalFilePath();
+        if (!canonical.isEmpty() && canonical != in)
+            fs = query(canonical);
+    }
     if (fs)
-        return { get(fs) };
+        return lookForMpt ? fs->target : fs->source;
 
     qCWarning(logDFMBase) << "Mount info not found for:" << in;
     return {};
 }
 
+/*!
+ * \brief DeviceUtils::findMountOfPath: find the mount that contains `filePath`
+ * symlinks in the parent directories are resolved first, the result is served from
+ * the process wide mount table snapshot.
+ * \return false if the mount table is not available
+ */
+bool DeviceUtils::findMountOfPath(const QString &filePath, QString *mountPoint, QString *source, QString *fsType)
+{
+    auto snapshot = MountSnapshot::current();
+    if (!snapshot)
+        return false;
+
+    // resolve the parent directory only: a symlink itself lives on the mount of its parent
+    const QFileInfo info(filePath);
+    QString dir = info.absolutePath();
+    QFileInfo dirInfo(dir);
+    while (!dirInfo.exists() && dir.length() > 1) {
+        dir = dirInfo.absolutePath();
+        dirInfo.setFile(dir);
+    }
+    QString path = dirInfo.canonicalFilePath();
+    if (path.isEmpty())
+        path = info.absoluteFilePath();
+    else if (dir == info.absolutePath() && !info.fileName().isEmpty())
+        path = (path.endsWith("/") ? path : path + "/") + info.fileName();
+
+    auto fs = snapshot->findMountOf(path);
+    if (!fs)
+        return false;
+
+    if (mountPoint)
+        *mountPoint = fs->target;
+    if (source)
+        *source = fs->source;
+    if (fsType)
+        *fsType = fs->fsType;
+    return true;
+}
+
 QUrl DeviceUtils::getSambaFileUriFromNative(const QUrl &url)
 {
     if (!url.isValid())
@@ -570,35 +610,14 @@ bool DeviceUtils::isMountPointOfDlnfs(const QString &path)
  */
 QString DeviceUtils::getLongestMountRootPath(const QString &filePath)
 {
-    libmnt_table *tab { mnt_new_table() };
-    libmnt_iter *iter { mnt_new_iter(MNT_ITER_BACKWARD) };
-
-    FinallyUtil release([&] {
-        if (tab) mnt_free_table(tab);
-        if (iter) mnt_free_iter(iter);
-    });
-
-    int ret = mnt_table_parse_mtab(tab, nullptr);
-    if (ret != 0)
+    auto snapshot = MountSnapshot::current();
+    if (!snapshot)
         return "/";
 
-    QStringList mpts;
-    libmnt_fs *fs = nullptr;
-    while (mnt_table_next_fs(tab, iter, &fs) == 0) {
-        if (!fs)
-            continue;
-
-        const QString &target = mnt_fs_get_target(fs);
-        mpts.append(target == "/" ? "/" : target + "/");
-    }
-    std::sort(mpts.begin(), mpts.end(), [](const QString &a, const QString &b) { return a.length() > b.length(); });
-
-    QString path = filePath;
-    if (!path.endsWith("/"))
-        path.append("/");
-
-    auto found = std::find_if(mpts.cbegin(), mpts.cend(), [path](const QString &mpt) { return path.startsWith(mpt); });
-    return found != mpts.cend() ? *found : "/";
+    auto fs = snapshot->findMountOf(filePath);
+    if (!fs || fs->target == "/")
+        return "/";
+    return fs->target + "/";
 }
 
 qint64 DeviceUtils::deviceBytesFree(const QUrl &url)
@@ -762,31 +781,20 @@ bool DeviceUtils::isSiblingOfRoot(const QVariantMap &devInfo)
 bool DeviceUtils::findDlnfsPath(const QString &target, Compare func)
 {
     Q_ASSERT(func);
-    libmnt_table *tab { mnt_new_table() };
-    libmnt_iter *iter = mnt_new_iter(MNT_ITER_BACKWARD);
-
-    FinallyUtil finally([=] {
-        if (tab) mnt_free_table(tab);
-        if (iter) mnt_free_iter(iter);
-    });
-    Q_UNUSED(finally);
-
     auto unifyPath = [](const QString &path) {
         return path.endsWith("/") ? path : path + "/";
     };
 
-    int ret = mnt_table_parse_mtab(tab, nullptr);
-    if (ret != 0) {
-        qCWarning(logDFMBase) << "Failed to parse mount table for DLNFS path search, return code:" << ret;
+    auto snapshot = MountSnapshot::current();
+    if (!snapshot) {
+        qCWarning(logDFMBase) << "Failed to parse mount table for DLNFS path search";
         return false;
     }
 
-    libmnt_fs *fs = nullptr;
-    while (mnt_table_next_fs(tab, iter, &fs) == 0) {
-        if (!fs)
-            continue;
-        if (strcmp("dlnfs", mnt_fs_get_source(fs)) == 0) {
-            QString mpt = unifyPath(mnt_fs_get_target(fs));
+    const auto &mounts = snapshot->entries();
+    for (auto it = mounts.crbegin(); it != mounts.crend(); ++it) {
+        if (it->source == "dlnfs") {
+            QString mpt = unifyPath(it->target);
             if (func(unifyPath(target), mpt)) {
                 qCDebug(logDFMBase) << "DLNFS path match found - target:" << target << "mount point:" << mpt;
                 return true;
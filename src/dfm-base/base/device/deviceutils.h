@@ -70,6 +70,8 @@ public:
     static bool isMountPointOfDlnfs(const QString &path);
 
     static QString getLongestMountRootPath(const QString &filePath);
+    static bool findMountOfPath(const QString &filePath, QString *mountPoint,
+                                QString *source = nullptr, QString *fsType = nullptr);
 
     static qint64 deviceBytesFree(const QUrl &url);
     static bool isUnmountSamba(const QUrl &url);
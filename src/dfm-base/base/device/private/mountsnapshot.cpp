@@ -0,0 +1,119 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "mountsnapshot.h"
+
+#include <dfm-base/utils/finallyutil.h>
+
+#include <QMutex>
+#include <QDebug>
+
+#include <libmount.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+using namespace dfmbase;
+
+static QString normalizedPath(const QString &path)
+{
+    QString ret = path;
+    while (ret.length() > 1 && ret.endsWith('/'))
+        ret.chop(1);
+    return ret;
+}
+
+QSharedPointer<const MountSnapshot> MountSnapshot::current()
+{
+    static QMutex mutex;
+    static QSharedPointer<const MountSnapshot> snapshot;
+    // kept open for the process lifetime, only used for change notification
+    static const int monitorFd = ::open("/proc/self/mountinfo", O_RDONLY | O_CLOEXEC);
+
+    QMutexLocker locker(&mutex);
+    if (snapshot && monitorFd >= 0) {
+        // the kernel reports POLLPRI | POLLERR once per mount table change, and poll() itself
+        // consumes the event, so the table parsed below is at least as new as the change seen here.
+        struct pollfd pfd { monitorFd, POLLPRI, 0 };
+        if (::poll(&pfd, 1, 0) == 0)
+            return snapshot;
+    }
+
+    // without the monitor fd there is no notification, fall back to parsing on every call
+    auto fresh = parse();
+    if (fresh)
+        snapshot = fresh;
+    return snapshot;
+}
+
+QSharedPointer<const MountSnapshot> MountSnapshot::parse()
+{
+    libmnt_table *tab { mnt_new_table() };
+    libmnt_iter *iter { mnt_new_iter(MNT_ITER_FORWARD) };
+
+    FinallyUtil release([&] {
+        if (tab) mnt_free_table(tab);
+        if (iter) mnt_free_iter(iter);
+    });
+
+    if (!tab || !iter)
+        return nullptr;
+
+    int ret = mnt_table_parse_mtab(tab, nullptr);
+    if (ret != 0) {
+        qCWarning(logDFMBase) << "Failed to parse mount table for snapshot, return code:" << ret;
+        return nullptr;
+    }
+
+    QSharedPointer<MountSnapshot> snapshot(new MountSnapshot);
+    libmnt_fs *fs = nullptr;
+    while (mnt_table_next_fs(tab, iter, &fs) == 0) {
+        if (!fs)
+            continue;
+
+        Entry entry { QString(mnt_fs_get_source(fs)),
+                      normalizedPath(QString(mnt_fs_get_target(fs))),
+                      QString(mnt_fs_get_fstype(fs)) };
+
+        // later mounts hide earlier ones, same as searching with MNT_ITER_BACKWARD
+        const int index = snapshot->mounts.size();
+        snapshot->sourceIndex.insert(entry.source, index);
+        snapshot->targetIndex.insert(entry.target, index);
+        snapshot->mounts.append(entry);
+    }
+
+    return snapshot;
+}
+
+const MountSnapshot::Entry *MountSnapshot::findBySource(const QString &source) const
+{
+    auto it = sourceIndex.constFind(source);
+    return it != sourceIndex.constEnd() ? &mounts.at(it.value()) : nullptr;
+}
+
+const MountSnapshot::Entry *MountSnapshot::findByTarget(const QString &target) const
+{
+    auto it = targetIndex.constFind(normalizedPath(target));
+    return it != targetIndex.constEnd() ? &mounts.at(it.value()) : nullptr;
+}
+
+const MountSnapshot::Entry *MountSnapshot::findMountOf(const QString &path) const
+{
+    // walk up the ancestors, the first one that is a mount target is the longest prefix
+    QString current = normalizedPath(path);
+    while (!current.isEmpty()) {
+        auto it = targetIndex.constFind(current);
+        if (it != targetIndex.constEnd())
+            return &mounts.at(it.value());
+
+        if (current == "/")
+            break;
+        const int slash = current.lastIndexOf('/');
+        if (slash < 0)
+            break;
+        current = slash == 0 ? QString("/") : current.left(slash);
+    }
+
+    return nullptr;
+}
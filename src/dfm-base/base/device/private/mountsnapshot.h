@@ -0,0 +1,58 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef MOUNTSNAPSHOT_H
+#define MOUNTSNAPSHOT_H
+
+#include <dfm-base/dfm_base_global.h>
+
+#include <QHash>
+#include <QList>
+#include <QSharedPointer>
+#include <QString>
+
+namespace dfmbase {
+
+/*!
+ * \brief The MountSnapshot class
+ * an immutable copy of the mount table, shared by every mount lookup in the process.
+ *
+ * current() re-parses the table only after the kernel reports a change through
+ * poll(POLLPRI) on /proc/self/mountinfo, so repeated lookups during file operations
+ * no longer parse mountinfo on every call. A new snapshot replaces the old one
+ * atomically; callers holding the old pointer keep a consistent view.
+ */
+class MountSnapshot
+{
+public:
+    struct Entry
+    {
+        QString source;
+        QString target;
+        QString fsType;
+    };
+
+    // returns nullptr if the mount table can not be parsed
+    static QSharedPointer<const MountSnapshot> current();
+
+    // entries in mount order, the last one wins when a path is mounted over
+    const QList<Entry> &entries() const { return mounts; }
+
+    const Entry *findBySource(const QString &source) const;
+    const Entry *findByTarget(const QString &target) const;
+    // the mount whose target is the longest prefix of `path`
+    const Entry *findMountOf(const QString &path) const;
+
+private:
+    MountSnapshot() = default;
+    static QSharedPointer<const MountSnapshot> parse();
+
+    QList<Entry> mounts;
+    QHash<QString, int> sourceIndex;
+    QHash<QString, int> targetIndex;
+};
+
+}
+
+#endif   // MOUNTSNAPSHOT_H
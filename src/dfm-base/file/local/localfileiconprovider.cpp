@@ -4,8 +4,12 @@
 
 #include "localfileiconprovider.h"
 
+#include <dfm-base/file/local/asyncfileinfo.h>
+
 #include <dfm-io/dfileinfo.h>
 
+#include <QCache>
+
 namespace dfmbase {
 class LocalFileIconProviderPrivate
 {
@@ -13,13 +17,25 @@ public:
     LocalFileIconProviderPrivate();
 
     QIcon fileSystemIcon(const QString &path) const;
-    QIcon fromTheme(QString iconName) const;
+    QIcon fromTheme(const QString &iconName) const;
+
+private:
+    QIcon lookupTheme(QString iconName) const;
+
+    // icon name -> icon, null icons are cached too so that misses are not retried.
+    // only touched on the main thread, cleared when the icon theme changes.
+    mutable QCache<QString, QIcon> iconCache;
+    mutable QString cacheThemeName;
 };
 }
 
 using namespace dfmbase;
+
+static constexpr int kMaxCachedIcons { 1024 };
+
 LocalFileIconProviderPrivate::LocalFileIconProviderPrivate()
 {
+    iconCache.setMaxCost(kMaxCachedIcons);
 }
 
 // fallback to gio
@@ -34,14 +50,33 @@ QIcon LocalFileIconProviderPrivate::fileSystemIcon(const QString &path) const
 
     const QStringList &iconNames = info.attribute(DFMIO::DFileInfo::AttributeID::kStandardIcon).toStringList();
     if (!iconNames.isEmpty())
-        icon = QIcon::fromTheme(iconNames.first());
+        icon = fromTheme(iconNames.first());
 
     return icon;
 }
 
-QIcon LocalFileIconProviderPrivate::fromTheme(QString iconName) const
+QIcon LocalFileIconProviderPrivate::fromTheme(const QString &iconName) const
 {
     assert(QThread::currentThread() == qApp->thread());
+    if (iconName.isEmpty())
+        return QIcon();
+
+    const QString &theme = QIcon::themeName();
+    if (theme != cacheThemeName) {
+        iconCache.clear();
+        cacheThemeName = theme;
+    }
+
+    if (const QIcon *cached = iconCache.object(iconName))
+        return *cached;
+
+    QIcon icon = lookupTheme(iconName);
+    iconCache.insert(iconName, new QIcon(icon));
+    return icon;
+}
+
+QIcon LocalFileIconProviderPrivate::lookupTheme(QString iconName) const
+{
     QIcon icon;
     icon = QIcon::fromTheme(iconName);
 
@@ -117,7 +152,11 @@ QIcon LocalFileIconProvider::icon(FileInfoPointer info, const QIcon &feedback)
 
     if (Q_LIKELY(!icon.isNull()))
         return icon;
-    icon = this->icon(info->pathOf(PathInfoType::kFilePath));
+
+    // async infos query the standard icon in the background and refresh the icon once it
+    // arrives, querying gio here again would block the main thread for every item.
+    if (!info.dynamicCast<AsyncFileInfo>())
+        icon = this->icon(info->pathOf(PathInfoType::kFilePath));
 
     if (Q_LIKELY(!icon.isNull()))
         return icon;
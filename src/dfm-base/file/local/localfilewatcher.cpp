@@ -5,6 +5,7 @@
 #include "file/local/localfilewatcher.h"
 #include "file/local/private/localfilewatcher_p.h"
 #include <dfm-base/base/urlroute.h>
+#include <dfm-base/utils/dirsizecache.h>
 
 #include <dfm-io/dwatcher.h>
 
@@ -106,6 +107,17 @@ void LocalFileWatcherPrivate::initConnect()
     connect(watcher.data(), &DWatcher::fileDeleted, q, &AbstractFileWatcher::fileDeleted);
     connect(watcher.data(), &DWatcher::fileAdded, q, &AbstractFileWatcher::subfileCreated);
     connect(watcher.data(), &DWatcher::fileRenamed, q, &AbstractFileWatcher::fileRename);
+
+    // 任何子项变化都会使其所在目录链上缓存的子树大小失效
+    auto invalidateSize = [](const QUrl &url) {
+        DirSizeCache::instance()->invalidate(url.path());
+    };
+    connect(watcher.data(), &DWatcher::fileChanged, q, invalidateSize);
+    connect(watcher.data(), &DWatcher::fileDeleted, q, invalidateSize);
+    connect(watcher.data(), &DWatcher::fileAdded, q, invalidateSize);
+    connect(watcher.data(), &DWatcher::fileRenamed, q, [](const QUrl &fromUrl, const QUrl &toUrl) {
+        DirSizeCache::instance()->invalidate(QStringList { fromUrl.path(), toUrl.path() });
+    });
 }
 
 void LocalFileWatcher::notifyFileAdded(const QUrl &url)
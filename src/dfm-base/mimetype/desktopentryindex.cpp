@@ -0,0 +1,197 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "desktopentryindex.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QLocale>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QDebug>
+
+#include <sys/stat.h>
+
+namespace dfmbase {
+
+namespace {
+constexpr quint32 kIndexMagic { 0x44454931 };   // "DEI1"
+constexpr qint32 kIndexVersion { 1 };
+// 修改时间距今不足该值时不记录，避免同一时间片内的后续修改被漏掉
+constexpr qint64 kUnstableMtimeNs { 2LL * 1000 * 1000 * 1000 };
+
+qint64 mtimeOf(const QString &path)
+{
+    struct stat st;
+    if (::stat(QFile::encodeName(path).constData(), &st) != 0)
+        return -1;
+    return static_cast<qint64>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+}
+
+qint64 stableMtime(qint64 mtime)
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch() * 1000000;
+    return now - mtime < kUnstableMtimeNs ? 0 : mtime;
+}
+}   // namespace
+
+DesktopEntryIndex *DesktopEntryIndex::instance()
+{
+    static DesktopEntryIndex ins;
+    return &ins;
+}
+
+QList<DesktopFile> DesktopEntryIndex::refresh(const QStringList &folders)
+{
+    QMutexLocker locker(&mutex);
+    ensureLoaded();
+
+    QHash<QString, DirEntry> seenDirs;
+    QHash<QString, FileEntry> seenFiles;
+    QList<DesktopFile> result;
+    seenDirs.reserve(dirs.size());
+    seenFiles.reserve(files.size());
+
+    for (const QString &folder : folders)
+        scanDirectory(QDir::cleanPath(folder), &seenDirs, &seenFiles, &result);
+
+    // 有目录或文件被删除
+    if (seenDirs.size() != dirs.size() || seenFiles.size() != files.size())
+        modified = true;
+
+    dirs.swap(seenDirs);
+    files.swap(seenFiles);
+    return result;
+}
+
+void DesktopEntryIndex::scanDirectory(const QString &path, QHash<QString, DirEntry> *seenDirs,
+                                      QHash<QString, FileEntry> *seenFiles, QList<DesktopFile> *result)
+{
+    if (seenDirs->contains(path))
+        return;
+
+    const qint64 dirMtime = mtimeOf(path);
+    if (dirMtime < 0)
+        return;
+
+    DirEntry dir = dirs.value(path);
+    if (dir.mtime != dirMtime) {
+        QDir qdir(path);
+        dir.mtime = stableMtime(dirMtime);
+        dir.files = qdir.entryList(QStringList("*.desktop"), QDir::Files);
+        dir.subdirs = qdir.entryList(QDir::Dirs | QDir::NoDotAndDotDot | QDir::NoSymLinks);
+        modified = true;
+    }
+    seenDirs->insert(path, dir);
+
+    for (const QString &name : dir.files) {
+        const QString filePath = path + '/' + name;
+        const qint64 fileMtime = mtimeOf(filePath);
+        if (fileMtime < 0)
+            continue;
+
+        FileEntry entry;
+        auto it = files.constFind(filePath);
+        if (it != files.constEnd() && it->mtime == fileMtime) {
+            entry = it.value();
+        } else {
+            entry.mtime = stableMtime(fileMtime);
+            entry.desktop = DesktopFile(filePath);
+            modified = true;
+        }
+        seenFiles->insert(filePath, entry);
+        result->append(entry.desktop);
+    }
+
+    for (const QString &name : dir.subdirs)
+        scanDirectory(path + '/' + name, seenDirs, seenFiles, result);
+}
+
+void DesktopEntryIndex::save()
+{
+    QMutexLocker locker(&mutex);
+    if (!modified)
+        return;
+
+    const QString &filePath = cacheFilePath();
+    if (!QDir().mkpath(QFileInfo(filePath).absolutePath()))
+        return;
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(logDFMBase) << "DesktopEntryIndex: failed to open index file" << file.fileName();
+        return;
+    }
+
+    QDataStream out(&file);
+    out << kIndexMagic << kIndexVersion << QLocale::system().name();
+    out << static_cast<qint32>(dirs.size());
+    for (auto it = dirs.cbegin(); it != dirs.cend(); ++it)
+        out << it.key() << it->mtime << it->files << it->subdirs;
+    out << static_cast<qint32>(files.size());
+    for (auto it = files.cbegin(); it != files.cend(); ++it)
+        out << it.key() << it->mtime << it->desktop;
+
+    if (file.commit())
+        modified = false;
+    else
+        qCWarning(logDFMBase) << "DesktopEntryIndex: failed to write index file" << file.fileName();
+}
+
+void DesktopEntryIndex::ensureLoaded()
+{
+    if (loaded)
+        return;
+    loaded = true;
+
+    QFile file(cacheFilePath());
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    QDataStream in(&file);
+    quint32 magic = 0;
+    qint32 version = 0;
+    QString locale;
+    in >> magic >> version;
+    if (magic != kIndexMagic || version != kIndexVersion)
+        return;
+
+    in >> locale;
+    if (locale != QLocale::system().name())
+        return;
+
+    qint32 count = 0;
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString path;
+        DirEntry dir;
+        in >> path >> dir.mtime >> dir.files >> dir.subdirs;
+        dirs.insert(path, dir);
+    }
+
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString path;
+        FileEntry entry;
+        in >> path >> entry.mtime >> entry.desktop;
+        files.insert(path, entry);
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        qCWarning(logDFMBase) << "DesktopEntryIndex: corrupted index file, discarding" << file.fileName();
+        dirs.clear();
+        files.clear();
+    }
+}
+
+QString DesktopEntryIndex::cacheFilePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation)
+            + "/deepin/dde-file-manager/desktopentry.index";
+}
+
+}   // namespace dfmbase
@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DESKTOPENTRYINDEX_H
+#define DESKTOPENTRYINDEX_H
+
+#include <dfm-base/dfm_base_global.h>
+#include <dfm-base/utils/desktopfile.h>
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QStringList>
+
+namespace dfmbase {
+
+/**
+ * @brief 应用目录中 .desktop 文件的持久化索引
+ *
+ * 记录每个目录的 mtime 及其下的 .desktop 文件和子目录列表，以及每个 .desktop 文件的 mtime
+ * 和解析结果。刷新时目录 mtime 未变则直接复用其列表，不再列目录；文件 mtime 未变则复用解析结果，
+ * 因此只有新增和改动过的文件需要重新解析。
+ *
+ * 解析结果中的本地化名称依赖系统语言，语言变化后整个索引作废。
+ *
+ * 线程安全，可在任意线程调用。
+ */
+class DesktopEntryIndex
+{
+public:
+    static DesktopEntryIndex *instance();
+
+    /**
+     * @brief 按当前文件系统状态刷新索引
+     * @param folders 应用目录，递归扫描
+     * @return 所有 .desktop 文件的解析结果
+     */
+    QList<DesktopFile> refresh(const QStringList &folders);
+
+    /**
+     * @brief 索引有变化时写回磁盘
+     */
+    void save();
+
+private:
+    struct DirEntry
+    {
+        qint64 mtime { 0 };
+        QStringList files;   ///< 目录下的 .desktop 文件名
+        QStringList subdirs;   ///< 子目录名，不含符号链接
+    };
+
+    struct FileEntry
+    {
+        qint64 mtime { 0 };
+        DesktopFile desktop;
+    };
+
+    DesktopEntryIndex() = default;
+
+    void scanDirectory(const QString &path, QHash<QString, DirEntry> *seenDirs,
+                       QHash<QString, FileEntry> *seenFiles, QList<DesktopFile> *result);
+    void ensureLoaded();
+
+    static QString cacheFilePath();
+
+    QMutex mutex;
+    QHash<QString, DirEntry> dirs;
+    QHash<QString, FileEntry> files;
+    bool loaded { false };
+    bool modified { false };
+};
+
+}
+
+#endif   // DESKTOPENTRYINDEX_H
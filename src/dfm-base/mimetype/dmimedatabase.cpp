@@ -12,8 +12,12 @@
 
 #include <QUrl>
 #include <QFileInfo>
+#include <QHash>
+#include <QReadWriteLock>
 #include <QRegularExpression>
 
+#include <sys/stat.h>
+
 using namespace dfmbase;
 
 static QStringList wrongMimeTypeNames {
@@ -24,6 +28,115 @@ static QStringList officeSuffixList {
 };
 static const QStringList blackList { "/sys/kernel/security/apparmor/revision", "/sys/kernel/security/apparmor/policy/revision", "/sys/power/wakeup_count", "/proc/kmsg" };
 
+namespace {
+
+// 超过该数量时整体清空，避免长时间运行后无限增长
+constexpr int kMaxCachedMimeTypes { 50000 };
+
+bool isGvfsPath(const QString &path)
+{
+#if (QT_VERSION < QT_VERSION_CHECK(6, 0, 0))
+    static const QRegularExpression regExp("^/run/user/\\d+/gvfs/(?<scheme>\\w+(-?)\\w+):\\S*",
+                                           QRegularExpression::DotMatchesEverythingOption
+                                                   | QRegularExpression::DontCaptureOption
+                                                   | QRegularExpression::OptimizeOnFirstUsageOption);
+#else
+    static const QRegularExpression regExp("^/run/user/\\d+/gvfs/(?<scheme>\\w+(-?)\\w+):\\S*",
+                                           QRegularExpression::DotMatchesEverythingOption
+                                                   | QRegularExpression::DontCaptureOption);
+#endif
+
+    const QRegularExpressionMatch &match = regExp.match(path, 0, QRegularExpression::NormalMatch,
+                                                        QRegularExpression::DontCheckSubjectStringMatchOption);
+    return match.hasMatch();
+}
+
+/*!
+ * \brief 进程级的 MIME 检测结果缓存
+ *
+ * 以路径为键，同时记录 (设备号, inode)、修改时间和大小，只有全部一致时才复用结果。
+ * MIME 类型还取决于文件名（按扩展名匹配），因此不能只按 inode 缓存：
+ * 文件改名或通过不同扩展名的硬链接访问时会重新检测；文件被改写后也不会拿到旧结果。
+ * 只缓存默认匹配模式下的结果。
+ */
+class MimeTypeCache
+{
+public:
+    using FileId = QPair<quint64, quint64>;   // (dev, inode)
+
+    struct Identity
+    {
+        QString path;
+        FileId id;
+        qint64 mtimeNs { 0 };
+        qint64 size { 0 };
+        bool isRegularFile { false };
+    };
+
+    static MimeTypeCache &instance()
+    {
+        static MimeTypeCache ins;
+        return ins;
+    }
+
+    static bool identityOf(const QString &path, Identity *identity)
+    {
+        struct stat st;
+        if (path.isEmpty() || ::stat(path.toLocal8Bit().constData(), &st) != 0)
+            return false;
+
+        identity->path = path;
+        identity->id = qMakePair(static_cast<quint64>(st.st_dev), static_cast<quint64>(st.st_ino));
+        identity->mtimeNs = static_cast<qint64>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+        identity->size = static_cast<qint64>(st.st_size);
+        identity->isRegularFile = S_ISREG(st.st_mode);
+        return true;
+    }
+
+    bool find(const Identity &identity, QMimeType *type) const
+    {
+        QReadLocker locker(&lock);
+        auto it = entries.constFind(identity.path);
+        if (it == entries.constEnd() || it->id != identity.id
+            || it->mtimeNs != identity.mtimeNs || it->size != identity.size)
+            return false;
+
+        *type = it->type;
+        return true;
+    }
+
+    void insert(const Identity &identity, const QMimeType &type)
+    {
+        if (!type.isValid())
+            return;
+
+        QWriteLocker locker(&lock);
+        if (entries.size() >= kMaxCachedMimeTypes)
+            entries.clear();
+        entries.insert(identity.path, { identity.id, identity.mtimeNs, identity.size, type });
+    }
+
+    void remove(const QString &path)
+    {
+        QWriteLocker locker(&lock);
+        entries.remove(path);
+    }
+
+private:
+    struct Entry
+    {
+        FileId id;
+        qint64 mtimeNs;
+        qint64 size;
+        QMimeType type;
+    };
+
+    mutable QReadWriteLock lock;
+    QHash<QString, Entry> entries;
+};
+
+}   // namespace
+
 DMimeDatabase::DMimeDatabase()
 {
 }
@@ -48,21 +161,7 @@ QMimeType DMimeDatabase::mimeTypeForFile(const FileInfoPointer &fileInfo, QMimeD
         // fix bug 35448 【文件管理器】【5.1.2.2-1】【sp2】预览ftp路径下某个文件夹后，文管卡死,访问特殊系统文件卡死
         if (fileInfo->nameOf(NameInfoType::kFileName).endsWith(".pid") || path.endsWith("msg.lock")
             || fileInfo->nameOf(NameInfoType::kFileName).endsWith(".lock") || fileInfo->nameOf(NameInfoType::kFileName).endsWith("lockfile")) {
-#if (QT_VERSION < QT_VERSION_CHECK(6, 0, 0))
-            QRegularExpression regExp("^/run/user/\\d+/gvfs/(?<scheme>\\w+(-?)\\w+):\\S*",
-                                      QRegularExpression::DotMatchesEverythingOption
-                                              | QRegularExpression::DontCaptureOption
-                                              | QRegularExpression::OptimizeOnFirstUsageOption);
-#else
-            QRegularExpression regExp("^/run/user/\\d+/gvfs/(?<scheme>\\w+(-?)\\w+):\\S*",
-                                      QRegularExpression::DotMatchesEverythingOption
-                                              | QRegularExpression::DontCaptureOption);
-#endif
-
-            const QRegularExpressionMatch &match = regExp.match(path, 0, QRegularExpression::NormalMatch,
-                                                                QRegularExpression::DontCheckSubjectStringMatchOption);
-
-            isMatchExtension = match.hasMatch();
+            isMatchExtension = isGvfsPath(path);
         } else {
             // filemanger will be blocked when blacklist contais the filepath.
             QString filePath = fileInfo->pathOf(PathInfoType::kAbsoluteFilePath);
@@ -73,10 +172,17 @@ QMimeType DMimeDatabase::mimeTypeForFile(const FileInfoPointer &fileInfo, QMimeD
         }
     }
 
+    const QString filePath = fileInfo->pathOf(PathInfoType::kFilePath);
+    MimeTypeCache::Identity identity;
+    const bool canCache = !isMatchExtension && mode == QMimeDatabase::MatchDefault
+            && MimeTypeCache::identityOf(filePath, &identity);
+    if (canCache && MimeTypeCache::instance().find(identity, &result))
+        return result;
+
     if (isMatchExtension) {
-        result = QMimeDatabase::mimeTypeForFile(fileInfo->pathOf(PathInfoType::kFilePath), QMimeDatabase::MatchExtension);
+        result = QMimeDatabase::mimeTypeForFile(filePath, QMimeDatabase::MatchExtension);
     } else {
-        result = QMimeDatabase::mimeTypeForFile(fileInfo->pathOf(PathInfoType::kFilePath), mode);
+        result = detectMimeType(filePath, fileInfo->nameOf(NameInfoType::kFileName), mode, canCache && identity.isRegularFile);
     }
 
     // temporary dirty fix, once WPS get installed, the whole mimetype database thing get fscked up.
@@ -90,12 +196,28 @@ QMimeType DMimeDatabase::mimeTypeForFile(const FileInfoPointer &fileInfo, QMimeD
         && wrongMimeTypeNames.contains(result.name())) {
         QList<QMimeType> results = QMimeDatabase::mimeTypesForFileName(fileInfo->nameOf(NameInfoType::kFileName));
         if (!results.isEmpty()) {
-            return results.first();
+            result = results.first();
         }
     }
+
+    if (canCache)
+        MimeTypeCache::instance().insert(identity, result);
     return result;
 }
 
+QMimeType DMimeDatabase::detectMimeType(const QString &filePath, const QString &fileName, MatchMode mode, bool isRegularFile) const
+{
+    // 已知是普通文件时，扩展名只对应一种类型就直接采用，不再打开文件读取内容；
+    // 扩展名未知或有歧义时才按内容检测
+    if (isRegularFile && mode == QMimeDatabase::MatchDefault) {
+        const QList<QMimeType> &candidates = QMimeDatabase::mimeTypesForFileName(fileName);
+        if (candidates.size() == 1 && candidates.first().isValid())
+            return candidates.first();
+    }
+
+    return QMimeDatabase::mimeTypeForFile(filePath, mode);
+}
+
 QMimeType DMimeDatabase::mimeTypeForFile(const QString &fileName, QMimeDatabase::MatchMode mode, const QString &inod, const bool isGvfs) const
 {
     if (!inod.isEmpty() && inodMimetypeCache.contains(inod)) {
@@ -132,21 +254,7 @@ QMimeType DMimeDatabase::mimeTypeForFile(const QFileInfo &fileInfo, QMimeDatabas
     if (!isMatchExtension) {
         if (fileInfo.fileName().endsWith(".pid") || path.endsWith("msg.lock")
             || fileInfo.fileName().endsWith(".lock") || fileInfo.fileName().endsWith("lockfile")) {
-#if (QT_VERSION < QT_VERSION_CHECK(6, 0, 0))
-            QRegularExpression regExp("^/run/user/\\d+/gvfs/(?<scheme>\\w+(-?)\\w+):\\S*",
-                                      QRegularExpression::DotMatchesEverythingOption
-                                              | QRegularExpression::DontCaptureOption
-                                              | QRegularExpression::OptimizeOnFirstUsageOption);
-#else
-            QRegularExpression regExp("^/run/user/\\d+/gvfs/(?<scheme>\\w+(-?)\\w+):\\S*",
-                                      QRegularExpression::DotMatchesEverythingOption
-                                              | QRegularExpression::DontCaptureOption);
-#endif
-
-            const QRegularExpressionMatch &match = regExp.match(path, 0, QRegularExpression::NormalMatch,
-                                                                QRegularExpression::DontCheckSubjectStringMatchOption);
-
-            isMatchExtension = match.hasMatch();
+            isMatchExtension = isGvfsPath(path);
         } else {
             // filemanger will be blocked when blacklist contais the filepath.
             // fix task #29124, bug #108805
@@ -157,10 +265,20 @@ QMimeType DMimeDatabase::mimeTypeForFile(const QFileInfo &fileInfo, QMimeDatabas
             isMatchExtension = blackList.contains(filePath);
         }
     }
+    MimeTypeCache::Identity identity;
+    const QString filePath = fileInfo.absoluteFilePath();
+    const bool canCacheGlobally = !isMatchExtension && mode == QMimeDatabase::MatchDefault
+            && MimeTypeCache::identityOf(filePath, &identity);
+    if (canCacheGlobally && MimeTypeCache::instance().find(identity, &result)) {
+        if (canCache)
+            const_cast<DMimeDatabase *>(this)->inodMimetypeCache.insert(inod, result);
+        return result;
+    }
+
     if (isMatchExtension) {
         result = QMimeDatabase::mimeTypeForFile(fileInfo, QMimeDatabase::MatchExtension);
     } else {
-        result = QMimeDatabase::mimeTypeForFile(fileInfo, mode);
+        result = detectMimeType(filePath, fileInfo.fileName(), mode, canCacheGlobally && identity.isRegularFile);
     }
 
     // temporary dirty fix, once WPS get installed, the whole mimetype database thing get fscked up.
@@ -173,18 +291,23 @@ QMimeType DMimeDatabase::mimeTypeForFile(const QFileInfo &fileInfo, QMimeDatabas
     if (officeSuffixList.contains(fileInfo.suffix()) && wrongMimeTypeNames.contains(result.name())) {
         QList<QMimeType> results = QMimeDatabase::mimeTypesForFileName(fileInfo.fileName());
         if (!results.isEmpty()) {
-            if (canCache) {
-                const_cast<DMimeDatabase *>(this)->inodMimetypeCache.insert(inod, results.first());
-            }
-            return results.first();
+            result = results.first();
         }
     }
+    if (canCacheGlobally)
+        MimeTypeCache::instance().insert(identity, result);
     if (canCache) {
         const_cast<DMimeDatabase *>(this)->inodMimetypeCache.insert(inod, result);
     }
     return result;
 }
 
+void DMimeDatabase::removeCachedMimeType(const QUrl &url)
+{
+    if (url.isLocalFile())
+        MimeTypeCache::instance().remove(url.toLocalFile());
+}
+
 QMimeType DMimeDatabase::mimeTypeForUrl(const QUrl &url) const
 {
     if (url.isLocalFile())
@@ -24,8 +24,14 @@ public:
     QMimeType mimeTypeForFile(const QString &fileName, MatchMode mode, const QString &inod, const bool isGvfs = false) const;
     QMimeType mimeTypeForUrl(const QUrl &url) const;
 
+    /*!
+     * \brief 移除进程级 MIME 缓存中该文件的检测结果，文件变化或删除时调用
+     */
+    static void removeCachedMimeType(const QUrl &url);
+
 private:
     QMimeType mimeTypeForFile(const QFileInfo &fileInfo, MatchMode mode, const QString &inod, const bool isGvfs = false) const;
+    QMimeType detectMimeType(const QString &filePath, const QString &fileName, MatchMode mode, bool isRegularFile) const;
 
 private:
     QHash<QString, QMimeType> inodMimetypeCache;
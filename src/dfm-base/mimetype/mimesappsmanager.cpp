@@ -6,6 +6,7 @@
 
 #include <dfm-base/mimetype/dmimedatabase.h>
 #include <dfm-base/mimetype/mimetypedisplaymanager.h>
+#include <dfm-base/mimetype/desktopentryindex.h>
 #include <dfm-base/base/standardpaths.h>
 
 #include <QDir>
@@ -34,7 +35,7 @@ extern "C" {
 using namespace dfmbase;
 
 QStringList MimesAppsManager::DesktopFiles = {};
-QMap<QString, QStringList> MimesAppsManager::MimeApps = {};
+QHash<QString, QStringList> MimesAppsManager::MimeApps = {};
 QMap<QString, QStringList> MimesAppsManager::DDE_MimeTypes = {};
 QMap<QString, DesktopFile> MimesAppsManager::VideoMimeApps = {};
 QMap<QString, DesktopFile> MimesAppsManager::ImageMimeApps = {};
@@ -469,73 +470,60 @@ void MimesAppsManager::initMimeTypeApps()
     DesktopFiles.clear();
     DesktopObjs.clear();
     DDE_MimeTypes.clear();
+    MimeApps.clear();
 
-    QMap<QString, QSet<QString>> mimeAppsSet;
+    QHash<QString, QSet<QString>> mimeAppsSet;
     loadDDEMimeTypes();
 
     const QStringList &appFolders = getApplicationsFolders();
     qCDebug(logDFMBase) << "MimesAppsManager::initMimeTypeApps: Scanning application folders:" << appFolders;
 
+    // 只重新解析新增或改动过的 .desktop 文件
+    const QList<DesktopFile> &desktopFiles = DesktopEntryIndex::instance()->refresh(appFolders);
+    DesktopEntryIndex::instance()->save();
+
     int totalDesktopFiles = 0;
-    for (const QString &desktopFolder : appFolders) {
-        QDirIterator it(desktopFolder, QStringList("*.desktop"), QDir::Files | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
-        int folderCount = 0;
-        while (it.hasNext()) {
-            it.next();
-            const QString &filePath = it.filePath();
-            DesktopFile desktopFile(filePath);
-            if (desktopFile.isNoShow())
-                continue;
+    for (const DesktopFile &desktopFile : desktopFiles) {
+        if (desktopFile.isNoShow())
+            continue;
 
-            DesktopFiles.append(filePath);
-            DesktopObjs.insert(filePath, desktopFile);
-            QStringList mimeTypes = desktopFile.desktopMimeType();
-            QString fileName = QFileInfo(filePath).fileName();
-            if (DDE_MimeTypes.contains(fileName)) {
-                mimeTypes.append(DDE_MimeTypes.value(fileName));
-            }
+        const QString &filePath = desktopFile.desktopFileName();
+        DesktopFiles.append(filePath);
+        DesktopObjs.insert(filePath, desktopFile);
+        QStringList mimeTypes = desktopFile.desktopMimeType();
+        const QString &fileName = filePath.mid(filePath.lastIndexOf('/') + 1);
+        if (DDE_MimeTypes.contains(fileName)) {
+            mimeTypes.append(DDE_MimeTypes.value(fileName));
+        }
 
-            for (const QString &mimeType : mimeTypes) {
-                if (!mimeType.isEmpty()) {
-                    QSet<QString> apps;
-                    if (mimeAppsSet.contains(mimeType)) {
-                        apps = mimeAppsSet.value(mimeType);
-                        apps.insert(filePath);
-                    } else {
-                        apps.insert(filePath);
-                    }
-                    mimeAppsSet.insert(mimeType, apps);
-                }
-            }
-            folderCount++;
-            totalDesktopFiles++;
+        for (const QString &mimeType : mimeTypes) {
+            if (!mimeType.isEmpty())
+                mimeAppsSet[mimeType].insert(filePath);
         }
-        qCDebug(logDFMBase) << "MimesAppsManager::initMimeTypeApps: Found" << folderCount
-                            << "desktop files in:" << desktopFolder;
+        totalDesktopFiles++;
     }
 
     qCInfo(logDFMBase) << "MimesAppsManager::initMimeTypeApps: Loaded" << totalDesktopFiles
                        << "desktop files, processing" << mimeAppsSet.size() << "MIME types";
 
-    for (const QString &key : mimeAppsSet.keys()) {
-        QSet<QString> apps = mimeAppsSet.value(key);
-        QStringList orderApps;
-        if (apps.count() > 1) {
-            QFileInfoList fileInfos;
-            for (const QString &app : apps) {
-                QFileInfo info(app);
-                fileInfos.append(info);
-            }
-
-            std::sort(fileInfos.begin(), fileInfos.end(), MimesAppsManager::lessByDateTime);
+    // 同一应用会出现在多个 MIME 类型下，创建时间只取一次
+    QHash<QString, QDateTime> birthTimes;
+    auto birthTimeOf = [&birthTimes](const QString &app) {
+        auto it = birthTimes.constFind(app);
+        if (it == birthTimes.constEnd())
+            it = birthTimes.insert(app, QFileInfo(app).birthTime());
+        return it.value();
+    };
 
-            for (const QFileInfo &info : fileInfos) {
-                orderApps.append(info.absoluteFilePath());
-            }
-        } else {
-            orderApps.append(apps.values());
+    MimeApps.reserve(mimeAppsSet.size());
+    for (auto it = mimeAppsSet.cbegin(); it != mimeAppsSet.cend(); ++it) {
+        QStringList orderApps = it.value().values();
+        if (orderApps.count() > 1) {
+            std::sort(orderApps.begin(), orderApps.end(), [&birthTimeOf](const QString &a1, const QString &a2) {
+                return birthTimeOf(a1) < birthTimeOf(a2);
+            });
         }
-        MimeApps.insert(key, orderApps);
+        MimeApps.insert(it.key(), orderApps);
     }
 
     // check mime apps from cache
@@ -589,8 +577,7 @@ void MimesAppsManager::initMimeTypeApps()
             const QString path = QString("%1/%2").arg(mimeInfoCacheRootPath, desktop);
             if (!QFile::exists(path))
                 continue;
-            DesktopFile df(path);
-            targetMap.insert(path, df);
+            targetMap.insert(path, DesktopObjs.contains(path) ? DesktopObjs.value(path) : DesktopFile(path));
             validCount++;
         }
         qCDebug(logDFMBase) << "MimesAppsManager::initMimeTypeApps: Processed" << validCount
@@ -12,6 +12,7 @@
 
 #include <QObject>
 #include <QSet>
+#include <QHash>
 #include <QMimeType>
 #include <QMap>
 #include <QFileInfo>
@@ -54,7 +55,7 @@ public:
     ~MimesAppsManager();
 
     static QStringList DesktopFiles;
-    static QMap<QString, QStringList> MimeApps;
+    static QHash<QString, QStringList> MimeApps;
     static QMap<QString, QStringList> DDE_MimeTypes;
     // specially cache for video, image, text and audio
     static QMap<QString, DesktopFile> VideoMimeApps;
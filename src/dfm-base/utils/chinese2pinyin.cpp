@@ -5,60 +5,138 @@
 #include "chinese2pinyin.h"
 
 #include <QHash>
-#include <QTextStream>
 #include <QFile>
+#include <QVector>
 
 namespace Pinyin {
 
-static QHash<uint, QString> dict = {};
-
 const char kDictFile[] = ":/misc/pinyin.dict";
 
-void InitDict() {
-    if (!dict.isEmpty()) {
-        return;
+namespace {
+
+/*!
+ * \brief 由字典资源生成的只读拼音表
+ *
+ * 以码位减去最小码位为下标直接索引，表项是读音在音节池中的序号（0 表示未收录），
+ * 相同的读音只保存一份。表在首次使用时构建（局部静态变量的初始化是线程安全的），
+ * 之后不再修改，各线程可以无锁并发查询。
+ */
+class PinyinTable
+{
+public:
+    static const PinyinTable& instance()
+    {
+        static const PinyinTable table;
+        return table;
     }
 
-    dict.reserve(25333);
+    const QString* syllableOf(QChar ch) const
+    {
+        const uint offset = static_cast<uint>(ch.unicode()) - base;
+        if (offset >= static_cast<uint>(index.size()))
+            return nullptr;
 
-    QFile file(kDictFile);
+        const quint16 slot = index.at(static_cast<int>(offset));
+        return slot ? &syllables.at(slot - 1) : nullptr;
+    }
 
-    if (!file.open(QIODevice::ReadOnly))
-        return;
+private:
+    PinyinTable()
+    {
+        QFile file(kDictFile);
+        if (!file.open(QIODevice::ReadOnly))
+            return;
+
+        const QByteArray content = file.readAll();
+        file.close();
+
+        // 每行格式为 "0x4e2d:zhong1"
+        QVector<QPair<uint, quint16>> entries;
+        QHash<QByteArray, quint16> pool;
+        entries.reserve(25333);
+
+        uint minCode = 0xFFFF;
+        uint maxCode = 0;
+        for (const QByteArray& line : content.split('\n')) {
+            const int sep = line.indexOf(':');
+            if (sep <= 0)
+                continue;
+
+            bool ok = false;
+            const uint code = line.left(sep).toUInt(&ok, 16);
+            const QByteArray syllable = line.mid(sep + 1).trimmed();
+            if (!ok || code > 0xFFFF || syllable.isEmpty())
+                continue;
+
+            auto it = pool.constFind(syllable);
+            if (it == pool.constEnd()) {
+                syllables.append(QString::fromLatin1(syllable));
+                it = pool.insert(syllable, static_cast<quint16>(syllables.size()));
+            }
+
+            entries.append(qMakePair(code, it.value()));
+            minCode = qMin(minCode, code);
+            maxCode = qMax(maxCode, code);
+        }
 
-    QByteArray content = file.readAll();
+        if (entries.isEmpty())
+            return;
 
-    file.close();
+        base = minCode;
+        index.fill(0, static_cast<int>(maxCode - minCode + 1));
+        for (const auto& entry : entries)
+            index[static_cast<int>(entry.first - base)] = entry.second;
+    }
 
-    QTextStream stream(&content, QIODevice::ReadOnly);
+    uint base { 0 };
+    QVector<quint16> index;
+    QVector<QString> syllables;
+};
 
-    while (!stream.atEnd()) {
-        const QString line = stream.readLine();
-        const QStringList items = line.split(QChar(':'));
+}  // namespace
 
-        if (items.size() == 2) {
-            dict.insert(static_cast<uint>(items[0].toInt(nullptr, 16)), items[1]);
-        }
-    }
+QString Chinese2Pinyin(const QString& words) {
+    QString result;
+    Chinese2Pinyin(words, &result);
+    return result;
 }
 
-QString Chinese2Pinyin(const QString& words) {
-    InitDict();
+void Chinese2Pinyin(const QString& words, QString* result) {
+    const PinyinTable& table = PinyinTable::instance();
 
-    QString result;
+    result->clear();
+    result->reserve(words.length() * 4);
+
+    for (const QChar& ch : words) {
+        if (const QString* syllable = table.syllableOf(ch))
+            result->append(*syllable);
+        else
+            result->append(ch);
+    }
+}
+
+void Chinese2Pinyin(const QString& words, QString* full, QString* initials) {
+    const PinyinTable& table = PinyinTable::instance();
 
-    for (int i = 0; i < words.length(); ++i) {
-        const uint key = words.at(i).unicode();
-        auto find_result = dict.find(key);
+    full->clear();
+    full->reserve(words.length() * 4);
+    initials->clear();
+    initials->reserve(words.length());
 
-        if (find_result != dict.end()) {
-            result.append(find_result.value());
+    for (const QChar& ch : words) {
+        if (const QString* syllable = table.syllableOf(ch)) {
+            full->append(*syllable);
+            initials->append(syllable->at(0));
         } else {
-            result.append(words.at(i));
+            full->append(ch);
+            initials->append(ch);
         }
     }
+}
 
-    return result;
+QChar InitialOf(QChar ch) {
+    const QString* syllable = PinyinTable::instance().syllableOf(ch);
+    return syllable ? syllable->at(0) : QChar();
 }
 
 }  // namespace Pinyin end
@@ -9,6 +9,15 @@
 
 namespace Pinyin {
 QString Chinese2Pinyin(const QString& words);
+
+// 转换结果写入 result（会先清空），循环中调用时可复用同一个缓冲区
+void Chinese2Pinyin(const QString& words, QString* result);
+
+// 一次转换同时得到全拼和拼音首字母，非汉字原样写入两者
+void Chinese2Pinyin(const QString& words, QString* full, QString* initials);
+
+// 汉字拼音的首字母，不是已收录的汉字时返回空 QChar
+QChar InitialOf(QChar ch);
 };
 
 #endif  // CHINESE_2_PINYIN_H
@@ -6,7 +6,7 @@
 #include "properties.h"
 
 #include <QFile>
-#include <QSettings>
+#include <QDataStream>
 #include <QDebug>
 #include <QLocale>
 
@@ -20,34 +20,33 @@ DesktopFile::DesktopFile(const QString &fileName)
         return;
     }
 
-    QSettings settings(fileName, QSettings::IniFormat);
-    settings.beginGroup("Desktop Entry");
     // Loads .desktop file (read from 'Desktop Entry' group)
+    // 只解析一遍：Properties 能读出 QSettings 读到的所有键，且 QSettings 会把 ';' 当作注释截断取值
     Properties desktop(fileName, "Desktop Entry");
 
     if (desktop.contains("X-Deepin-AppID")) {
-        deepinId = desktop.value("X-Deepin-AppID", settings.value("X-Deepin-AppID")).toString();
+        deepinId = desktop.value("X-Deepin-AppID").toString();
     }
 
     if (desktop.contains("X-Deepin-Vendor")) {
-        deepinVendor = desktop.value("X-Deepin-Vendor", settings.value("X-Deepin-Vendor")).toString();
+        deepinVendor = desktop.value("X-Deepin-Vendor").toString();
     }
 
     if (desktop.contains("NoDisplay")) {
-        noDisplay = desktop.value("NoDisplay", settings.value("NoDisplay").toBool()).toBool();
+        noDisplay = desktop.value("NoDisplay").toBool();
     }
     if (desktop.contains("Hidden")) {
-        hidden = desktop.value("Hidden", settings.value("Hidden").toBool()).toBool();
+        hidden = desktop.value("Hidden").toBool();
     }
 
     // 由于获取的系统语言简写与.desktop的语言简写存在不对应关系，经决定先采用获取的系统值匹配
     // 若没匹配到则采用系统值"_"左侧的字符串进行匹配，均为匹配到，才走原未匹配流程
-    auto getValueFromSys = [&desktop, &settings](const QString &type, const QString &sysName) -> QString {
+    auto getValueFromSys = [&desktop](const QString &type, const QString &sysName) -> QString {
         const QString key = QString("%0[%1]").arg(type).arg(sysName);
-        return desktop.value(key, settings.value(key)).toString();
+        return desktop.value(key).toString();
     };
 
-    auto getNameByType = [&desktop, &settings, &getValueFromSys](const QString &type) -> QString {
+    auto getNameByType = [&desktop, &getValueFromSys](const QString &type) -> QString {
         QString tempSysName = QLocale::system().name();
         QString targetName = getValueFromSys(type, tempSysName);
         if (targetName.isEmpty()) {
@@ -58,7 +57,7 @@ DesktopFile::DesktopFile(const QString &fileName)
             }
 
             if (targetName.isEmpty())
-                targetName = desktop.value(type, settings.value(type)).toString();
+                targetName = desktop.value(type).toString();
         }
 
         return targetName;
@@ -66,12 +65,12 @@ DesktopFile::DesktopFile(const QString &fileName)
     localName = getNameByType("Name");
     genericName = getNameByType("GenericName");
 
-    exec = desktop.value("Exec", settings.value("Exec")).toString();
-    icon = desktop.value("Icon", settings.value("Icon")).toString();
-    type = desktop.value("Type", settings.value("Type", "Application")).toString();
-    categories = desktop.value("Categories", settings.value("Categories").toString()).toString().remove(" ").split(";");
+    exec = desktop.value("Exec").toString();
+    icon = desktop.value("Icon").toString();
+    type = desktop.value("Type", "Application").toString();
+    categories = desktop.value("Categories").toString().remove(" ").split(";");
 
-    QString mimeTypeTemp = desktop.value("MimeType", settings.value("MimeType").toString()).toString().remove(" ");
+    QString mimeTypeTemp = desktop.value("MimeType").toString().remove(" ");
 
     if (!mimeTypeTemp.isEmpty())
         mimeType = mimeTypeTemp.split(";");
@@ -163,3 +162,19 @@ QStringList DesktopFile::desktopMimeType() const
     return mimeType;
 }
 //---------------------------------------------------------------------------
+
+QDataStream &dfmbase::operator<<(QDataStream &out, const DesktopFile &file)
+{
+    out << file.fileName << file.name << file.genericName << file.localName << file.exec
+        << file.icon << file.type << file.categories << file.mimeType << file.deepinId
+        << file.deepinVendor << file.noDisplay << file.hidden;
+    return out;
+}
+
+QDataStream &dfmbase::operator>>(QDataStream &in, DesktopFile &file)
+{
+    in >> file.fileName >> file.name >> file.genericName >> file.localName >> file.exec
+            >> file.icon >> file.type >> file.categories >> file.mimeType >> file.deepinId
+            >> file.deepinVendor >> file.noDisplay >> file.hidden;
+    return in;
+}
@@ -9,6 +9,10 @@
 
 #include <QStringList>
 
+QT_BEGIN_NAMESPACE
+class QDataStream;
+QT_END_NAMESPACE
+
 /**
  * @class DesktopFile
  * @brief Represents a linux desktop file
@@ -36,6 +40,10 @@ public:
     QStringList desktopCategories() const;
     QStringList desktopMimeType() const;
 
+    // 用于应用索引的持久化
+    friend QDataStream &operator<<(QDataStream &out, const DesktopFile &file);
+    friend QDataStream &operator>>(QDataStream &in, DesktopFile &file);
+
 private:
     QString fileName;
     QString name;
@@ -52,6 +60,9 @@ private:
     bool hidden = false;
 };
 
+QDataStream &operator<<(QDataStream &out, const DesktopFile &file);
+QDataStream &operator>>(QDataStream &in, DesktopFile &file);
+
 }
 
 #endif   // DESKTOPFILE_H
@@ -0,0 +1,392 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dirsizecache.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QLockFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThread>
+#include <QThreadPool>
+#include <QUuid>
+#include <QVector>
+#include <QDebug>
+
+#include <algorithm>
+
+namespace dfmbase {
+
+namespace {
+constexpr quint32 kCacheMagic { 0x44534331 };   // "DSC1"
+constexpr qint32 kCacheVersion { 2 };
+constexpr int kMaxEntries { 100000 };
+constexpr int kMinCachedFiles { 64 };   // 小目录重新统计的代价很低，不值得占用缓存
+constexpr qint64 kMaxEntryAgeSecs { 24 * 60 * 60 };
+constexpr qint64 kJournalCompactSize { 1024 * 1024 };
+constexpr int kJournalLockTimeoutMs { 100 };
+constexpr int kJournalFlushDelayMs { 500 };   // 合并同一批文件事件
+constexpr int kJournalFlushRetries { 10 };
+
+QByteArray newJournalHeader(QByteArray *generation)
+{
+    *generation = QUuid::createUuid().toByteArray();
+    return '#' + *generation + '\n';
+}
+}   // namespace
+
+DirSizeCache *DirSizeCache::instance()
+{
+    static DirSizeCache ins;
+    return &ins;
+}
+
+DirSizeCache::DirSizeCache()
+{
+}
+
+qint64 DirSizeCache::mtimeOf(const struct stat &st)
+{
+    return static_cast<qint64>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+}
+
+bool DirSizeCache::lookup(const QByteArray &path, const struct stat &st, Entry *entry)
+{
+    Q_ASSERT(entry);
+    QMutexLocker locker(&mutex);
+    ensureLoaded();
+
+    auto it = entries.constFind(path);
+    if (it == entries.constEnd())
+        return false;
+
+    const Entry &cached = it.value();
+    if (cached.device != static_cast<quint64>(st.st_dev)
+        || cached.inode != static_cast<quint64>(st.st_ino)
+        || cached.mtime != mtimeOf(st)
+        || QDateTime::currentSecsSinceEpoch() - cached.storedAt > kMaxEntryAgeSecs) {
+        return false;
+    }
+
+    *entry = cached;
+    return true;
+}
+
+void DirSizeCache::store(const QByteArray &path, const struct stat &st, const Entry &entry)
+{
+    if (entry.fileCount < kMinCachedFiles)
+        return;
+
+    Entry value = entry;
+    value.device = st.st_dev;
+    value.inode = st.st_ino;
+    value.mtime = mtimeOf(st);
+    value.storedAt = QDateTime::currentSecsSinceEpoch();
+
+    QMutexLocker locker(&mutex);
+    ensureLoaded();
+    entries.insert(path, value);
+    modified = true;
+    if (entries.size() > kMaxEntries)
+        evictLocked();
+}
+
+void DirSizeCache::invalidate(const QString &path)
+{
+    invalidate(QStringList { path });
+}
+
+void DirSizeCache::invalidate(const QStringList &paths)
+{
+    QMutexLocker locker(&mutex);
+    // 已加载时立即生效；未加载时不在调用线程（通常是 GUI 线程）读取整个缓存文件，
+    // 队列中的路径在 syncJournal() 时生效
+    if (loaded) {
+        const int before = entries.size();
+        for (const QString &path : paths)
+            invalidateLocked(path.toUtf8());
+        if (entries.size() != before)
+            modified = true;
+    }
+
+    // 落盘日志，保证进程异常退出后磁盘快照也不会返回过期数据，也让其他进程看到失效
+    for (const QString &path : paths)
+        queuedInvalidations.insert(path);
+    scheduleFlushLocked();
+}
+
+void DirSizeCache::applyQueuedLocked()
+{
+    const int before = entries.size();
+    for (const QString &path : qAsConst(queuedInvalidations))
+        invalidateLocked(path.toUtf8());
+    if (entries.size() != before)
+        modified = true;
+}
+
+void DirSizeCache::scheduleFlushLocked()
+{
+    if (flushScheduled || queuedInvalidations.isEmpty())
+        return;
+
+    flushScheduled = true;
+    QThreadPool::globalInstance()->start([this] { flushQueued(); });
+}
+
+void DirSizeCache::flushQueued()
+{
+    QThread::msleep(kJournalFlushDelayMs);
+
+    int failures = 0;
+    while (true) {
+        QStringList paths;
+        {
+            QMutexLocker locker(&mutex);
+            if (queuedInvalidations.isEmpty() || failures > kJournalFlushRetries) {
+                // 多次失败时保留队列，下一次 invalidate() 或 save() 再次尝试
+                flushScheduled = false;
+                return;
+            }
+            paths = queuedInvalidations.values();
+        }
+
+        if (!appendJournal(paths)) {
+            ++failures;
+            QThread::msleep(kJournalFlushDelayMs);
+            continue;
+        }
+
+        // 写入日志后才移出队列，保证 syncJournal() 总能从其中之一看到这些路径
+        QMutexLocker locker(&mutex);
+        for (const QString &path : qAsConst(paths))
+            queuedInvalidations.remove(path);
+    }
+}
+
+void DirSizeCache::invalidateLocked(const QByteArray &path)
+{
+    QByteArray current = path;
+    while (current.size() > 1 && current.endsWith('/'))
+        current.chop(1);
+
+    while (!current.isEmpty()) {
+        entries.remove(current);
+        if (current == "/")
+            break;
+        const int slash = current.lastIndexOf('/');
+        if (slash < 0)
+            break;
+        current = slash == 0 ? QByteArray("/") : current.left(slash);
+    }
+}
+
+void DirSizeCache::evictLocked()
+{
+    // 淘汰最早写入的四分之一
+    QVector<qint64> stamps;
+    stamps.reserve(entries.size());
+    for (auto it = entries.cbegin(); it != entries.cend(); ++it)
+        stamps.append(it.value().storedAt);
+
+    auto nth = stamps.begin() + stamps.size() / 4;
+    std::nth_element(stamps.begin(), nth, stamps.end());
+    const qint64 threshold = *nth;
+
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (it.value().storedAt <= threshold)
+            it = entries.erase(it);
+        else
+            ++it;
+    }
+}
+
+QByteArray DirSizeCache::readJournalGeneration(QFile *journal)
+{
+    const QByteArray header = journal->readLine();
+    if (header.size() < 2 || !header.startsWith('#') || !header.endsWith('\n'))
+        return {};
+    return header.mid(1, header.size() - 2);
+}
+
+void DirSizeCache::syncJournal()
+{
+    // 没有日志时先创建，之后任何压缩都能通过代号变化察觉
+    if (!QFileInfo::exists(journalFilePath()))
+        appendJournal({});
+
+    QMutexLocker locker(&mutex);
+    ensureLoaded();
+    applyQueuedLocked();
+
+    QFile journal(journalFilePath());
+    if (!journal.open(QIODevice::ReadOnly))
+        return;
+
+    const QByteArray generation = readJournalGeneration(&journal);
+    if (generation.isEmpty())
+        return;
+
+    // 日志被其他进程压缩过（或快照来自其他代号），上次回放位置之后的记录可能已丢失
+    if (generation != journalGeneration || journal.size() < journalOffset) {
+        if (!entries.isEmpty())
+            qCInfo(logDFMBase) << "DirSizeCache: journal was compacted elsewhere, dropping" << entries.size() << "entries";
+        entries.clear();
+        journalGeneration = generation;
+        journalOffset = journal.pos();
+        modified = true;
+    }
+    if (journal.size() == journalOffset)
+        return;
+
+    journal.seek(journalOffset);
+    while (!journal.atEnd()) {
+        const QByteArray line = journal.readLine();
+        // 未写完的行留到下一次回放
+        if (!line.endsWith('\n'))
+            break;
+        invalidateLocked(line.chopped(1));
+        journalOffset += line.size();
+        modified = true;
+    }
+}
+
+void DirSizeCache::save()
+{
+    syncJournal();
+
+    QMutexLocker locker(&mutex);
+    scheduleFlushLocked();
+    if (!modified)
+        return;
+
+    if (!QDir().mkpath(cacheDir()))
+        return;
+
+    // 日志过大时在锁保护下截断并更换代号，其他进程回放时据此丢弃可能漏掉失效记录的条目
+    if (QFileInfo(journalFilePath()).size() > kJournalCompactSize) {
+        QLockFile lock(journalFilePath() + ".lock");
+        if (lock.tryLock(kJournalLockTimeoutMs)) {
+            QFile journal(journalFilePath());
+            // 代号不一致说明刚被其他进程压缩过，留给下一次 syncJournal() 处理
+            if (journal.open(QIODevice::ReadWrite) && readJournalGeneration(&journal) == journalGeneration) {
+                journal.seek(journalOffset);
+                while (!journal.atEnd()) {
+                    const QByteArray line = journal.readLine();
+                    if (line.endsWith('\n'))
+                        invalidateLocked(line.chopped(1));
+                }
+                journal.resize(0);
+                journal.seek(0);
+                const QByteArray header = newJournalHeader(&journalGeneration);
+                journal.write(header);
+                journalOffset = header.size();
+            }
+        }
+    }
+
+    QSaveFile file(cacheFilePath());
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(logDFMBase) << "DirSizeCache: failed to open cache file" << file.fileName();
+        return;
+    }
+
+    QDataStream out(&file);
+    out << kCacheMagic << kCacheVersion << journalGeneration << journalOffset << static_cast<qint32>(entries.size());
+    for (auto it = entries.cbegin(); it != entries.cend(); ++it) {
+        const Entry &e = it.value();
+        out << it.key() << e.device << e.inode << e.mtime << e.storedAt
+            << e.totalSize << e.progressSize << e.fileCount << e.directoryCount;
+    }
+
+    if (file.commit())
+        modified = false;
+    else
+        qCWarning(logDFMBase) << "DirSizeCache: failed to write cache file" << file.fileName();
+}
+
+bool DirSizeCache::appendJournal(const QStringList &paths)
+{
+    if (!QDir().mkpath(cacheDir()))
+        return false;
+
+    QByteArray data;
+    for (const QString &path : paths) {
+        data.append(path.toUtf8());
+        data.append('\n');
+    }
+
+    QLockFile lock(journalFilePath() + ".lock");
+    if (!lock.tryLock(kJournalLockTimeoutMs))
+        return false;
+
+    QFile journal(journalFilePath());
+    if (!journal.open(QIODevice::WriteOnly | QIODevice::Append))
+        return false;
+
+    // 新日志先写入代号
+    if (journal.size() == 0) {
+        QByteArray generation;
+        data.prepend(newJournalHeader(&generation));
+    }
+    return data.isEmpty() || journal.write(data) == data.size();
+}
+
+void DirSizeCache::ensureLoaded()
+{
+    if (loaded)
+        return;
+    loaded = true;
+
+    QFile file(cacheFilePath());
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    QDataStream in(&file);
+    quint32 magic = 0;
+    qint32 version = 0;
+    qint32 count = 0;
+    in >> magic >> version;
+    if (magic != kCacheMagic || version != kCacheVersion)
+        return;
+
+    in >> journalGeneration >> journalOffset >> count;
+    entries.reserve(count);
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QByteArray path;
+        Entry e;
+        in >> path >> e.device >> e.inode >> e.mtime >> e.storedAt
+           >> e.totalSize >> e.progressSize >> e.fileCount >> e.directoryCount;
+        entries.insert(path, e);
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        qCWarning(logDFMBase) << "DirSizeCache: corrupted cache file, discarding" << file.fileName();
+        entries.clear();
+        journalGeneration.clear();
+        journalOffset = 0;
+    }
+}
+
+QString DirSizeCache::cacheDir()
+{
+    // 使用固定目录而非 CacheLocation，文本索引服务进程需要写入同一份日志
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation)
+            + "/deepin/dde-file-manager";
+}
+
+QString DirSizeCache::cacheFilePath()
+{
+    return cacheDir() + "/dirsize.cache";
+}
+
+QString DirSizeCache::journalFilePath()
+{
+    return cacheDir() + "/dirsize.journal";
+}
+
+}   // namespace dfmbase
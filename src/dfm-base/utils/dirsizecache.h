@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DIRSIZECACHE_H
+#define DIRSIZECACHE_H
+
+#include <dfm-base/dfm_base_global.h>
+
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+#include <QStringList>
+
+#include <sys/stat.h>
+
+class QFile;
+
+namespace dfmbase {
+
+/**
+ * @brief 目录子树大小的持久化缓存
+ *
+ * 以 (dev, inode, mtime) 为有效性键，记录目录整棵子树的大小与文件/目录数量，
+ * 供 FileScanner 在 UseSizeCache 模式下直接复用未变化的子树。
+ *
+ * 失效方式：
+ * - 进程内：LocalFileWatcher 收到的事件通过 invalidate() 使该路径及其所有祖先失效
+ * - 跨进程：文本索引服务的 FSMonitor 通过 appendJournal() 写入失效日志，
+ *   文件管理器在每次扫描前 syncJournal() 回放
+ *
+ * 失效日志首行记录代号，压缩日志时更换代号。回放时代号不一致，说明日志被其他进程压缩过，
+ * 中间可能缺失了部分失效记录，此时丢弃内存中的全部条目。
+ *
+ * 线程安全，可在任意线程调用。
+ */
+class DirSizeCache
+{
+public:
+    struct Entry
+    {
+        quint64 device { 0 };
+        quint64 inode { 0 };
+        qint64 mtime { 0 };   ///< 纳秒精度的目录 mtime
+        qint64 storedAt { 0 };   ///< 写入时间（秒），超过有效期视为失效
+        qint64 totalSize { 0 };
+        qint64 progressSize { 0 };
+        int fileCount { 0 };
+        int directoryCount { 0 };   ///< 含目录自身
+    };
+
+    static DirSizeCache *instance();
+
+    /**
+     * @brief 查询目录缓存
+     * @param path 目录路径（规范化，无尾部 '/'）
+     * @param st 目录当前的 stat 结果，用于校验 dev/inode/mtime
+     */
+    bool lookup(const QByteArray &path, const struct stat &st, Entry *entry);
+    // 调用方不应写入含硬链接文件的子树：其大小取决于扫描顺序
+    void store(const QByteArray &path, const struct stat &st, const Entry &entry);
+
+    /**
+     * @brief 使路径本身及其所有祖先目录的统计失效
+     *
+     * 子目录的统计不受影响，下次扫描只需重新统计失效的这条链。
+     * 不在调用线程做文件 I/O：路径先合并到内存队列，由线程池延迟写入失效日志，失败时重试。
+     * 写入前的路径在 syncJournal() 时直接生效。
+     */
+    void invalidate(const QString &path);
+    void invalidate(const QStringList &paths);
+
+    /**
+     * @brief 回放其他进程写入的失效日志
+     */
+    void syncJournal();
+
+    /**
+     * @brief 有修改时写回磁盘
+     */
+    void save();
+
+    /**
+     * @brief 向失效日志追加路径，不加载缓存本身，供其他进程调用
+     * @return 获取日志锁失败或写入失败时返回 false
+     */
+    static bool appendJournal(const QStringList &paths);
+
+    static qint64 mtimeOf(const struct stat &st);
+
+private:
+    DirSizeCache();
+    void ensureLoaded();
+    void invalidateLocked(const QByteArray &path);
+    void evictLocked();
+    void applyQueuedLocked();
+    void scheduleFlushLocked();
+    void flushQueued();
+    static QByteArray readJournalGeneration(QFile *journal);
+    static QString cacheDir();
+    static QString cacheFilePath();
+    static QString journalFilePath();
+
+    QMutex mutex;
+    QHash<QByteArray, Entry> entries;
+    qint64 journalOffset { 0 };
+    QByteArray journalGeneration;
+    QSet<QString> queuedInvalidations;   ///< 尚未写入失效日志的路径
+    bool flushScheduled { false };
+    bool loaded { false };
+    bool modified { false };
+    Q_DISABLE_COPY(DirSizeCache)
+};
+
+}   // namespace dfmbase
+
+#endif   // DIRSIZECACHE_H
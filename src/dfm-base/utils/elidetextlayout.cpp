@@ -10,6 +10,8 @@
 #include <QTextDocument>
 #include <QTextLayout>
 #include <QTextBlock>
+#include <QCache>
+#include <QSharedPointer>
 #include <QDebug>
 
 #include <cmath>
@@ -18,6 +20,99 @@
 
 using namespace dfmbase;
 
+namespace dfmbase {
+
+struct ElideTextLayoutCacheLine
+{
+    QRectF rect;   // 相对于排版区域左上角
+    QString text;
+    QList<QTextLayout::FormatRange> formats;
+    QSharedPointer<QTextLayout> layout;   // 首次绘制时创建
+};
+
+struct ElideTextLayoutCacheEntry
+{
+    QList<QRectF> rects;
+    QStringList textLines;
+    QList<ElideTextLayoutCacheLine> lines;
+    QFont font;
+    QTextOption option;
+};
+
+class ElideTextLayoutCachePrivate
+{
+public:
+    QCache<QString, ElideTextLayoutCacheEntry> entries;
+};
+
+}   // namespace dfmbase
+
+namespace {
+
+// 将与当前行重叠的关键词匹配区域转换为该行内的高亮格式
+QList<QTextLayout::FormatRange> highlightFormatsOfLine(int lineStartPos, int lineLength,
+                                                       const QList<QPair<int, int>> &allMatches,
+                                                       const QColor &color)
+{
+    QList<QTextLayout::FormatRange> formats;
+    int lineEnd = lineStartPos + lineLength;
+    for (const auto &match : allMatches) {
+        int matchStart = match.first;
+        int matchEnd = matchStart + match.second;
+        if (matchEnd <= lineStartPos || matchStart >= lineEnd)
+            continue;
+        int highlightStart = qMax(matchStart, lineStartPos) - lineStartPos;
+        int highlightEnd = qMin(matchEnd, lineEnd) - lineStartPos;
+        int highlightLength = highlightEnd - highlightStart;
+        if (highlightLength <= 0)
+            continue;
+        QTextLayout::FormatRange range;
+        range.start = highlightStart;
+        range.length = highlightLength;
+        range.format.setForeground(color);
+        formats.append(range);
+    }
+    return formats;
+}
+
+void drawCachedLine(QPainter *painter, ElideTextLayoutCacheLine *line, const QFont &font,
+                    const QTextOption &option, const QPointF &origin)
+{
+    if (!line->layout) {
+        // 与 drawTextWithHighlight 一致：单行不换行布局，放置在该行的自然文本区域
+        auto lay = QSharedPointer<QTextLayout>::create(line->text, font);
+        lay->setTextOption(option);
+        lay->setFormats(line->formats);
+        lay->beginLayout();
+        QTextLine textLine = lay->createLine();
+        if (textLine.isValid()) {
+            textLine.setLineWidth(line->rect.width());
+            textLine.setPosition(line->rect.topLeft());
+        }
+        lay->endLayout();
+        line->layout = lay;
+    }
+
+    line->layout->draw(painter, origin);
+}
+
+}   // namespace
+
+ElideTextLayoutCache::ElideTextLayoutCache(int maxEntries)
+    : d(new ElideTextLayoutCachePrivate)
+{
+    d->entries.setMaxCost(qMax(1, maxEntries));
+}
+
+ElideTextLayoutCache::~ElideTextLayoutCache()
+{
+}
+
+void ElideTextLayoutCache::clear()
+{
+    d->entries.clear();
+}
+
 ElideTextLayout::ElideTextLayout(const QString &text)
     : document(new QTextDocument)
 {
@@ -318,6 +413,84 @@ QList<QPair<int, int>> ElideTextLayout::calculateElideHighlightMatches(
 }
 
 QList<QRectF> ElideTextLayout::layout(const QRectF &rect, Qt::TextElideMode elideMode, QPainter *painter, const QBrush &background, QStringList *textLines)
+{
+    if (canUseLayoutCache())
+        return layoutWithCache(rect, elideMode, painter, background, textLines);
+
+    return layoutLines(rect, elideMode, painter, background, textLines, nullptr);
+}
+
+bool ElideTextLayout::canUseLayoutCache() const
+{
+    if (!layoutCache || !document || document->blockCount() != 1)
+        return false;
+
+    // 含有对象（标记等）或额外字符格式的文本，其绘制结果不只由纯文本决定，不做缓存
+    const QTextBlock block = document->firstBlock();
+    return block.textFormats().size() <= 1
+            && !block.text().contains(QChar::ObjectReplacementCharacter);
+}
+
+QString ElideTextLayout::layoutCacheKey(const QSizeF &size, Qt::TextElideMode elideMode) const
+{
+    const bool highlight = enableHighlight && highlightColor.isValid() && !highlightKeywords.isEmpty();
+    const QStringList parts {
+        text(),
+        attribute<QFont>(kFont).key(),
+        QString::number(size.width()),
+        QString::number(size.height()),
+        QString::number(attribute<int>(kLineHeight)),
+        QString::number(attribute<uint>(kAlignment)),
+        QString::number(attribute<uint>(kWrapMode)),
+        QString::number(static_cast<int>(attribute<Qt::LayoutDirection>(kTextDirection))),
+        QString::number(static_cast<int>(elideMode)),
+        highlight ? highlightColor.name(QColor::HexArgb) : QString(),
+        highlight ? highlightKeywords.join(QChar(0)) : QString()
+    };
+    return parts.join(QChar(0x1f));
+}
+
+QList<QRectF> ElideTextLayout::layoutWithCache(const QRectF &rect, Qt::TextElideMode elideMode, QPainter *painter, const QBrush &background, QStringList *textLines)
+{
+    auto &entries = layoutCache->d->entries;
+    const QString key = layoutCacheKey(rect.size(), elideMode);
+
+    ElideTextLayoutCacheEntry *entry = entries.object(key);
+    if (!entry) {
+        // 在原点处排版一次并记录每一行，之后按实际位置平移复用
+        entry = new ElideTextLayoutCacheEntry;
+        entry->font = attribute<QFont>(kFont);
+        entry->option.setAlignment((Qt::Alignment)attribute<uint>(kAlignment));
+        entry->option.setWrapMode(QTextOption::NoWrap);
+        entry->option.setTextDirection(attribute<Qt::LayoutDirection>(kTextDirection));
+        entry->rects = layoutLines(QRectF(QPointF(0, 0), rect.size()), elideMode, nullptr, Qt::NoBrush,
+                                   &entry->textLines, &entry->lines);
+        entries.insert(key, entry);
+    }
+
+    const QPointF origin = rect.topLeft();
+    QList<QRectF> ret;
+    ret.reserve(entry->rects.size());
+    for (const QRectF &lineRect : entry->rects)
+        ret.append(lineRect.translated(origin));
+
+    if (textLines)
+        textLines->append(entry->textLines);
+
+    if (painter) {
+        QRectF lastLineRect;
+        for (ElideTextLayoutCacheLine &line : entry->lines) {
+            if (background.style() != Qt::NoBrush)
+                lastLineRect = drawLineBackground(painter, line.rect.translated(origin), lastLineRect, background);
+            drawCachedLine(painter, &line, entry->font, entry->option, origin);
+        }
+    }
+
+    return ret;
+}
+
+QList<QRectF> ElideTextLayout::layoutLines(const QRectF &rect, Qt::TextElideMode elideMode, QPainter *painter, const QBrush &background,
+                                           QStringList *textLines, QList<ElideTextLayoutCacheLine> *recordedLines)
 {
     QList<QRectF> ret;
     QTextLayout *lay = document->firstBlock().layout();
@@ -354,7 +527,7 @@ QList<QRectF> ElideTextLayout::layout(const QRectF &rect, Qt::TextElideMode elid
     QList<QPair<int, int>> currentMatches = allMatches;
 
     auto processLine = [this, &ret, painter, &lastLineRect, background, textLineHeight, &curText, textLines,
-                        paintLineWithHighlight, &currentMatches](QTextLine &line) {
+                        recordedLines, paintLineWithHighlight, &currentMatches](QTextLine &line) {
         QRectF lRect = line.naturalTextRect();
         // Fix clipping on fractional scaling: keep the line rect large enough for
         // Qt's actual text layout metrics instead of truncating to the logical line height.
@@ -366,6 +539,16 @@ QList<QRectF> ElideTextLayout::layout(const QRectF &rect, Qt::TextElideMode elid
             textLines->append(t);
         }
 
+        // 记录绘制该行所需的内容，供排版缓存使用
+        if (recordedLines) {
+            ElideTextLayoutCacheLine recorded;
+            recorded.rect = lRect;
+            recorded.text = curText.mid(line.textStart(), line.textLength());
+            if (paintLineWithHighlight)
+                recorded.formats = highlightFormatsOfLine(line.textStart(), recorded.text.length(), currentMatches, highlightColor);
+            recordedLines->append(recorded);
+        }
+
         // draw
         if (painter) {
             // draw background
@@ -575,25 +758,7 @@ void ElideTextLayout::drawTextWithHighlight(QPainter *painter, const QTextLine &
     opt.setTextDirection(attribute<Qt::LayoutDirection>(kTextDirection));
     tempLayout.setTextOption(opt);
 
-    QList<QTextLayout::FormatRange> formats;
-    int lineEnd = lineStartPos + lineText.length();
-    for (const auto &match : allMatches) {
-        int matchStart = match.first;
-        int matchEnd = matchStart + match.second;
-        if (matchEnd <= lineStartPos || matchStart >= lineEnd)
-            continue;
-        int highlightStart = qMax(matchStart, lineStartPos) - lineStartPos;
-        int highlightEnd = qMin(matchEnd, lineEnd) - lineStartPos;
-        int highlightLength = highlightEnd - highlightStart;
-        if (highlightLength <= 0)
-            continue;
-        QTextLayout::FormatRange range;
-        range.start = highlightStart;
-        range.length = highlightLength;
-        range.format.setForeground(highlightColor);
-        formats.append(range);
-    }
-    tempLayout.setFormats(formats);
+    tempLayout.setFormats(highlightFormatsOfLine(lineStartPos, lineText.length(), allMatches, highlightColor));
 
     tempLayout.beginLayout();
     QTextLine tempLine = tempLayout.createLine();
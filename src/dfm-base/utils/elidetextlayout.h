@@ -9,6 +9,7 @@
 #include <QBrush>
 #include <QVariant>
 #include <QTextLine>
+#include <QScopedPointer>
 
 class QPainter;
 class QTextDocument;
@@ -16,6 +17,31 @@ class QTextLayout;
 
 namespace dfmbase {
 
+struct ElideTextLayoutCacheLine;
+class ElideTextLayoutCachePrivate;
+
+/**
+ * @brief ElideTextLayout 的排版结果缓存
+ *
+ * 以文本、字体、区域大小、省略模式及高亮关键字为键，保存排版后的行及其绘制用的 QTextLayout，
+ * 命中时不再进行文本塑形和省略计算。只缓存纯文本，含有对象（标记等）的文本仍每次排版。
+ * 缓存有容量上限，按最近使用淘汰；字体、缩放等变化时由使用方调用 clear()。
+ * 非线程安全，只应在绘制线程中使用。
+ */
+class ElideTextLayoutCache
+{
+public:
+    explicit ElideTextLayoutCache(int maxEntries = 1024);
+    ~ElideTextLayoutCache();
+
+    void clear();
+
+private:
+    friend class ElideTextLayout;
+    QScopedPointer<ElideTextLayoutCachePrivate> d;
+    Q_DISABLE_COPY(ElideTextLayoutCache)
+};
+
 class ElideTextLayout
 {
 public:
@@ -62,6 +88,11 @@ public:
         enableHighlight = enable;
     }
 
+    // 设置排版缓存，缓存由调用方持有，需长于本对象的使用期
+    inline void setLayoutCache(ElideTextLayoutCache *cache) {
+        layoutCache = cache;
+    }
+
 protected:
     QRectF drawLineBackground(QPainter *painter, const QRectF &curLineRect, QRectF lastLineRect, const QBrush &brush) const;
     void drawTextWithHighlight(QPainter *painter, const QTextLine &line, const QString &lineText, 
@@ -69,6 +100,13 @@ protected:
     virtual void initLayoutOption(QTextLayout *lay);
 
 private:
+    QList<QRectF> layoutLines(const QRectF &rect, Qt::TextElideMode elideMode, QPainter *painter, const QBrush &background,
+                              QStringList *textLines, QList<ElideTextLayoutCacheLine> *recordedLines);
+    QList<QRectF> layoutWithCache(const QRectF &rect, Qt::TextElideMode elideMode, QPainter *painter, const QBrush &background,
+                                  QStringList *textLines);
+    bool canUseLayoutCache() const;
+    QString layoutCacheKey(const QSizeF &size, Qt::TextElideMode elideMode) const;
+
     // 查找文本中所有关键词匹配的位置
     QList<QPair<int, int>> findKeywordMatches(const QString &text) const;
 
@@ -97,6 +135,7 @@ protected:
     QStringList highlightKeywords {};  // 需要高亮的关键字
     QColor highlightColor { QColor() };     // 高亮颜色
     bool enableHighlight { false };      // 是否启用高亮
+    ElideTextLayoutCache *layoutCache { nullptr };
 };
 }
 
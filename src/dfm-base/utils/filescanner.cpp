@@ -9,17 +9,30 @@
 #include <dfm-base/interfaces/abstractdiriterator.h>
 #include <dfm-base/utils/universalutils.h>
 #include <dfm-base/utils/fileutils.h>
+#include <dfm-base/utils/dirsizecache.h>
 
 #include <QTimer>
 #include <QCoreApplication>
 #include <QDebug>
 #include <QDir>
 #include <QQueue>
+#include <QFile>
+#include <QMutex>
+#include <QSemaphore>
+#include <QSharedPointer>
+#include <QThreadPool>
+#include <QWaitCondition>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
 
 #include <dirent.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <sys/stat.h>
+#include <sys/sysmacros.h>
 
 DFMBASE_USE_NAMESPACE
 
@@ -69,12 +82,29 @@ public:
         bool statOk { false };
     };
 
+    // UseSizeCache 模式下的目录汇总节点：子目录全部完成后写入缓存并累加到父节点
+    struct DirNode
+    {
+        std::shared_ptr<DirNode> parent;
+        QByteArray path;
+        struct stat statBuf;
+        std::atomic<int> pending { 1 };   // 自身 + 尚未完成的子目录
+        std::atomic<qint64> totalSize { 0 };
+        std::atomic<qint64> progressSize { 0 };
+        std::atomic<int> fileCount { 0 };
+        std::atomic<int> directoryCount { 0 };
+        // 子树含 st_nlink > 1 的文件：其大小是否计入取决于扫描顺序，不能写入缓存
+        std::atomic<bool> hasHardLinks { false };
+    };
+
     // 扫描上下文结构
     struct ScanContext
     {
         QByteArray fullPath;
+        quint64 device { 0 };   // 所在设备号，用于并行扫描时按设备限流
         int depth { 0 };
         bool isSourcePath { false };
+        std::shared_ptr<DirNode> node;   // 仅 UseSizeCache 模式下有效
     };
 
     // 核心扫描方法
@@ -85,9 +115,16 @@ public:
             const QStringList &manualExcludePaths = {});
 
 private:
+    class InodeRegistry;
+    class DeviceThrottle;
+    class ParallelScanQueue;
+
     // 扫描状态（在扫描过程中维护）
     struct ScanState
     {
+        ScanState();
+        ~ScanState();
+
         FileScanner::ScanResult result;
         FileScanner::ScanOptions options;
         ProgressCallback progressCallback;
@@ -97,21 +134,40 @@ private:
         qint64 lastEmittedSize { 0 };
         qint64 memoryPageSize { 4096 };
 
-        // inode 去重
-        QHash<quint64, QSet<quint64>> processedInodes;
+        // 已处理的源目录数量（用于最终扣除）
+        int processedSourceDirs { 0 };
+
+        // inode 去重（并行扫描时各分片指向同一个共享表）
+        QScopedPointer<InodeRegistry> ownInodes;
+        InodeRegistry *inodes { nullptr };
 
         // 排除路径集合（规范化后的 UTF-8 QByteArray，精确匹配）
         QSet<QByteArray> excludePathSet;
 
+        // 并行扫描：按设备限制目录读取并发，以及分片共享的停止标志
+        DeviceThrottle *throttle { nullptr };
+        const std::atomic<bool> *sharedStop { nullptr };
+
+        // 是否读写目录大小缓存
+        bool useSizeCache { false };
+
         // 停止标志（用于回调返回 false 时停止）
         bool shouldStop { false };
     };
 
     // 核心扫描逻辑
     static void scanLocalPathsImpl(ScanState &state, const QList<QUrl> &urls);
+    static void scanLocalDirsParallel(ScanState &state, const QList<ScanContext> &roots);
     static void scanOtherProtocolsImpl(ScanState &state, const QList<QUrl> &urls);
+    static void processDirectory(ScanState &state, const ScanContext &ctx, QList<ScanContext> *subDirs);
+    static void scanDirectoryEntries(ScanState &state, const ScanContext &ctx, QList<ScanContext> *subDirs);
+    static bool applyCachedSubtree(ScanState &state, const QByteArray &path, const struct stat &statBuf);
+    static std::shared_ptr<DirNode> createNode(const std::shared_ptr<DirNode> &parent,
+                                               const QByteArray &path, const struct stat &statBuf);
+    static void completeNode(std::shared_ptr<DirNode> node);
 
     // 辅助方法
+    static bool isStopped(const ScanState &state);
     static qint64 progressDeltaForFileSize(const ScanState &state, qint64 fileSize);
     static bool tryScanOtherProtocolCountOnlyByLocalPath(
             ScanState &state,
@@ -126,9 +182,202 @@ private:
     static void collectFileIfEnabled(ScanState &state, const QUrl &url, bool isSourcePath);
     static void emitProgress(ScanState &state, bool force = false);
     static bool isInodeProcessed(const ScanState &state, quint64 device, quint64 inode);
-    static void markInodeProcessed(ScanState &state, quint64 device, quint64 inode);
+    static bool markInodeProcessed(ScanState &state, quint64 device, quint64 inode);
 };
 
+//===================================================================
+// FileScannerCore::InodeRegistry - 硬链接去重表
+//===================================================================
+// 按 inode 分段加锁，并行分片同时统计硬链接时仍只计入一次大小
+class FileScannerCore::InodeRegistry
+{
+public:
+    bool contains(quint64 device, quint64 inode) const
+    {
+        const Shard &shard = shards[shardOf(inode)];
+        QMutexLocker locker(&shard.mutex);
+        return shard.inodes.value(device).contains(inode);
+    }
+
+    // 返回 true 表示首次登记
+    bool testAndMark(quint64 device, quint64 inode)
+    {
+        Shard &shard = shards[shardOf(inode)];
+        QMutexLocker locker(&shard.mutex);
+        QSet<quint64> &set = shard.inodes[device];
+        if (set.contains(inode))
+            return false;
+        set.insert(inode);
+        return true;
+    }
+
+private:
+    static constexpr int kShardCount = 16;
+    static int shardOf(quint64 inode) { return static_cast<int>(inode % kShardCount); }
+
+    struct Shard
+    {
+        mutable QMutex mutex;
+        QHash<quint64, QSet<quint64>> inodes;
+    };
+    Shard shards[kShardCount];
+};
+
+//===================================================================
+// FileScannerCore::DeviceThrottle - 按设备限制目录读取并发
+//===================================================================
+// 机械盘并发寻道只会互相拖慢，因此只允许一个线程读取；
+// 固态盘放开到工作线程数；无法识别的设备（tmpfs、网络/FUSE 等）取折中值
+class FileScannerCore::DeviceThrottle
+{
+public:
+    explicit DeviceThrottle(int maxPerDevice)
+        : maxPerDevice(qMax(1, maxPerDevice))
+    {
+    }
+
+    QSemaphore *slotFor(quint64 device)
+    {
+        QMutexLocker locker(&mutex);
+        auto it = deviceSlots.find(device);
+        if (it == deviceSlots.end()) {
+            const int limit = limitFor(device);
+            qCDebug(logDFMBase) << "FileScannerCore: device" << device << "concurrency limit" << limit;
+            it = deviceSlots.insert(device, QSharedPointer<QSemaphore>::create(limit));
+        }
+        return it.value().data();
+    }
+
+private:
+    int limitFor(quint64 device) const
+    {
+        const unsigned int devMajor = major(device);
+        const unsigned int devMinor = minor(device);
+        if (devMajor == 0)
+            return qMin(maxPerDevice, 4);
+
+        // 分区没有 queue 目录，需要回退到所属的整块磁盘
+        const QString base = QString("/sys/dev/block/%1:%2").arg(devMajor).arg(devMinor);
+        for (const QString &path : { base + "/queue/rotational", base + "/../queue/rotational" }) {
+            QFile file(path);
+            if (file.open(QIODevice::ReadOnly))
+                return file.read(1) == "1" ? 1 : maxPerDevice;
+        }
+        return qMin(maxPerDevice, 4);
+    }
+
+    const int maxPerDevice;
+    QMutex mutex;
+    QHash<quint64, QSharedPointer<QSemaphore>> deviceSlots;
+};
+
+//===================================================================
+// FileScannerCore::ParallelScanQueue - 工作窃取目录队列
+//===================================================================
+// 每个工作线程从自己队列的尾部取（深度优先，局部性好），
+// 空闲时从其他队列的头部窃取（靠近根的大子树），pending 归零时全部退出
+class FileScannerCore::ParallelScanQueue
+{
+public:
+    explicit ParallelScanQueue(int workerCount)
+    {
+        for (int i = 0; i < workerCount; ++i)
+            lanes.emplace_back(new Lane);
+    }
+
+    void push(int worker, ScanContext &&ctx)
+    {
+        pending.fetch_add(1);
+        Lane &lane = *lanes[static_cast<size_t>(worker) % lanes.size()];
+        {
+            QMutexLocker locker(&lane.mutex);
+            lane.items.push_back(std::move(ctx));
+        }
+        idleCondition.wakeOne();
+    }
+
+    bool pop(int worker, ScanContext *ctx)
+    {
+        while (true) {
+            if (aborted.load())
+                return false;
+            if (tryTake(worker, ctx))
+                return true;
+            if (pending.load() == 0)
+                return false;
+
+            // 有目录正在被其他线程处理，稍后可能产生新任务；超时兜底避免丢失唤醒
+            QMutexLocker locker(&idleMutex);
+            if (pending.load() == 0 || aborted.load())
+                return false;
+            idleCondition.wait(&idleMutex, 10);
+        }
+    }
+
+    // 一个目录处理完毕（其子目录须在此之前 push）
+    void taskDone()
+    {
+        if (pending.fetch_sub(1) == 1) {
+            QMutexLocker locker(&idleMutex);
+            idleCondition.wakeAll();
+        }
+    }
+
+    void abort()
+    {
+        aborted.store(true);
+        QMutexLocker locker(&idleMutex);
+        idleCondition.wakeAll();
+    }
+
+private:
+    bool tryTake(int worker, ScanContext *ctx)
+    {
+        const size_t count = lanes.size();
+        const size_t self = static_cast<size_t>(worker) % count;
+        {
+            Lane &own = *lanes[self];
+            QMutexLocker locker(&own.mutex);
+            if (!own.items.empty()) {
+                *ctx = std::move(own.items.back());
+                own.items.pop_back();
+                return true;
+            }
+        }
+        for (size_t i = 1; i < count; ++i) {
+            Lane &victim = *lanes[(self + i) % count];
+            QMutexLocker locker(&victim.mutex);
+            if (!victim.items.empty()) {
+                *ctx = std::move(victim.items.front());
+                victim.items.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    struct Lane
+    {
+        QMutex mutex;
+        std::deque<ScanContext> items;
+    };
+
+    std::vector<std::unique_ptr<Lane>> lanes;
+    std::atomic<int> pending { 0 };
+    std::atomic<bool> aborted { false };
+    QMutex idleMutex;
+    QWaitCondition idleCondition;
+};
+
+FileScannerCore::ScanState::ScanState()
+    : ownInodes(new InodeRegistry), inodes(ownInodes.data())
+{
+}
+
+FileScannerCore::ScanState::~ScanState()
+{
+}
+
 //===================================================================
 // FileScannerPrivate - 私有实现
 //===================================================================
@@ -368,7 +617,19 @@ FileScanner::ScanResult FileScannerCore::scanImpl(
 
     // 判断是否为本地文件路径
     if (!urls.isEmpty() && urls.first().scheme() == Global::Scheme::kFile) {
+        // 缓存的是完整子树的大小，计数、单层、收集文件或带排除路径的扫描都不适用
+        state.useSizeCache = (options & FileScanner::ScanOption::UseSizeCache)
+                && !(options & (FileScanner::ScanOption::CountOnly
+                                | FileScanner::ScanOption::SingleDepth
+                                | FileScanner::ScanOption::CollectFiles))
+                && state.excludePathSet.isEmpty();
+        if (state.useSizeCache)
+            DirSizeCache::instance()->syncJournal();
+
         scanLocalPathsImpl(state, urls);
+
+        if (state.useSizeCache)
+            DirSizeCache::instance()->save();
     } else {
         scanOtherProtocolsImpl(state, urls);
     }
@@ -376,6 +637,11 @@ FileScanner::ScanResult FileScannerCore::scanImpl(
     return state.result;
 }
 
+bool FileScannerCore::isStopped(const ScanState &state)
+{
+    return state.shouldStop || (state.sharedStop && state.sharedStop->load(std::memory_order_relaxed));
+}
+
 qint64 FileScannerCore::progressDeltaForFileSize(const ScanState &state, qint64 fileSize)
 {
     return fileSize <= 0 ? state.memoryPageSize : fileSize;
@@ -386,8 +652,7 @@ void FileScannerCore::scanLocalPathsImpl(ScanState &state, const QList<QUrl> &ur
     qCDebug(logDFMBase) << "FileScannerCore: Scanning local paths using opendir/readdir";
 
     // ========== 初始化阶段 ==========
-    int processedSourceDirs = 0;
-    QStack<ScanContext> dirStack;
+    QList<ScanContext> sourceDirs;
 
     // 准备源路径
     for (const QUrl &url : urls) {
@@ -403,9 +668,23 @@ void FileScannerCore::scanLocalPathsImpl(ScanState &state, const QList<QUrl> &ur
                 }
                 ScanContext ctx;
                 ctx.fullPath = path;
+                ctx.device = statBuf.st_dev;
                 ctx.depth = 0;
                 ctx.isSourcePath = true;
-                dirStack.push(ctx);
+                if (state.useSizeCache) {
+                    // 指向目录的符号链接以目标目录作为缓存键
+                    struct stat dirStat = statBuf;
+                    if (S_ISLNK(statBuf.st_mode))
+                        stat(path.constData(), &dirStat);
+                    const QByteArray key = normalizePath(path);
+                    if (applyCachedSubtree(state, key, dirStat)) {
+                        state.processedSourceDirs++;
+                        collectFileIfEnabled(state, url, true);
+                        continue;
+                    }
+                    ctx.node = createNode(nullptr, key, dirStat);
+                }
+                sourceDirs.append(ctx);
                 // 收集源目录URL（如果启用 CollectFiles 选项）
                 collectFileIfEnabled(state, url, true);
             } else {
@@ -428,130 +707,339 @@ void FileScannerCore::scanLocalPathsImpl(ScanState &state, const QList<QUrl> &ur
     }
 
     // ========== 遍历阶段 ==========
-    while (!dirStack.isEmpty() && !state.shouldStop) {
-        ScanContext ctx = dirStack.pop();
-        const QByteArray &dirPath = ctx.fullPath;
+    const bool parallel = (state.options & FileScanner::ScanOption::Parallel)
+            && !(state.options & FileScanner::ScanOption::SingleDepth);
+    if (parallel && !sourceDirs.isEmpty()) {
+        scanLocalDirsParallel(state, sourceDirs);
+    } else {
+        QStack<ScanContext> dirStack;
+        for (const ScanContext &ctx : sourceDirs)
+            dirStack.push(ctx);
+
+        QList<ScanContext> subDirs;
+        while (!dirStack.isEmpty() && !state.shouldStop) {
+            subDirs.clear();
+            processDirectory(state, dirStack.pop(), &subDirs);
+            for (const ScanContext &child : subDirs)
+                dirStack.push(child);
+        }
+    }
 
-        // 先计数目录本身（无论是否能读取内容）
-        state.result.directoryCount++;
-        state.result.progressSize += state.memoryPageSize;
+    // ========== 最终处理 ==========
+    // 默认排除源目录本身
+    if (!(state.options & FileScanner::ScanOption::IncludeSource)) {
+        state.result.directoryCount -= state.processedSourceDirs;
+    }
 
-        // 记录成功处理的源目录（用于最终扣除）
-        if (ctx.isSourcePath) {
-            processedSourceDirs++;
-        }
+    qCDebug(logDFMBase) << "FileScannerCore: Local scan completed - files:" << state.result.fileCount
+                        << "dirs:" << state.result.directoryCount << "size:" << state.result.totalSize;
+}
 
-        // 读取目录内容
-        QList<DirEntry> entries;
-        bool countOnly = state.options & FileScanner::ScanOption::CountOnly;
-        bool readSuccess = readDirectoryEntries(dirPath, &entries, countOnly);
+void FileScannerCore::processDirectory(ScanState &state, const ScanContext &ctx, QList<ScanContext> *subDirs)
+{
+    Q_ASSERT(subDirs);
+    if (!ctx.node) {
+        scanDirectoryEntries(state, ctx, subDirs);
+        return;
+    }
 
-        if (!readSuccess) {
-            // 目录读取失败（权限不足），但目录已计数
-            qCWarning(logDFMBase) << "FileScannerCore: Failed to read directory contents:" << dirPath;
-            continue;
-        }
+    // 以统计前后的差值作为本目录直接贡献（含直接命中缓存的子目录）
+    const qint64 totalSize = state.result.totalSize;
+    const qint64 progressSize = state.result.progressSize;
+    const int fileCount = state.result.fileCount;
+    const int directoryCount = state.result.directoryCount;
 
-        // 处理每个条目
-        for (const DirEntry &entry : entries) {
-            if (state.shouldStop) {
-                break;
-            }
+    scanDirectoryEntries(state, ctx, subDirs);
 
-            const QByteArray entryPath = joinPath(dirPath, entry.name);
-            const QUrl entryUrl = QUrl::fromLocalFile(QString::fromUtf8(entryPath));
+    // 被中断的目录统计不完整，不能写入缓存
+    if (isStopped(state))
+        return;
 
-            if (countOnly) {
-                // CountOnly 模式：直接用 d_type 计数，无需 stat
-                if (entry.d_type == DT_DIR) {
-                    if (state.excludePathSet.contains(normalizePath(entryPath))) {
-                        qCDebug(logDFMBase) << "FileScannerCore: Skipping excluded path:" << entryPath;
-                        continue;
-                    }
-                    bool isSingleDepth = state.options & FileScanner::ScanOption::SingleDepth;
-                    if (isSingleDepth) {
-                        state.result.directoryCount++;
-                    } else {
-                        ScanContext childCtx;
-                        childCtx.fullPath = entryPath;
-                        childCtx.depth = ctx.depth + 1;
-                        childCtx.isSourcePath = false;
-                        dirStack.push(childCtx);
-                    }
-                } else {
-                    // 普通文件、符号链接、其他类型统一计数
-                    state.result.fileCount++;
-                }
-                collectFileIfEnabled(state, entryUrl, false);
-                emitProgress(state);
-                continue;
-            }
+    ctx.node->totalSize += state.result.totalSize - totalSize;
+    ctx.node->progressSize += state.result.progressSize - progressSize;
+    ctx.node->fileCount += state.result.fileCount - fileCount;
+    ctx.node->directoryCount += state.result.directoryCount - directoryCount;
+    completeNode(ctx.node);
+}
 
-            // 跳过特殊系统文件
-            if (entry.statOk && S_ISREG(entry.statBuf.st_mode)) {
-                static const QSet<QByteArray> kSpecialSystemFiles {
-                    "/proc/kcore",
-                    "/dev/core"
-                };
-                if (kSpecialSystemFiles.contains(entryPath)) {
-                    qCDebug(logDFMBase) << "FileScannerCore: Skipping special file:" << entryPath;
-                    continue;
-                }
-            }
+void FileScannerCore::scanDirectoryEntries(ScanState &state, const ScanContext &ctx, QList<ScanContext> *subDirs)
+{
+    const QByteArray &dirPath = ctx.fullPath;
 
-            // 失败处理
-            if (!entry.statOk) {
-                qCWarning(logDFMBase) << "FileScannerCore: stat failed for:" << entryPath;
-                continue;
-            }
+    // 先计数目录本身（无论是否能读取内容）
+    state.result.directoryCount++;
+    state.result.progressSize += state.memoryPageSize;
+
+    // 记录成功处理的源目录（用于最终扣除）
+    if (ctx.isSourcePath) {
+        state.processedSourceDirs++;
+    }
 
-            // 根据类型处理条目
-            if (S_ISDIR(entry.statBuf.st_mode)) {
-                // 子目录
+    // 读取目录内容（并行模式下受所在设备的并发限制）
+    QList<DirEntry> entries;
+    bool countOnly = state.options & FileScanner::ScanOption::CountOnly;
+    bool readSuccess = false;
+    {
+        QSemaphore *slot = state.throttle ? state.throttle->slotFor(ctx.device) : nullptr;
+        if (slot)
+            slot->acquire();
+        QSemaphoreReleaser releaser(slot);
+        readSuccess = readDirectoryEntries(dirPath, &entries, countOnly);
+    }
+
+    if (!readSuccess) {
+        // 目录读取失败（权限不足），但目录已计数
+        qCWarning(logDFMBase) << "FileScannerCore: Failed to read directory contents:" << dirPath;
+        return;
+    }
+
+    // 处理每个条目
+    for (const DirEntry &entry : entries) {
+        if (isStopped(state)) {
+            break;
+        }
+
+        const QByteArray entryPath = joinPath(dirPath, entry.name);
+        const QUrl entryUrl = QUrl::fromLocalFile(QString::fromUtf8(entryPath));
+
+        if (countOnly) {
+            // CountOnly 模式：直接用 d_type 计数，无需 stat
+            if (entry.d_type == DT_DIR) {
                 if (state.excludePathSet.contains(normalizePath(entryPath))) {
                     qCDebug(logDFMBase) << "FileScannerCore: Skipping excluded path:" << entryPath;
                     continue;
                 }
                 bool isSingleDepth = state.options & FileScanner::ScanOption::SingleDepth;
                 if (isSingleDepth) {
-                    // SingleDepth 模式：计数但不递归
                     state.result.directoryCount++;
-                    state.result.progressSize += state.memoryPageSize;
                 } else {
-                    // 递归模式：压栈
+                    // 无 stat 信息，沿用父目录设备号（跨挂载点时仅影响限流归属）
                     ScanContext childCtx;
                     childCtx.fullPath = entryPath;
+                    childCtx.device = ctx.device;
                     childCtx.depth = ctx.depth + 1;
                     childCtx.isSourcePath = false;
-                    dirStack.push(childCtx);
+                    subDirs->append(childCtx);
                 }
-            } else if (S_ISREG(entry.statBuf.st_mode)) {
-                // 常规文件
-                processRegularFile(state, entryPath, entry.statBuf);
-            } else if (S_ISLNK(entry.statBuf.st_mode)) {
-                // 符号链接
-                processSymlink(state, entryPath);
             } else {
-                // 其他特殊文件类型
+                // 普通文件、符号链接、其他类型统一计数
                 state.result.fileCount++;
             }
-
-            // 收集文件URL
             collectFileIfEnabled(state, entryUrl, false);
-
-            // 定期发送进度
             emitProgress(state);
+            continue;
         }
+
+        // 跳过特殊系统文件
+        if (entry.statOk && S_ISREG(entry.statBuf.st_mode)) {
+            static const QSet<QByteArray> kSpecialSystemFiles {
+                "/proc/kcore",
+                "/dev/core"
+            };
+            if (kSpecialSystemFiles.contains(entryPath)) {
+                qCDebug(logDFMBase) << "FileScannerCore: Skipping special file:" << entryPath;
+                continue;
+            }
+        }
+
+        // 失败处理
+        if (!entry.statOk) {
+            qCWarning(logDFMBase) << "FileScannerCore: stat failed for:" << entryPath;
+            continue;
+        }
+
+        // 根据类型处理条目
+        if (S_ISDIR(entry.statBuf.st_mode)) {
+            // 子目录
+            if (state.excludePathSet.contains(normalizePath(entryPath))) {
+                qCDebug(logDFMBase) << "FileScannerCore: Skipping excluded path:" << entryPath;
+                continue;
+            }
+            bool isSingleDepth = state.options & FileScanner::ScanOption::SingleDepth;
+            if (isSingleDepth) {
+                // SingleDepth 模式：计数但不递归
+                state.result.directoryCount++;
+                state.result.progressSize += state.memoryPageSize;
+            } else if (ctx.node && applyCachedSubtree(state, entryPath, entry.statBuf)) {
+                // 子树未变化：直接复用缓存统计，不再下降
+            } else {
+                // 递归模式：交给调用方入栈/入队
+                ScanContext childCtx;
+                childCtx.fullPath = entryPath;
+                childCtx.device = entry.statBuf.st_dev;
+                childCtx.depth = ctx.depth + 1;
+                childCtx.isSourcePath = false;
+                if (ctx.node) {
+                    ctx.node->pending++;
+                    childCtx.node = createNode(ctx.node, entryPath, entry.statBuf);
+                }
+                subDirs->append(childCtx);
+            }
+        } else if (S_ISREG(entry.statBuf.st_mode)) {
+            // 常规文件
+            if (ctx.node && entry.statBuf.st_nlink > 1)
+                ctx.node->hasHardLinks = true;
+            processRegularFile(state, entryPath, entry.statBuf);
+        } else if (S_ISLNK(entry.statBuf.st_mode)) {
+            // 符号链接
+            processSymlink(state, entryPath);
+        } else {
+            // 其他特殊文件类型
+            state.result.fileCount++;
+        }
+
+        // 收集文件URL
+        collectFileIfEnabled(state, entryUrl, false);
+
+        // 定期发送进度
+        emitProgress(state);
     }
+}
 
-    // ========== 最终处理 ==========
-    // 默认排除源目录本身
-    if (!(state.options & FileScanner::ScanOption::IncludeSource)) {
-        state.result.directoryCount -= processedSourceDirs;
+void FileScannerCore::scanLocalDirsParallel(ScanState &state, const QList<ScanContext> &roots)
+{
+    const int workerCount = qBound(1, QThread::idealThreadCount(), 16);
+    qCDebug(logDFMBase) << "FileScannerCore: Parallel scan with" << workerCount << "workers";
+
+    // 每个工作线程持有独立的统计分片，只共享 inode 表、设备限流和停止标志
+    struct Shard
+    {
+        ScanState state;
+        std::atomic<qint64> totalSize { 0 };
+        std::atomic<qint64> progressSize { 0 };
+        std::atomic<int> fileCount { 0 };
+        std::atomic<int> directoryCount { 0 };
+
+        void publish()
+        {
+            totalSize.store(state.result.totalSize, std::memory_order_relaxed);
+            progressSize.store(state.result.progressSize, std::memory_order_relaxed);
+            fileCount.store(state.result.fileCount, std::memory_order_relaxed);
+            directoryCount.store(state.result.directoryCount, std::memory_order_relaxed);
+        }
+    };
+
+    ParallelScanQueue queue(workerCount);
+    DeviceThrottle throttle(workerCount);
+    std::atomic<bool> stopFlag { false };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    for (int i = 0; i < workerCount; ++i) {
+        std::unique_ptr<Shard> shard(new Shard);
+        shard->state.options = state.options;
+        shard->state.memoryPageSize = state.memoryPageSize;
+        shard->state.excludePathSet = state.excludePathSet;
+        shard->state.inodes = state.inodes;
+        shard->state.throttle = &throttle;
+        shard->state.sharedStop = &stopFlag;
+        shard->state.useSizeCache = state.useSizeCache;
+        shard->state.progressTimer.start();
+        shards.push_back(std::move(shard));
     }
 
-    qCDebug(logDFMBase) << "FileScannerCore: Local scan completed - files:" << state.result.fileCount
-                        << "dirs:" << state.result.directoryCount << "size:" << state.result.totalSize;
+    for (int i = 0; i < roots.size(); ++i)
+        queue.push(i % workerCount, ScanContext(roots.at(i)));
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(workerCount);
+    for (int i = 0; i < workerCount; ++i) {
+        Shard *shard = shards[static_cast<size_t>(i)].get();
+        pool.start([&queue, shard, i]() {
+            ScanContext ctx;
+            QList<ScanContext> subDirs;
+            while (queue.pop(i, &ctx)) {
+                subDirs.clear();
+                processDirectory(shard->state, ctx, &subDirs);
+                for (ScanContext &child : subDirs)
+                    queue.push(i, std::move(child));
+                queue.taskDone();
+                shard->publish();
+            }
+        });
+    }
+
+    // 调用线程负责汇总进度并执行回调，回调无需考虑线程安全
+    while (!pool.waitForDone(200)) {
+        if (!state.progressCallback || stopFlag.load())
+            continue;
+
+        FileScanner::ScanResult snapshot;
+        snapshot.totalSize = state.result.totalSize;
+        snapshot.progressSize = state.result.progressSize;
+        snapshot.fileCount = state.result.fileCount;
+        snapshot.directoryCount = state.result.directoryCount;
+        for (const auto &shard : shards) {
+            snapshot.totalSize += shard->totalSize.load(std::memory_order_relaxed);
+            snapshot.progressSize += shard->progressSize.load(std::memory_order_relaxed);
+            snapshot.fileCount += shard->fileCount.load(std::memory_order_relaxed);
+            snapshot.directoryCount += shard->directoryCount.load(std::memory_order_relaxed);
+        }
+
+        if (!state.progressCallback(snapshot)) {
+            stopFlag.store(true);
+            queue.abort();
+            state.shouldStop = true;
+        }
+    }
+
+    // 合并分片结果
+    for (const auto &shard : shards) {
+        const FileScanner::ScanResult &part = shard->state.result;
+        state.result.totalSize += part.totalSize;
+        state.result.progressSize += part.progressSize;
+        state.result.fileCount += part.fileCount;
+        state.result.directoryCount += part.directoryCount;
+        state.result.allFiles.append(part.allFiles);
+        state.processedSourceDirs += shard->state.processedSourceDirs;
+    }
+}
+
+bool FileScannerCore::applyCachedSubtree(ScanState &state, const QByteArray &path, const struct stat &statBuf)
+{
+    DirSizeCache::Entry entry;
+    if (!DirSizeCache::instance()->lookup(path, statBuf, &entry))
+        return false;
+
+    state.result.totalSize += entry.totalSize;
+    state.result.progressSize += entry.progressSize;
+    state.result.fileCount += entry.fileCount;
+    state.result.directoryCount += entry.directoryCount;
+    return true;
+}
+
+std::shared_ptr<FileScannerCore::DirNode> FileScannerCore::createNode(const std::shared_ptr<DirNode> &parent,
+                                                                      const QByteArray &path, const struct stat &statBuf)
+{
+    auto node = std::make_shared<DirNode>();
+    node->parent = parent;
+    node->path = path;
+    node->statBuf = statBuf;
+    return node;
+}
+
+void FileScannerCore::completeNode(std::shared_ptr<DirNode> node)
+{
+    // 最后一个完成的子目录负责向上汇总，并行模式下可能发生在任意工作线程
+    while (node && node->pending.fetch_sub(1) == 1) {
+        DirSizeCache::Entry entry;
+        entry.totalSize = node->totalSize.load();
+        entry.progressSize = node->progressSize.load();
+        entry.fileCount = node->fileCount.load();
+        entry.directoryCount = node->directoryCount.load();
+        const bool hasHardLinks = node->hasHardLinks.load();
+        if (!hasHardLinks)
+            DirSizeCache::instance()->store(node->path, node->statBuf, entry);
+
+        if (node->parent) {
+            if (hasHardLinks)
+                node->parent->hasHardLinks = true;
+            node->parent->totalSize += entry.totalSize;
+            node->parent->progressSize += entry.progressSize;
+            node->parent->fileCount += entry.fileCount;
+            node->parent->directoryCount += entry.directoryCount;
+        }
+        node = node->parent;
+    }
 }
 
 void FileScannerCore::scanOtherProtocolsImpl(ScanState &state, const QList<QUrl> &urls)
@@ -810,10 +1298,9 @@ bool FileScannerCore::readDirectoryEntries(const QByteArray &path, QList<DirEntr
 
 void FileScannerCore::processRegularFile(ScanState &state, const QByteArray &path, const struct stat &statBuf)
 {
-    // 硬链接去重
+    // 硬链接去重（查询与登记须为原子操作，否则并行分片可能重复计入大小）
     if (statBuf.st_nlink > 1) {
-        if (!isInodeProcessed(state, statBuf.st_dev, statBuf.st_ino)) {
-            markInodeProcessed(state, statBuf.st_dev, statBuf.st_ino);
+        if (markInodeProcessed(state, statBuf.st_dev, statBuf.st_ino)) {
             state.result.totalSize += statBuf.st_size;
             state.result.fileCount++;
         } else {
@@ -883,15 +1370,12 @@ void FileScannerCore::emitProgress(ScanState &state, bool force)
 
 bool FileScannerCore::isInodeProcessed(const ScanState &state, quint64 device, quint64 inode)
 {
-    return state.processedInodes.value(device).contains(inode);
+    return state.inodes->contains(device, inode);
 }
 
-void FileScannerCore::markInodeProcessed(ScanState &state, quint64 device, quint64 inode)
+bool FileScannerCore::markInodeProcessed(ScanState &state, quint64 device, quint64 inode)
 {
-    if (!state.processedInodes.contains(device)) {
-        state.processedInodes.insert(device, QSet<quint64>());
-    }
-    state.processedInodes[device].insert(inode);
+    return state.inodes->testAndMark(device, inode);
 }
 
 //===================================================================
@@ -61,7 +61,9 @@ public:
         SingleDepth = 0x01,   ///< 只统计顶层，不递归
         IncludeSource = 0x02,   ///< 包含源目录本身（默认不包含）
         CollectFiles = 0x04,   ///< 收集所有文件URL列表（默认不收集）
-        CountOnly = 0x08   ///< 只统计数量，跳过大小统计，避免 stat 系统调用以提升性能
+        CountOnly = 0x08,   ///< 只统计数量，跳过大小统计，避免 stat 系统调用以提升性能
+        Parallel = 0x10,   ///< 本地路径多线程并行扫描（按设备限制并发），CollectFiles 结果不保证遍历顺序
+        UseSizeCache = 0x20   ///< 复用 DirSizeCache 中未变化的子树统计，并写回新统计的子树（仅本地递归大小统计生效）
     };
     Q_ENUM(ScanOption)
     Q_DECLARE_FLAGS(ScanOptions, ScanOption)
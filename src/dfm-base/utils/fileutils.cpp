@@ -84,6 +84,12 @@ const static int kDefaultMemoryPageSize = 4096;
 QMutex FileUtils::cacheCopyingMutex;
 QSet<QUrl> FileUtils::copyingUrl;
 
+// gvfs mounts every remote location under one fuse mount, the mount table can not tell them apart
+static bool isGvfsFuseMount(const QString &fsType)
+{
+    return fsType == "fuse.gvfsd-fuse";
+}
+
 #if (QT_VERSION < QT_VERSION_CHECK(6, 0, 0))
 static float codecConfidenceForData(const QTextCodec *codec, const QByteArray &data, const QLocale::Country &country);
 #endif
@@ -320,6 +326,12 @@ bool FileUtils::isSameMountPoint(const QUrl &url1, const QUrl &url2)
     if (url1.scheme() != url2.scheme())
         return false;
 
+    QString mpt1, mpt2, type1, type2;
+    if (DeviceUtils::findMountOfPath(url1.path(), &mpt1, nullptr, &type1)
+        && DeviceUtils::findMountOfPath(url2.path(), &mpt2, nullptr, &type2)
+        && !isGvfsFuseMount(type1) && !isGvfsFuseMount(type2))
+        return mpt1 == mpt2;
+
     return DFMIO::DFMUtils::mountPathFromUrl(url1) == DFMIO::DFMUtils::mountPathFromUrl(url2);
 }
 
@@ -329,6 +341,12 @@ bool FileUtils::isSameDevice(const QUrl &url1, const QUrl &url2)
         return false;
 
     if (url1.isLocalFile()) {
+        QString dev1, dev2, type1, type2;
+        if (DeviceUtils::findMountOfPath(url1.path(), nullptr, &dev1, &type1)
+            && DeviceUtils::findMountOfPath(url2.path(), nullptr, &dev2, &type2)
+            && !isGvfsFuseMount(type1) && !isGvfsFuseMount(type2))
+            return dev1 == dev2;
+
         return DFMIO::DFMUtils::devicePathFromUrl(url1) == DFMIO::DFMUtils::devicePathFromUrl(url2);
     }
 
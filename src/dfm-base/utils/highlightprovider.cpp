@@ -4,38 +4,60 @@
 
 #include "highlightprovider.h"
 
+#include <QFile>
 #include <QMutexLocker>
+#include <QThread>
 #include <QDebug>
 
+#include <algorithm>
+
+#include <sys/stat.h>
+
 namespace {
 
-// 将 path 和 searchType 组合为唯一缓存 key，避免不同搜索类型互相污染
-static QString compositeKey(const QString &path, int searchType)
+// 排队上限：可见行请求插入头部，超出部分多为已滚出视口的行，直接丢弃
+constexpr int kMaxPendingRequests { 128 };
+// 共享缓存上限（按字符数计费），约数千条摘要
+constexpr int kSnippetCacheCost { 2 * 1024 * 1024 };
+
+// 片段由文件、关键词、搜索类型和定位窗口共同决定，不同会话可安全共享；
+// 文件内容是否变化由工作线程在取用缓存时比对 mtime，调用线程不做任何文件 I/O
+static QString snippetKey(const QString &path, const QString &keyword, int searchType, int positioningMaxLength)
+{
+    return path + QLatin1Char('|') + keyword
+            + QLatin1Char('|') + QString::number(searchType)
+            + QLatin1Char('|') + QString::number(positioningMaxLength);
+}
+
+static qint64 fileMtime(const QString &path)
 {
-    return path + QStringLiteral("|") + QString::number(searchType);
+    struct stat st;
+    if (::stat(QFile::encodeName(path).constData(), &st) != 0)
+        return 0;
+    return static_cast<qint64>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
 }
 
 }   // namespace
 
 namespace dfmbase {
 
-static const QString kPendingToken = QStringLiteral("__pending__");
-
 HighlightProvider::HighlightProvider(QObject *parent)
     : QObject(parent)
 {
-    workerThread = new QThread(this);
-    worker = new QObject();
-    worker->moveToThread(workerThread);
-
-    connect(workerThread, &QThread::finished, worker, &QObject::deleteLater);
-    workerThread->start();
+    // 片段提取以磁盘 I/O 为主，少量并发即可，避免与搜索本身争抢资源
+    workerPool.setMaxThreadCount(qBound(2, QThread::idealThreadCount() / 2, 4));
+    snippetCache.setMaxCost(kSnippetCacheCost);
 }
 
 HighlightProvider::~HighlightProvider()
 {
-    workerThread->quit();
-    workerThread->wait(5000);
+    stopping.store(true, std::memory_order_release);
+    {
+        QMutexLocker lk(&requestMutex);
+        pendingRequests.clear();
+        inflight.clear();
+    }
+    workerPool.waitForDone(5000);
 }
 
 HighlightProvider *HighlightProvider::instance()
@@ -68,125 +90,133 @@ void HighlightProvider::requestHighlight(const QString &taskId, const QString &p
         return;
     }
 
-    // Step 1: 检查缓存
-    const QString key = compositeKey(path, searchType);
+    // 加入请求队列；共享缓存在工作线程上校验 mtime 后取用
+    const QString key = snippetKey(path, keyword, searchType, positioningMaxLength());
+    QList<QPair<QString, QString>> dropped;   // taskId, path
     {
-        QMutexLocker lk(&cacheMutex);
-        auto &taskCache = cache[taskId];
-        auto it = taskCache.find(key);
-
-        if (it != taskCache.end()) {
-            const QString &cached = it.value();
-            if (cached != kPendingToken) {
-                // Empty highlight has no display value. Keep it cached for de-duplication,
-                // but avoid waking views with a no-op update.
-                if (cached.isEmpty())
-                    return;
-
-                // 已获取非空结果，直接返回
-                lk.unlock();
-                Q_EMIT highlightReady(taskId, path, cached);
-                return;
+        QMutexLocker lk(&requestMutex);
+
+        auto it = inflight.find(key);
+        if (it != inflight.end()) {
+            // 同一片段已在排队或处理中（可能来自其他会话），只登记等待者
+            if (!it->contains(taskId))
+                it->append(taskId);
+
+            // 再次以高优先级请求说明该行又回到可见区域，提前到队首
+            if (highPriority) {
+                for (int i = 0; i < pendingRequests.size(); ++i) {
+                    if (pendingRequests.at(i).cacheKey == key) {
+                        pendingRequests.move(i, 0);
+                        break;
+                    }
+                }
             }
-            // 标记为 pending，请求正在进行中，不重复提交
             return;
         }
 
-        // 标记为 pending
-        taskCache[key] = kPendingToken;
-    }
-
-    // Step 2: 加入请求队列
-    {
-        QMutexLocker lk(&requestMutex);
-
+        inflight.insert(key, { taskId });
+        const HighlightRequest req { taskId, path, keyword, searchType, key };
         if (highPriority) {
-            pendingRequests.prepend({taskId, path, keyword, searchType});
+            pendingRequests.prepend(req);
         } else {
-            pendingRequests.append({taskId, path, keyword, searchType});
+            pendingRequests.append(req);
         }
 
-        // 仅在处理状态从 idle 切换到 busy 时投递一次任务，避免重复唤醒 worker。
-        int expected = 0;
-        if (processing.compare_exchange_strong(expected, 1, std::memory_order_acquire)) {
-            QMetaObject::invokeMethod(worker, [this]() {
-                processNextRequest();
-            }, Qt::QueuedConnection);
+        while (pendingRequests.size() > kMaxPendingRequests) {
+            const HighlightRequest old = pendingRequests.takeLast();
+            for (const QString &waiter : inflight.take(old.cacheKey))
+                dropped.append({ waiter, old.path });
         }
+
+        scheduleWorkers();
     }
+
+    for (const auto &item : dropped)
+        Q_EMIT highlightDropped(item.first, item.second);
 }
 
 void HighlightProvider::cancelTask(const QString &taskId)
 {
-    // 从队列中移除所有该 taskId 的请求
-    {
-        QMutexLocker lk(&requestMutex);
-        pendingRequests.erase(
-            std::remove_if(pendingRequests.begin(), pendingRequests.end(),
-                           [&taskId](const HighlightRequest &req) {
-                               return req.taskId == taskId;
-                           }),
-            pendingRequests.end());
+    QMutexLocker lk(&requestMutex);
+
+    // 从等待者中移除该会话，无人等待的片段不再获取
+    for (auto it = inflight.begin(); it != inflight.end();) {
+        it->removeAll(taskId);
+        if (it->isEmpty())
+            it = inflight.erase(it);
+        else
+            ++it;
     }
 
-    // 清除缓存
-    {
-        QMutexLocker lk(&cacheMutex);
-        cache.remove(taskId);
+    pendingRequests.erase(
+        std::remove_if(pendingRequests.begin(), pendingRequests.end(),
+                       [this](const HighlightRequest &req) {
+                           return !inflight.contains(req.cacheKey);
+                       }),
+        pendingRequests.end());
+}
+
+void HighlightProvider::scheduleWorkers()
+{
+    // 调用方已持有 requestMutex
+    while (runningWorkers < workerPool.maxThreadCount()
+           && runningWorkers < pendingRequests.size()) {
+        ++runningWorkers;
+        workerPool.start([this]() {
+            processRequests();
+        });
     }
 }
 
-void HighlightProvider::processNextRequest()
+bool HighlightProvider::lookupCache(const QString &key, qint64 mtime, QString *content)
+{
+    QMutexLocker lk(&cacheMutex);
+    const CachedSnippet *cached = snippetCache.object(key);
+    if (!cached || cached->mtime != mtime)
+        return false;
+
+    *content = cached->content;
+    return true;
+}
+
+void HighlightProvider::processRequests()
 {
     while (true) {
         HighlightRequest req;
 
         {
             QMutexLocker lk(&requestMutex);
-            if (pendingRequests.isEmpty()) {
-                processing.store(0, std::memory_order_release);
-                // 双重检查：防止在 isEmpty 检查与 store 之间新增了请求
-                if (!pendingRequests.isEmpty()) {
-                    int expected = 0;
-                    if (processing.compare_exchange_strong(expected, 1, std::memory_order_acquire)) {
-                        continue;   // 继续处理新请求
-                    }
-                }
+            if (stopping.load(std::memory_order_acquire) || pendingRequests.isEmpty()) {
+                --runningWorkers;
                 return;   // 队列为空，退出
             }
             req = pendingRequests.takeFirst();
         }
 
-        // 检查该 taskId 是否已被取消
-        {
-            QMutexLocker lk(&cacheMutex);
-            if (!cache.contains(req.taskId)) {
-                // 会话已被取消，跳过此请求
-                continue;
-            }
-        }
-
-        // 执行实际的 highlight 获取（同步阻塞 I/O，在工作线程中执行）
+        // 文件未修改时直接复用缓存，否则执行实际的 highlight 获取（同步阻塞 I/O）
+        const qint64 mtime = fileMtime(req.path);
         QString content;
-        if (fetchCallback) {
+        if (!lookupCache(req.cacheKey, mtime, &content)) {
             content = fetchCallback(req.path, req.keyword, req.searchType);
+
+            // 无论会话是否已取消都写入共享缓存，后续会话可直接复用
+            QMutexLocker lk(&cacheMutex);
+            snippetCache.insert(req.cacheKey, new CachedSnippet { mtime, content }, qMax(1, content.size()));
         }
 
-        // 存储到缓存（如果会话在 fetch 期间被取消，则跳过）
+        QStringList waiters;
         {
-            QMutexLocker lk(&cacheMutex);
-            if (!cache.contains(req.taskId)) {
-                // 会话在 fetch 期间被 cancelTask 取消，跳过存储和通知
-                continue;
-            }
-            cache[req.taskId][compositeKey(req.path, req.searchType)] = content;
+            QMutexLocker lk(&requestMutex);
+            waiters = inflight.take(req.cacheKey);
         }
 
+        // Empty highlight has no display value, avoid waking views with a no-op update.
         if (content.isEmpty())
             continue;
 
         // 通知主线程（跨线程信号自动 QueuedConnection）
-        Q_EMIT highlightReady(req.taskId, req.path, content);
+        for (const QString &taskId : waiters)
+            Q_EMIT highlightReady(taskId, req.path, content);
     }
 }
 
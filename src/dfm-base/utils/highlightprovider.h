@@ -8,9 +8,10 @@
 #include <dfm-base/dfm_base_global.h>
 
 #include <QObject>
-#include <QThread>
+#include <QThreadPool>
 #include <QMutex>
 #include <QHash>
+#include <QCache>
 #include <QList>
 #include <functional>
 #include <atomic>
@@ -23,6 +24,7 @@ class HighlightProvider : public QObject
 
 public:
     // 回调类型：path → keyword → searchType → highlightedContent
+    // 回调会在多个工作线程上并发调用，实现需自行保证线程安全
     using FetchHighlightCallback = std::function<QString(const QString &path,
                                                           const QString &keyword,
                                                           int searchType)>;
@@ -44,15 +46,14 @@ public:
                           const QString &keyword, int searchType,
                           bool highPriority = false);
 
-    // 取消指定搜索会话的所有待处理请求
+    // 取消指定搜索会话的所有待处理请求（已获取的片段保留在共享缓存中）
     void cancelTask(const QString &taskId);
 
 Q_SIGNALS:
     // highlightContent 获取完成信号
     void highlightReady(const QString &taskId, const QString &path, const QString &content);
-
-private Q_SLOTS:
-    void processNextRequest();
+    // 请求在处理前被挤出队列（通常是已滚出可见区域的行），调用方可在需要时重新请求
+    void highlightDropped(const QString &taskId, const QString &path);
 
 private:
     struct HighlightRequest
@@ -61,26 +62,35 @@ private:
         QString path;
         QString keyword;
         int searchType;
+        QString cacheKey;
+    };
+
+    struct CachedSnippet
+    {
+        qint64 mtime;   // 获取片段时文件的 mtime（纳秒），不一致时重新获取
+        QString content;
     };
 
     explicit HighlightProvider(QObject *parent = nullptr);
     ~HighlightProvider() override;
 
+    void scheduleWorkers();
+    void processRequests();
+    bool lookupCache(const QString &key, qint64 mtime, QString *content);
+
     FetchHighlightCallback fetchCallback;
     std::atomic<int> m_positioningMaxLength{0};
-    QThread *workerThread = nullptr;
-    QObject *worker = nullptr;   // 工作线程上的占位 QObject（用于槽函数调度）
+    QThreadPool workerPool;
+    std::atomic<bool> stopping { false };
 
     mutable QMutex requestMutex;
-    QList<HighlightRequest> pendingRequests;   // 优先级队列：高优先级插入头部
-    std::atomic<int> processing { 0 };         // 工作线程处理状态标记
-
-    // 缓存：QHash<taskId, QHash<compositeKey(path|searchType), content>>
-    // 未请求 = 不存在于 map 中
-    // 特殊 "__pending__" = 请求中
-    // 空 QString = 已获取但无高亮内容
-    // 非空内容 = 已获取且有高亮内容
-    QHash<QString, QHash<QString, QString>> cache;
+    QList<HighlightRequest> pendingRequests;   // 优先级队列：高优先级插入头部，超出上限时丢弃尾部
+    QHash<QString, QStringList> inflight;      // cacheKey → 等待该结果且未取消的 taskId（排队或处理中）
+    int runningWorkers { 0 };
+
+    // 跨会话共享的片段缓存，key 为 path|keyword|searchType|positioningMaxLength，
+    // 以内容字符数计费，空 content 表示已获取但无高亮内容
+    QCache<QString, CachedSnippet> snippetCache;
     QMutex cacheMutex;
 };
 
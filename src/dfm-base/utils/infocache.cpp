@@ -4,6 +4,7 @@
 
 #include "private/infocache_p.h"
 #include <dfm-base/base/schemefactory.h>
+#include <dfm-base/mimetype/dmimedatabase.h>
 
 #include <dfm-io/dfileinfo.h>
 
@@ -228,6 +229,9 @@ void InfoCache::removeCaches(const QList<QUrl> urls)
     if (d->cacheWorkerStoped || urls.size() <= 0)
         return;
 
+    for (const auto &url : urls)
+        DMimeDatabase::removeCachedMimeType(url);
+
     // 读取主缓存，插入到
     d->status = kCacheCopy;
     QMap<QUrl, FileInfoPointer> infos;
@@ -290,6 +294,7 @@ FileInfoPointer InfoCache::getCacheInfo(const QUrl &url)
  */
 void InfoCache::refreshFileInfo(const QUrl &url)
 {
+    DMimeDatabase::removeCachedMimeType(url);
     FileInfoPointer info = getCacheInfo(url);
     if (info)
         info->updateAttributes();
@@ -4,6 +4,8 @@
 
 #include "networkutils.h"
 
+#include <dfm-base/base/device/private/mountsnapshot.h>
+
 #include <QtConcurrent>
 #include <QFutureWatcher>
 #include <QTcpSocket>
@@ -16,7 +18,6 @@
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <sys/stat.h>
-#include <libmount.h>
 
 using namespace dfmbase;
 
@@ -200,47 +201,28 @@ QMap<QString, QString> NetworkUtils::cifsMountHostInfo()
 {
     static QMutex mutex;
     static QMap<QString, QString> table;
-    struct stat statInfo;
-    int result = stat("/proc/mounts", &statInfo);
+    static QSharedPointer<const MountSnapshot> lastSnapshot;
 
+    // the snapshot is only replaced when the mount table changes, rebuild the map along with it
+    auto snapshot = MountSnapshot::current();
     QMutexLocker locker(&mutex);
-    if (0 == result) {
-        static quint32 lastModify = 0;
-        if (lastModify != statInfo.st_mtime) {
-            lastModify = static_cast<quint32>(statInfo.st_mtime);
-            table.clear();
-        } else {
-            return table;
-        }
-
-        libmnt_table *tab { mnt_new_table() };
-        libmnt_iter *iter { mnt_new_iter(MNT_ITER_BACKWARD) };
-
-        int ret = mnt_table_parse_mtab(tab, nullptr);
-        if (ret != 0) {
-            mnt_free_table(tab);
-            mnt_free_iter(iter);
-            qCWarning(logDFMBase) << "Failed to parse mount table, error code:" << ret;
-            return table;
-        }
-
-        libmnt_fs *fs = nullptr;
-        while (mnt_table_next_fs(tab, iter, &fs) == 0) {
-            if (!fs)
-                continue;
-            // net work mount must start with //
-            QString srcHostAndPort = mnt_fs_get_source(fs);
-            if (!srcHostAndPort.contains(QRegularExpression("^//")))
-                continue;
-
-            const QString &mountPath = mnt_fs_get_target(fs);
-            srcHostAndPort = srcHostAndPort.replace(QRegularExpression("^//"), "");
-            srcHostAndPort = srcHostAndPort.left(srcHostAndPort.indexOf("/"));
-            table.insert(mountPath, srcHostAndPort);
-        }
-
-        mnt_free_table(tab);
-        mnt_free_iter(iter);
+    if (!snapshot || snapshot == lastSnapshot)
+        return table;
+
+    lastSnapshot = snapshot;
+    table.clear();
+
+    const auto &mounts = snapshot->entries();
+    for (auto it = mounts.crbegin(); it != mounts.crend(); ++it) {
+        // net work mount must start with //
+        QString srcHostAndPort = it->source;
+        if (!srcHostAndPort.contains(QRegularExpression("^//")))
+            continue;
+
+        const QString &mountPath = it->target;
+        srcHostAndPort = srcHostAndPort.replace(QRegularExpression("^//"), "");
+        srcHostAndPort = srcHostAndPort.left(srcHostAndPort.indexOf("/"));
+        table.insert(mountPath, srcHostAndPort);
     }
     return table;
 }
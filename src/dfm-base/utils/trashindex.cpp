@@ -0,0 +1,376 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "trashindex.h"
+
+#include <dfm-base/base/standardpaths.h>
+#include <dfm-base/dfm_global_defines.h>
+
+#include <QDir>
+#include <QFile>
+#include <QStorageInfo>
+#include <QDebug>
+
+#include <cerrno>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace dfmbase {
+
+namespace {
+constexpr char kInfoSuffix[] { ".trashinfo" };
+constexpr int kInfoSuffixLength { sizeof(kInfoSuffix) - 1 };
+constexpr qint64 kMaxInfoFileSize { 64 * 1024 };
+// 查询频繁时（如批量还原）不必每次都重新读取挂载表
+constexpr qint64 kMountsCheckIntervalMs { 1000 };
+constexpr uint32_t kInfoDirEvents { IN_CREATE | IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE | IN_MOVED_FROM
+                                    | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR };
+
+bool isDirectory(const QString &path, bool requireSticky = false)
+{
+    struct stat st;
+    if (::lstat(QFile::encodeName(path).constData(), &st) != 0 || !S_ISDIR(st.st_mode))
+        return false;
+    return !requireSticky || (st.st_mode & S_ISVTX);
+}
+
+// 与 gvfsd-trash 的命名保持一致：家目录回收站使用条目名，其他回收站使用条目完整路径，
+// 其中 '/' 替换为 '\'，原有的 '\' 与 '`' 以 '`' 转义
+QString trashItemName(const QString &topDir, const QString &itemName, const QString &filePath)
+{
+    if (topDir.isEmpty()) {
+        if (itemName.startsWith('\\') || itemName.startsWith('`'))
+            return '`' + itemName;
+        return itemName;
+    }
+
+    QString escaped;
+    escaped.reserve(filePath.size() + 8);
+    for (const QChar &ch : filePath) {
+        if (ch == '/') {
+            escaped.append('\\');
+        } else if (ch == '\\' || ch == '`') {
+            escaped.append('`');
+            escaped.append(ch);
+        } else {
+            escaped.append(ch);
+        }
+    }
+    return escaped;
+}
+
+QByteArray readInfoFile(int dirFd, const QString &dirPath, const QString &name)
+{
+    const int fd = dirFd >= 0
+            ? ::openat(dirFd, QFile::encodeName(name).constData(), O_RDONLY | O_CLOEXEC | O_NOFOLLOW)
+            : ::open(QFile::encodeName(dirPath + '/' + name).constData(), O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+    if (fd < 0)
+        return {};
+
+    QByteArray data;
+    char buf[4096];
+    ssize_t n = 0;
+    while ((n = ::read(fd, buf, sizeof(buf))) > 0) {
+        data.append(buf, static_cast<int>(n));
+        if (data.size() > kMaxInfoFileSize)
+            break;
+    }
+    ::close(fd);
+    return data;
+}
+}   // namespace
+
+TrashIndex *TrashIndex::instance()
+{
+    static TrashIndex ins;
+    return &ins;
+}
+
+TrashIndex::TrashIndex()
+{
+    inotifyFd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd < 0)
+        qCWarning(logDFMBase) << "TrashIndex: inotify_init1 failed, trash will be rescanned on every query:" << strerror(errno);
+}
+
+TrashIndex::~TrashIndex()
+{
+    if (inotifyFd >= 0)
+        ::close(inotifyFd);
+}
+
+QList<TrashIndex::Entry> TrashIndex::entries()
+{
+    QMutexLocker locker(&mutex);
+    sync();
+
+    QList<Entry> result;
+    result.reserve(entriesByPath.size());
+    struct stat st;
+    for (const Entry &entry : qAsConst(entriesByPath)) {
+        // 按规范先写 info 再移入 files，两者之间的条目还不完整
+        if (::lstat(QFile::encodeName(entry.filePath).constData(), &st) == 0)
+            result.append(entry);
+    }
+    return result;
+}
+
+bool TrashIndex::find(const QUrl &url, Entry *entry)
+{
+    if (url.scheme() != Global::Scheme::kTrash)
+        return false;
+
+    QMutexLocker locker(&mutex);
+    sync();
+
+    auto it = entriesByPath.constFind(url.path());
+    if (it == entriesByPath.constEnd())
+        return false;
+
+    if (entry)
+        *entry = it.value();
+    return true;
+}
+
+void TrashIndex::sync()
+{
+    // 没有 inotify 时无法增量更新，只能每次重扫
+    if (inotifyFd < 0) {
+        const QStringList &paths = trashDirs.keys();
+        for (const QString &path : paths)
+            removeTrashDir(path);
+    }
+
+    if (!mountsCheckTimer.isValid() || mountsCheckTimer.elapsed() > kMountsCheckIntervalMs || trashDirs.isEmpty()) {
+        QHash<QString, QString> current = trashDirsOfMounts();
+        current.insert(StandardPaths::location(StandardPaths::kTrashLocalPath), QString());
+
+        const QStringList &known = trashDirs.keys();
+        for (const QString &path : known) {
+            if (!current.contains(path))
+                removeTrashDir(path);
+        }
+        for (auto it = current.cbegin(); it != current.cend(); ++it) {
+            if (!trashDirs.contains(it.key()))
+                addTrashDir(it.value(), it.key());
+        }
+        mountsCheckTimer.start();
+    }
+
+    drainEvents();
+}
+
+void TrashIndex::drainEvents()
+{
+    if (inotifyFd < 0)
+        return;
+
+    alignas(struct inotify_event) char buf[16 * 1024];
+    bool rescan = false;
+    QStringList droppedDirs;
+
+    for (;;) {
+        const ssize_t len = ::read(inotifyFd, buf, sizeof(buf));
+        if (len <= 0)
+            break;
+
+        for (char *ptr = buf; ptr < buf + len;) {
+            const auto *event = reinterpret_cast<const struct inotify_event *>(ptr);
+            ptr += sizeof(struct inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                rescan = true;
+                continue;
+            }
+
+            const QString &path = watches.value(event->wd);
+            auto dir = trashDirs.find(path);
+            if (dir == trashDirs.end())
+                continue;
+
+            if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+                droppedDirs.append(path);
+                continue;
+            }
+
+            if (event->len == 0)
+                continue;
+
+            const QString &name = QFile::decodeName(event->name);
+            if (!name.endsWith(QLatin1String(kInfoSuffix)))
+                continue;
+
+            if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+                removeEntry(&dir.value(), name);
+            else
+                updateEntry(&dir.value(), -1, name);
+        }
+    }
+
+    for (const QString &path : droppedDirs) {
+        removeTrashDir(path);
+        // 下次查询时重新检查，回收站被清空重建后可以恢复监视
+        mountsCheckTimer.invalidate();
+    }
+
+    if (rescan) {
+        qCInfo(logDFMBase) << "TrashIndex: inotify queue overflowed, rescanning trash";
+        for (auto it = trashDirs.begin(); it != trashDirs.end(); ++it)
+            scanTrashDir(&it.value());
+    }
+}
+
+void TrashIndex::addTrashDir(const QString &topDir, const QString &path)
+{
+    const QString &infoPath = path + "/info";
+    if (!isDirectory(infoPath))
+        return;
+
+    TrashDir dir;
+    dir.topDir = topDir;
+    dir.path = path;
+    if (inotifyFd >= 0) {
+        dir.watch = ::inotify_add_watch(inotifyFd, QFile::encodeName(infoPath).constData(), kInfoDirEvents);
+        if (dir.watch >= 0)
+            watches.insert(dir.watch, path);
+        else
+            qCWarning(logDFMBase) << "TrashIndex: failed to watch" << infoPath << strerror(errno);
+    }
+
+    auto it = trashDirs.insert(path, dir);
+    scanTrashDir(&it.value());
+}
+
+void TrashIndex::removeTrashDir(const QString &path)
+{
+    auto it = trashDirs.find(path);
+    if (it == trashDirs.end())
+        return;
+
+    for (const QString &entryPath : qAsConst(it->names))
+        entriesByPath.remove(entryPath);
+
+    if (it->watch >= 0) {
+        watches.remove(it->watch);
+        ::inotify_rm_watch(inotifyFd, it->watch);
+    }
+    trashDirs.erase(it);
+}
+
+void TrashIndex::scanTrashDir(TrashDir *dir)
+{
+    for (const QString &entryPath : qAsConst(dir->names))
+        entriesByPath.remove(entryPath);
+    dir->names.clear();
+
+    const QByteArray &infoPath = QFile::encodeName(dir->path + "/info");
+    const int infoFd = ::open(infoPath.constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (infoFd < 0)
+        return;
+
+    // readdir 使用复制出的描述符，原描述符留给 openat 读取 info 文件
+    DIR *dp = ::fdopendir(::dup(infoFd));
+    if (!dp) {
+        ::close(infoFd);
+        return;
+    }
+
+    while (struct dirent *ent = ::readdir(dp)) {
+        const QString &name = QFile::decodeName(ent->d_name);
+        if (name.endsWith(QLatin1String(kInfoSuffix)))
+            updateEntry(dir, infoFd, name);
+    }
+
+    ::closedir(dp);
+    ::close(infoFd);
+}
+
+void TrashIndex::updateEntry(TrashDir *dir, int infoFd, const QString &infoName)
+{
+    const QString &itemName = infoName.left(infoName.size() - kInfoSuffixLength);
+    if (itemName.isEmpty())
+        return;
+
+    QByteArray originPath;
+    QByteArray deletionDate;
+    bool inGroup = false;
+    const QByteArray &data = readInfoFile(infoFd, dir->path + "/info", infoName);
+    for (const QByteArray &rawLine : data.split('\n')) {
+        const QByteArray &line = rawLine.trimmed();
+        if (line.startsWith('[')) {
+            inGroup = line == "[Trash Info]";
+            continue;
+        }
+        if (!inGroup)
+            continue;
+
+        if (line.startsWith("Path="))
+            originPath = line.mid(5);
+        else if (line.startsWith("DeletionDate="))
+            deletionDate = line.mid(13);
+    }
+
+    // 文件刚创建、内容还没写入时读到的是空文件，等 IN_CLOSE_WRITE 再读一次
+    if (originPath.isEmpty()) {
+        removeEntry(dir, infoName);
+        return;
+    }
+
+    Entry entry;
+    entry.filePath = dir->path + "/files/" + itemName;
+    entry.originPath = QUrl::fromPercentEncoding(originPath);
+    if (!entry.originPath.startsWith('/'))
+        entry.originPath = QDir::cleanPath(dir->topDir + '/' + entry.originPath);
+    entry.deletionDate = QDateTime::fromString(QString::fromLatin1(deletionDate), Qt::ISODate);
+
+    const QString &urlPath = '/' + trashItemName(dir->topDir, itemName, entry.filePath);
+    entry.url.setScheme(Global::Scheme::kTrash);
+    entry.url.setPath(urlPath);
+    entry.url.setHost("");
+
+    dir->names.insert(itemName, urlPath);
+    entriesByPath.insert(urlPath, entry);
+}
+
+void TrashIndex::removeEntry(TrashDir *dir, const QString &infoName)
+{
+    const QString &itemName = infoName.left(infoName.size() - kInfoSuffixLength);
+    auto it = dir->names.find(itemName);
+    if (it == dir->names.end())
+        return;
+
+    entriesByPath.remove(it.value());
+    dir->names.erase(it);
+}
+
+QHash<QString, QString> TrashIndex::trashDirsOfMounts() const
+{
+    QHash<QString, QString> dirs;
+    const QString &uid = QString::number(::getuid());
+    const QString &homeTrash = StandardPaths::location(StandardPaths::kTrashLocalPath);
+
+    const QList<QStorageInfo> &volumes = QStorageInfo::mountedVolumes();
+    for (const QStorageInfo &volume : volumes) {
+        if (!volume.isValid() || !volume.isReady())
+            continue;
+
+        const QString &topDir = volume.rootPath() == "/" ? QString() : volume.rootPath();
+        // 规范要求 $topdir/.Trash 为带粘滞位的真实目录
+        const QString &sharedTrash = topDir + "/.Trash/" + uid;
+        if (isDirectory(topDir + "/.Trash", true) && isDirectory(sharedTrash) && sharedTrash != homeTrash)
+            dirs.insert(sharedTrash, topDir.isEmpty() ? QString("/") : topDir);
+
+        const QString &userTrash = topDir + "/.Trash-" + uid;
+        if (isDirectory(userTrash) && userTrash != homeTrash)
+            dirs.insert(userTrash, topDir.isEmpty() ? QString("/") : topDir);
+    }
+
+    return dirs;
+}
+
+}   // namespace dfmbase
@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef TRASHINDEX_H
+#define TRASHINDEX_H
+
+#include <dfm-base/dfm_base_global.h>
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QUrl>
+
+namespace dfmbase {
+
+/**
+ * @brief 回收站条目的本地索引
+ *
+ * 直接读取家目录回收站和各挂载点下 .Trash/$uid、.Trash-$uid 中的 info 目录，
+ * 解析 .trashinfo 得到原路径和删除时间，不经过 gvfsd-trash。
+ *
+ * 首次访问时完整扫描一次，之后通过 inotify 监视各 info 目录，在每次查询前取出
+ * 积压的事件增量更新；事件队列溢出时整体重扫。挂载点变化也在查询时检测。
+ *
+ * 条目的 url 与 gvfsd-trash 的命名一致，可直接用于 trash:/// 下的其他操作。
+ *
+ * 线程安全，可在任意线程调用。
+ */
+class TrashIndex
+{
+public:
+    struct Entry
+    {
+        QUrl url;   ///< trash:/// 下的地址
+        QString filePath;   ///< 条目在 files 目录中的实际路径
+        QString originPath;   ///< 删除前的绝对路径
+        QDateTime deletionDate;
+    };
+
+    static TrashIndex *instance();
+
+    /**
+     * @brief 回收站中的所有条目，info 存在但 files 中已不存在的条目不会返回
+     */
+    QList<Entry> entries();
+
+    /**
+     * @brief 按 trash:/// 地址查询顶层条目
+     */
+    bool find(const QUrl &url, Entry *entry);
+
+private:
+    struct TrashDir
+    {
+        QString topDir;   ///< 所在挂载点，家目录回收站为空
+        QString path;   ///< 回收站目录，包含 files 与 info
+        int watch { -1 };
+        QHash<QString, QString> names;   ///< 条目名 -> url 路径，用于按 info 文件名删除
+    };
+
+    TrashIndex();
+    ~TrashIndex();
+    Q_DISABLE_COPY(TrashIndex)
+
+    void sync();
+    void drainEvents();
+    void addTrashDir(const QString &topDir, const QString &path);
+    void removeTrashDir(const QString &path);
+    void scanTrashDir(TrashDir *dir);
+    void updateEntry(TrashDir *dir, int infoFd, const QString &infoName);
+    void removeEntry(TrashDir *dir, const QString &infoName);
+    QHash<QString, QString> trashDirsOfMounts() const;
+
+    QMutex mutex;
+    int inotifyFd { -1 };
+    QHash<QString, TrashDir> trashDirs;   ///< 回收站目录 -> 目录信息
+    QHash<int, QString> watches;   ///< inotify watch -> 回收站目录
+    QHash<QString, Entry> entriesByPath;   ///< url 路径 -> 条目
+    QElapsedTimer mountsCheckTimer;
+};
+
+}
+
+#endif   // TRASHINDEX_H
@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "urlrowindex.h"
+
+#include <algorithm>
+
+DFMBASE_BEGIN_NAMESPACE
+
+namespace {
+// 删除记录过多时查询和插入有序数组的代价会超过一次重建
+constexpr int kMaxRemovedRows { 256 };
+}   // namespace
+
+UrlRowIndex::UrlRowIndex(const QList<QUrl> *urls)
+    : urls(urls)
+{
+    Q_ASSERT(urls);
+}
+
+void UrlRowIndex::reset()
+{
+    baseRows.clear();
+    baseRows.reserve(urls->size());
+    for (int i = 0; i < urls->size(); ++i)
+        baseRows.insert(urls->at(i), i);
+
+    removedRows.clear();
+    nextBaseRow = urls->size();
+}
+
+void UrlRowIndex::clear()
+{
+    baseRows.clear();
+    removedRows.clear();
+    nextBaseRow = 0;
+}
+
+int UrlRowIndex::row(const QUrl &url) const
+{
+    auto it = baseRows.constFind(url);
+    if (it == baseRows.constEnd())
+        return -1;
+
+    const int base = it.value();
+    if (removedRows.isEmpty())
+        return base;
+
+    auto shift = std::lower_bound(removedRows.cbegin(), removedRows.cend(), base) - removedRows.cbegin();
+    return base - static_cast<int>(shift);
+}
+
+bool UrlRowIndex::contains(const QUrl &url) const
+{
+    return baseRows.contains(url);
+}
+
+void UrlRowIndex::append(const QUrl &url)
+{
+    // 新的基准行号大于所有已删除的基准行号，换算后正好是列表末尾
+    baseRows.insert(url, nextBaseRow++);
+}
+
+void UrlRowIndex::append(const QList<QUrl> &list)
+{
+    for (const QUrl &url : list)
+        append(url);
+}
+
+void UrlRowIndex::remove(const QUrl &url)
+{
+    auto it = baseRows.find(url);
+    if (it == baseRows.end())
+        return;
+
+    const int base = it.value();
+    baseRows.erase(it);
+    removedRows.insert(std::lower_bound(removedRows.begin(), removedRows.end(), base), base);
+
+    if (removedRows.size() > kMaxRemovedRows)
+        reset();
+}
+
+void UrlRowIndex::replace(const QUrl &oldUrl, const QUrl &newUrl)
+{
+    auto it = baseRows.find(oldUrl);
+    if (it == baseRows.end())
+        return;
+
+    const int base = it.value();
+    baseRows.erase(it);
+    baseRows.insert(newUrl, base);
+}
+
+DFMBASE_END_NAMESPACE
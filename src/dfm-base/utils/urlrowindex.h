@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef URLROWINDEX_H
+#define URLROWINDEX_H
+
+#include <dfm-base/dfm_base_global.h>
+
+#include <QHash>
+#include <QList>
+#include <QUrl>
+#include <QVector>
+
+DFMBASE_BEGIN_NAMESPACE
+
+/**
+ * @class UrlRowIndex
+ * @brief 平铺模型中 url 到行号的索引
+ *
+ * 为以 QList<QUrl> 保存行顺序的模型提供 O(1) 的 url→行号 查询，替代 indexOf 的线性查找。
+ *
+ * 索引记录的是上次重建时的“基准行号”，此后删除的行只记入一个有序的基准行号数组，
+ * 查询时减去排在其前面的已删除行数即得当前行号，因此删除不需要逐行重排；
+ * 已删除行累积到一定数量后再整体重建一次。
+ *
+ * 约定：调用方先修改所绑定的列表，再同步调用 append()/remove()/replace()。
+ * 只支持追加、删除和原位替换，其他重排列表的操作之后需调用 reset()。
+ */
+class UrlRowIndex
+{
+public:
+    explicit UrlRowIndex(const QList<QUrl> *urls);
+
+    /**
+     * @brief 按当前列表重建索引
+     */
+    void reset();
+    void clear();
+
+    /**
+     * @brief 查询 url 当前所在的行，不存在时返回 -1
+     */
+    int row(const QUrl &url) const;
+    bool contains(const QUrl &url) const;
+
+    /**
+     * @brief 登记已追加到列表末尾的 url
+     */
+    void append(const QUrl &url);
+    void append(const QList<QUrl> &list);
+
+    /**
+     * @brief 移除已从列表中删除的 url
+     */
+    void remove(const QUrl &url);
+
+    /**
+     * @brief 登记原位替换的 url，行号不变
+     */
+    void replace(const QUrl &oldUrl, const QUrl &newUrl);
+
+private:
+    const QList<QUrl> *urls { nullptr };
+    QHash<QUrl, int> baseRows;
+    QVector<int> removedRows;   // 自上次重建以来删除的基准行号，升序
+    int nextBaseRow { 0 };
+};
+
+DFMBASE_END_NAMESPACE
+
+#endif   // URLROWINDEX_H
@@ -3,10 +3,20 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "burncheckstrategy.h"
-#include "burnhelper.h"
 
 #include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QThread>
+#include <QThreadPool>
+
+#include <array>
+#include <cstring>
+
+#include <dirent.h>
+#include <fcntl.h>
 #include <linux/limits.h>
+#include <sys/stat.h>
 
 namespace dfmplugin_burn {
 
@@ -19,6 +29,33 @@ static constexpr int kMaxISO9660FileNameSize { 32 };
 static constexpr int kMaxJolietFileNameSize { 103 };
 static constexpr int kMaxJolietFilePathSize { 800 };
 
+// 遍历以 IO 为主，线程再多收益不大
+static constexpr int kMaxCheckThreads { 4 };
+
+static constexpr char kInvalidFileNameCharacters[] { "Invalid FileNameCharacters Length: " };
+static constexpr char kInvalidFilePathCharacters[] { "Invalid FilePathCharacters Length: " };
+static constexpr char kInvalidFileNameBytes[] { "Invalid FileNameBytes Length: " };
+static constexpr char kInvalidFilePathBytes[] { "Invalid FilePathBytes Length: " };
+static constexpr char kInvalidFilePathDeepLength[] { "Invalid FilePathDeepLength: " };
+
+// UTF-8 字节对应的 UTF-16 字符数：续字节为 0，四字节序列的首字节为 2（代理对），与 QString::size() 一致
+static const std::array<quint8, 256> &utf16LengthTable()
+{
+    static const std::array<quint8, 256> table = [] {
+        std::array<quint8, 256> t {};
+        for (int c = 0; c < 256; ++c) {
+            if ((c & 0xC0) == 0x80)
+                t[c] = 0;
+            else if (c >= 0xF0 && c <= 0xF7)
+                t[c] = 2;
+            else
+                t[c] = 1;
+        }
+        return t;
+    }();
+    return table;
+}
+
 BurnCheckStrategy::BurnCheckStrategy(const QString &path, QObject *parent)
     : QObject(parent), currentStagePath(path)
 {
@@ -32,22 +69,18 @@ bool BurnCheckStrategy::check()
     if (!info.isDir())
         return true;
 
-    const QFileInfoList &rootFileInfoGroup { BurnHelper::localFileInfoList(currentStagePath) };
-    for (const QFileInfo &info : rootFileInfoGroup) {
-        if (!validFile(info))
-            return false;
-        if (info.isDir()) {
-            const auto &filters { QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot | QDir::NoSymLinks };
-            const QFileInfoList &subFileInfoGroup { BurnHelper::localFileInfoListRecursive(info.absoluteFilePath(), filters) };
-            if (!std::all_of(subFileInfoGroup.cbegin(), subFileInfoGroup.cend(), [this](const QFileInfo &info) {
-                    return validFile(info);
-                })) {
-                return false;
-            }
-        }
-    }
+    failed = false;
+    invalidName.clear();
+    errorMsg.clear();
+
+    // 每个目录一个任务，子目录在遍历到时继续投递，waitForDone 等待整棵树处理完
+    QThreadPool pool;
+    pool.setMaxThreadCount(qBound(1, QThread::idealThreadCount(), kMaxCheckThreads));
+    const QByteArray &stagePath { QFile::encodeName(currentStagePath) };
+    pool.start([this, &pool, stagePath] { checkDirectory(&pool, stagePath, {}); });
+    pool.waitForDone();
 
-    return true;
+    return !failed;
 }
 
 QString BurnCheckStrategy::lastError() const
@@ -60,43 +93,87 @@ QString BurnCheckStrategy::lastInvalidName() const
     return autoFeed(invalidName);
 }
 
-bool BurnCheckStrategy::validFile(const QFileInfo &info)
+void BurnCheckStrategy::checkDirectory(QThreadPool *pool, const QByteArray &dirPath, const PathLength &dirLength)
 {
-    if (!info.exists())
-        return true;
+    if (failed.load(std::memory_order_relaxed))
+        return;
 
-    QString absoluteFilePathWithStagePath { info.absoluteFilePath() };
-    const QString &fileName { info.fileName() };
-    const QString &absoluteFilePath { absoluteFilePathWithStagePath.remove(currentStagePath) };
-    invalidName = fileName;
+    DIR *dir = ::opendir(dirPath.constData());
+    if (!dir)
+        return;
 
-    if (!validFileNameCharacters(fileName)) {
-        errorMsg = "Invalid FileNameCharacters Length: " + invalidName;
-        return false;
-    }
+    const auto &utf16Length = utf16LengthTable();
+    while (!failed.load(std::memory_order_relaxed)) {
+        const struct dirent *entry = ::readdir(dir);
+        if (!entry)
+            break;
 
-    if (!validFilePathCharacters(absoluteFilePath)) {
-        errorMsg = "Invalid FilePathCharacters Length: " + invalidName;
-        return false;
-    }
+        // 与原先 QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot | QDir::NoSymLinks 的过滤一致：
+        // 跳过隐藏文件、符号链接和特殊文件
+        const char *name = entry->d_name;
+        if (name[0] == '.')
+            continue;
 
-    if (!validFileNameBytes(fileName)) {
-        errorMsg = "Invalid FileNameBytes Length: " + invalidName;
-        return false;
-    }
+        unsigned char type = entry->d_type;
+        if (type == DT_UNKNOWN) {
+            struct stat st;
+            if (::fstatat(::dirfd(dir), name, &st, AT_SYMLINK_NOFOLLOW) != 0)
+                continue;
+            type = S_ISDIR(st.st_mode) ? DT_DIR : (S_ISREG(st.st_mode) ? DT_REG : DT_UNKNOWN);
+        }
+        if (type != DT_DIR && type != DT_REG)
+            continue;
+
+        int nameBytes = 0;
+        int nameCharacters = 0;
+        for (const char *c = name; *c; ++c, ++nameBytes)
+            nameCharacters += utf16Length[static_cast<uchar>(*c)];
+
+        PathLength pathLength;
+        pathLength.characters = dirLength.characters + 1 + nameCharacters;
+        pathLength.bytes = dirLength.bytes + 1 + nameBytes;
+        pathLength.deepLength = dirLength.deepLength + 1;
+
+        if (const char *rule = invalidRule(nameCharacters, nameBytes, pathLength)) {
+            setInvalid(rule, name);
+            break;
+        }
 
-    if (!validFilePathBytes(absoluteFilePath)) {
-        errorMsg = "Invalid FilePathBytes Length: " + invalidName;
-        return false;
+        if (type == DT_DIR) {
+            QByteArray subDirPath { dirPath };
+            subDirPath.append('/').append(name, nameBytes);
+            pool->start([this, pool, subDirPath, pathLength] { checkDirectory(pool, subDirPath, pathLength); });
+        }
     }
 
-    if (!validFilePathDeepLength(absoluteFilePath)) {
-        errorMsg = "Invalid FilePathDeepLength: " + invalidName;
-        return false;
-    }
+    ::closedir(dir);
+}
 
-    invalidName = "";
-    return true;
+const char *BurnCheckStrategy::invalidRule(int nameCharacters, int nameBytes, const PathLength &pathLength) const
+{
+    if (nameCharacters > limits.maxFileNameCharacters)
+        return kInvalidFileNameCharacters;
+    if (pathLength.characters > limits.maxFilePathCharacters)
+        return kInvalidFilePathCharacters;
+    if (nameBytes > limits.maxFileNameBytes)
+        return kInvalidFileNameBytes;
+    if (pathLength.bytes > limits.maxFilePathBytes)
+        return kInvalidFilePathBytes;
+    if (pathLength.deepLength > limits.maxFilePathDeepLength)
+        return kInvalidFilePathDeepLength;
+    return nullptr;
+}
+
+void BurnCheckStrategy::setInvalid(const char *rule, const char *fileName)
+{
+    // 多个线程同时发现问题时只记录第一个
+    bool expected = false;
+    if (!failed.compare_exchange_strong(expected, true))
+        return;
+
+    QMutexLocker locker(&errorMutex);
+    invalidName = QFile::decodeName(fileName);
+    errorMsg = QString::fromLatin1(rule) + invalidName;
 }
 
 QString BurnCheckStrategy::autoFeed(const QString &text) const
@@ -114,55 +191,6 @@ QString BurnCheckStrategy::autoFeed(const QString &text) const
     return name;
 }
 
-bool BurnCheckStrategy::validCommonFileNameBytes(const QString &fileName)
-{
-    return fileName.toUtf8().size() < kMaxCommonFileNameBytes;
-}
-
-bool BurnCheckStrategy::validComontFilePathBytes(const QString &filePath)
-{
-    return filePath.toUtf8().size() < kMaxCommontFilePathBytes;
-}
-
-bool BurnCheckStrategy::validCommonFilePathDeepLength(const QString &filePath)
-{
-#if (QT_VERSION < QT_VERSION_CHECK(6, 0, 0))
-    return filePath.split(QDir::separator(), QString::SkipEmptyParts).size() <= kMaxCommonDirDeepLength;
-#else
-    return filePath.split(QDir::separator(), Qt::SkipEmptyParts).size() <= kMaxCommonDirDeepLength;
-#endif
-}
-
-bool BurnCheckStrategy::validFileNameCharacters(const QString &fileName)
-{
-    Q_UNUSED(fileName)
-    return true;
-}
-
-bool BurnCheckStrategy::validFilePathCharacters(const QString &filePath)
-{
-    Q_UNUSED(filePath)
-    return true;
-}
-
-bool BurnCheckStrategy::validFileNameBytes(const QString &fileName)
-{
-    Q_UNUSED(fileName)
-    return true;
-}
-
-bool BurnCheckStrategy::validFilePathBytes(const QString &filePath)
-{
-    Q_UNUSED(filePath)
-    return true;
-}
-
-bool BurnCheckStrategy::validFilePathDeepLength(const QString &filePath)
-{
-    Q_UNUSED(filePath)
-    return true;
-}
-
 /*!
  * \brief 最大文件名/目录名：32个字符，且最大目录深度为8
  * \param path
@@ -171,16 +199,8 @@ bool BurnCheckStrategy::validFilePathDeepLength(const QString &filePath)
 ISO9660CheckStrategy::ISO9660CheckStrategy(const QString &path, QObject *parent)
     : BurnCheckStrategy(path, parent)
 {
-}
-
-bool ISO9660CheckStrategy::validFileNameCharacters(const QString &fileName)
-{
-    return fileName.size() < kMaxISO9660FileNameSize;
-}
-
-bool ISO9660CheckStrategy::validFilePathDeepLength(const QString &filePath)
-{
-    return validCommonFilePathDeepLength(filePath);
+    limits.maxFileNameCharacters = kMaxISO9660FileNameSize - 1;
+    limits.maxFilePathDeepLength = kMaxCommonDirDeepLength;
 }
 
 /*!
@@ -190,20 +210,13 @@ bool ISO9660CheckStrategy::validFilePathDeepLength(const QString &filePath)
  */
 JolietCheckStrategy::JolietCheckStrategy(const QString &path, QObject *parent)
     : BurnCheckStrategy(path, parent)
-{
-}
-
-bool JolietCheckStrategy::validFileNameCharacters(const QString &fileName)
 {
     // joliet_long_names 扩展，将 joliet 对文件名的限制从 64 字符提升到 103 字符。
     // 但在 libisofs 中，文件名长度又受 POSIX 标准中 NAME_MAX(255字节) 的限制。
     // 因此，该扩展下需要同时满足两个条件的文件名，在刻录后才不会被截断。
-    return fileName.size() <= kMaxJolietFileNameSize && fileName.toUtf8().size() <= NAME_MAX;
-}
-
-bool JolietCheckStrategy::validFilePathCharacters(const QString &filePath)
-{
-    return filePath.size() <= kMaxJolietFilePathSize;
+    limits.maxFileNameCharacters = kMaxJolietFileNameSize;
+    limits.maxFileNameBytes = NAME_MAX;
+    limits.maxFilePathCharacters = kMaxJolietFilePathSize;
 }
 
 /*!
@@ -214,21 +227,9 @@ bool JolietCheckStrategy::validFilePathCharacters(const QString &filePath)
 RockRidgeCheckStrategy::RockRidgeCheckStrategy(const QString &path, QObject *parent)
     : BurnCheckStrategy(path, parent)
 {
-}
-
-bool RockRidgeCheckStrategy::validFileNameBytes(const QString &fileName)
-{
-    return validCommonFileNameBytes(fileName);
-}
-
-bool RockRidgeCheckStrategy::validFilePathBytes(const QString &filePath)
-{
-    return validComontFilePathBytes(filePath);
-}
-
-bool RockRidgeCheckStrategy::validFilePathDeepLength(const QString &filePath)
-{
-    return validCommonFilePathDeepLength(filePath);
+    limits.maxFileNameBytes = kMaxCommonFileNameBytes - 1;
+    limits.maxFilePathBytes = kMaxCommontFilePathBytes - 1;
+    limits.maxFilePathDeepLength = kMaxCommonDirDeepLength;
 }
 
 /*!
@@ -239,16 +240,8 @@ bool RockRidgeCheckStrategy::validFilePathDeepLength(const QString &filePath)
 UDFCheckStrategy::UDFCheckStrategy(const QString &path, QObject *parent)
     : BurnCheckStrategy(path, parent)
 {
-}
-
-bool UDFCheckStrategy::validFileNameBytes(const QString &fileName)
-{
-    return validCommonFileNameBytes(fileName);
-}
-
-bool UDFCheckStrategy::validFilePathBytes(const QString &filePath)
-{
-    return validComontFilePathBytes(filePath);
+    limits.maxFileNameBytes = kMaxCommonFileNameBytes - 1;
+    limits.maxFilePathBytes = kMaxCommontFilePathBytes - 1;
 }
 
 }   // namespace dfmplugin_burn
@@ -6,10 +6,24 @@
 #define BURNCHECKSTRATEGY_H
 
 #include <QObject>
-#include <QFileInfo>
+#include <QMutex>
+
+#include <atomic>
+#include <climits>
+
+QT_BEGIN_NAMESPACE
+class QThreadPool;
+QT_END_NAMESPACE
 
 namespace dfmplugin_burn {
 
+/*!
+ * \brief 刻录前检查暂存目录中的文件名、路径是否满足目标文件系统的限制
+ *
+ * 各文件系统的规则在构造时归结为一组长度上限，遍历时直接用 readdir 得到的字节计算，
+ * 不为每个条目构造 QFileInfo/QString。子目录分发到线程池并行遍历，发现第一个
+ * 不满足的条目后停止。
+ */
 class BurnCheckStrategy : public QObject
 {
     Q_OBJECT
@@ -20,25 +34,38 @@ public:
     QString lastError() const;
     QString lastInvalidName() const;
 
-private:
-    bool validFile(const QFileInfo &info);
-    QString autoFeed(const QString &text) const;
-
 protected:
-    bool validCommonFileNameBytes(const QString &fileName);
-    bool validComontFilePathBytes(const QString &filePath);
-    bool validCommonFilePathDeepLength(const QString &filePath);
+    // 字符数按 QString::size() 计（UTF-16），字节数按 UTF-8 计，路径相对暂存目录且以 '/' 开头
+    struct Limits
+    {
+        int maxFileNameCharacters { INT_MAX };
+        int maxFilePathCharacters { INT_MAX };
+        int maxFileNameBytes { INT_MAX };
+        int maxFilePathBytes { INT_MAX };
+        int maxFilePathDeepLength { INT_MAX };
+    };
+
+    struct PathLength
+    {
+        int characters { 0 };
+        int bytes { 0 };
+        int deepLength { 0 };
+    };
+
+    Limits limits;
 
-    virtual bool validFileNameCharacters(const QString &fileName);
-    virtual bool validFilePathCharacters(const QString &filePath);
-    virtual bool validFileNameBytes(const QString &fileName);
-    virtual bool validFilePathBytes(const QString &filePath);
-    virtual bool validFilePathDeepLength(const QString &filePath);
+private:
+    void checkDirectory(QThreadPool *pool, const QByteArray &dirPath, const PathLength &dirLength);
+    const char *invalidRule(int nameCharacters, int nameBytes, const PathLength &pathLength) const;
+    void setInvalid(const char *rule, const char *fileName);
+    QString autoFeed(const QString &text) const;
 
-protected:
+private:
     QString invalidName;
     QString errorMsg;
     QString currentStagePath;
+    std::atomic<bool> failed { false };
+    QMutex errorMutex;
 };
 
 class ISO9660CheckStrategy final : public BurnCheckStrategy
@@ -47,10 +74,6 @@ class ISO9660CheckStrategy final : public BurnCheckStrategy
 
 public:
     explicit ISO9660CheckStrategy(const QString &path, QObject *parent = nullptr);
-
-protected:
-    bool validFileNameCharacters(const QString &fileName) override;
-    bool validFilePathDeepLength(const QString &filePath) override;
 };
 
 class JolietCheckStrategy final : public BurnCheckStrategy
@@ -59,10 +82,6 @@ class JolietCheckStrategy final : public BurnCheckStrategy
 
 public:
     explicit JolietCheckStrategy(const QString &path, QObject *parent = nullptr);
-
-protected:
-    bool validFileNameCharacters(const QString &fileName) override;
-    bool validFilePathCharacters(const QString &filePath) override;
 };
 
 class RockRidgeCheckStrategy final : public BurnCheckStrategy
@@ -71,11 +90,6 @@ class RockRidgeCheckStrategy final : public BurnCheckStrategy
 
 public:
     explicit RockRidgeCheckStrategy(const QString &path, QObject *parent = nullptr);
-
-protected:
-    bool validFileNameBytes(const QString &fileName) override;
-    bool validFilePathBytes(const QString &filePath) override;
-    bool validFilePathDeepLength(const QString &filePath) override;
 };
 
 class UDFCheckStrategy final : public BurnCheckStrategy
@@ -84,10 +98,6 @@ class UDFCheckStrategy final : public BurnCheckStrategy
 
 public:
     explicit UDFCheckStrategy(const QString &path, QObject *parent = nullptr);
-
-protected:
-    bool validFileNameBytes(const QString &fileName) override;
-    bool validFilePathBytes(const QString &filePath) override;
 };
 
 }   // namespace
@@ -29,6 +29,14 @@ enum class SystemEmblemType : uint8_t {
 const double kMinEmblemSize = 12.0;
 const double kMaxEmblemSize = 128.0;
 
+// emblem worker defines
+inline constexpr int kMaxCachedEmblemFiles { 20000 };
+inline constexpr int kMaxInternedEmblems { 512 };
+// 同一目录下待读取的文件不少于该数量时改为枚举整个目录一次读出
+inline constexpr int kMinBatchedEmblemReads { 8 };
+// 目录条目数不超过待读取文件数的该倍数时才枚举，避免大目录中只为少量可见文件读取全部条目
+inline constexpr int kMaxEnumeratedEntriesRatio { 4 };
+
 inline constexpr char kConfigPath[] { "org.deepin.dde.file-manager.emblem" };
 inline constexpr char kHideSystemEmblems[] { "dfm.system.emblem.hidden" };
 
@@ -14,39 +14,63 @@
 #include <dfm-io/dfileinfo.h>
 
 #include <QDebug>
+#include <QFile>
 #include <QStandardPaths>
+#include <QTimer>
+
+#include <dirent.h>
+
+#undef signals
+extern "C" {
+#include <gio/gio.h>
+}
+#define signals public
 
 USING_IO_NAMESPACE
 DFMBASE_USE_NAMESPACE
 DPF_USE_NAMESPACE
 DPEMBLEM_USE_NAMESPACE
 
-void GioEmblemWorker::onProduce(const FileInfoPointer &info)
+namespace {
+// 只读取目录项名称，超过 limit 即停止，开销与 limit 成正比而不是与目录大小成正比
+bool dirEntriesAtMost(const QString &dirPath, int limit)
 {
-    Q_ASSERT(qApp->thread() != QThread::currentThread());
+    DIR *dir = opendir(QFile::encodeName(dirPath).constData());
+    if (!dir)
+        return false;
 
-    if (!info) {
-        return;  // 添加空指针检查
+    int count = 0;
+    while (struct dirent *entry = readdir(dir)) {
+        if (qstrcmp(entry->d_name, ".") == 0 || qstrcmp(entry->d_name, "..") == 0)
+            continue;
+        if (++count > limit)
+            break;
     }
+    closedir(dir);
+    return count <= limit;
+}
+}   // namespace
 
-    const auto &emblems { fetchEmblems(info) };
+void GioEmblemWorker::onProduce(const QList<FileInfoPointer> &infos)
+{
+    Q_ASSERT(qApp->thread() != QThread::currentThread());
 
-    const QUrl &url = info->urlOf(UrlInfoType::kUrl);
-    if (cache.contains(url)) {
-        const auto &old { cache.value(url) };
-        if (!iconNamesEqual(old, emblems)) {
-            cache[url] = emblems;
-            emit emblemChanged(url, emblems);
-        }
-    } else {   // save to cache
-        cache.insert(url, emblems);
-        emit emblemChanged(url, emblems);
+    const QHash<QUrl, QString> &emblemsStrs = readEmblemAttributes(infos);
+    for (auto it = emblemsStrs.cbegin(); it != emblemsStrs.cend(); ++it) {
+        const QUrl &url = it.key();
+        const QString *old = cache.object(url);
+        if (old && *old == it.value())
+            continue;
+
+        cache.insert(url, new QString(it.value()));
+        emit emblemChanged(url, makeEmblems(it.value()));
     }
 }
 
 void GioEmblemWorker::onClear()
 {
     cache.clear();
+    emblemTable.clear();
 }
 
 QList<QIcon> GioEmblemWorker::fetchEmblems(const FileInfoPointer &info) const
@@ -54,10 +78,85 @@ QList<QIcon> GioEmblemWorker::fetchEmblems(const FileInfoPointer &info) const
     if (!info)
         return {};
 
+    return makeEmblems(readEmblemAttribute(info));
+}
+
+QHash<QUrl, QString> GioEmblemWorker::readEmblemAttributes(const QList<FileInfoPointer> &infos) const
+{
+    QHash<QUrl, QString> result;
+    QHash<QString, QHash<QString, FileInfoPointer>> localFiles;   // 父目录 -> (文件名 -> 文件信息)
+
+    for (const FileInfoPointer &info : infos) {
+        if (!info)
+            continue;
+
+        const QUrl &url = info->urlOf(UrlInfoType::kUrl);
+        if (url.isLocalFile()) {
+            const QString &path = url.toLocalFile();
+            const int sep = path.lastIndexOf('/');
+            if (sep >= 0 && sep < path.length() - 1) {
+                localFiles[path.left(qMax(sep, 1))].insert(path.mid(sep + 1), info);
+                continue;
+            }
+        }
+        result.insert(url, readEmblemAttribute(info));
+    }
+
+    for (auto dir = localFiles.cbegin(); dir != localFiles.cend(); ++dir) {
+        const QHash<QString, FileInfoPointer> &files = dir.value();
+        if (files.size() < kMinBatchedEmblemReads
+            || !dirEntriesAtMost(dir.key(), files.size() * kMaxEnumeratedEntriesRatio)) {
+            for (const FileInfoPointer &info : files)
+                result.insert(info->urlOf(UrlInfoType::kUrl), readEmblemAttribute(info));
+            continue;
+        }
+
+        // 待读取的文件占目录的大部分时，一次枚举读出整个目录的角标属性，代替逐个文件查询
+        QHash<QString, FileInfoPointer> remaining = files;
+        g_autoptr(GFile) gfile = g_file_new_for_path(dir.key().toLocal8Bit().constData());
+        g_autoptr(GFileEnumerator) enumerator = g_file_enumerate_children(gfile, "standard::name,metadata::emblems",
+                                                                          G_FILE_QUERY_INFO_NOFOLLOW_SYMLINKS,
+                                                                          nullptr, nullptr);
+        while (enumerator && !remaining.isEmpty()) {
+            g_autoptr(GFileInfo) gInfo = g_file_enumerator_next_file(enumerator, nullptr, nullptr);
+            if (!gInfo)
+                break;
+
+            auto it = remaining.find(QString::fromLocal8Bit(g_file_info_get_name(gInfo)));
+            if (it == remaining.end())
+                continue;
+
+            QString emblemsStr;
+            char **emblems = g_file_info_get_attribute_stringv(gInfo, "metadata::emblems");
+            if (emblems && emblems[0])
+                emblemsStr = QString::fromLocal8Bit(emblems[0]);
+            result.insert(it.value()->urlOf(UrlInfoType::kUrl), emblemsStr);
+            remaining.erase(it);
+        }
+
+        // 枚举失败或枚举期间新建的文件逐个读取
+        for (const FileInfoPointer &info : remaining)
+            result.insert(info->urlOf(UrlInfoType::kUrl), readEmblemAttribute(info));
+    }
+
+    return result;
+}
+
+QString GioEmblemWorker::readEmblemAttribute(const FileInfoPointer &info) const
+{
+    if (!info)
+        return {};
+
+    const QStringList &emblemData = info->customAttribute("metadata::emblems", DFileInfo::DFileAttributeType::kTypeStringV).toStringList();
+    return emblemData.isEmpty() ? QString() : emblemData.first();
+}
+
+QList<QIcon> GioEmblemWorker::makeEmblems(const QString &emblemsStr) const
+{
     QList<QIcon> emblemList;
 
     // add gio emblem icons
-    const auto &gioEmblemsMap = getGioEmblems(info);
+    const auto &gioEmblemsMap = getGioEmblems(emblemsStr);
     QMap<int, QIcon>::const_iterator iter = gioEmblemsMap.begin();
     while (iter != gioEmblemsMap.end()) {
         if (iter.key() == emblemList.count()) {
@@ -80,38 +179,51 @@ QList<QIcon> GioEmblemWorker::fetchEmblems(const FileInfoPointer &info) const
     return emblemList;
 }
 
-QMap<int, QIcon> GioEmblemWorker::getGioEmblems(const FileInfoPointer &info) const
+QMap<int, QIcon> GioEmblemWorker::getGioEmblems(const QString &emblemsStr) const
 {
     QMap<int, QIcon> emblemsMap;
 
-    if (!info)
-        return {};
-    const QStringList &emblemData = info->customAttribute("metadata::emblems", DFileInfo::DFileAttributeType::kTypeStringV).toStringList();
-
-    if (emblemData.isEmpty())
+    if (emblemsStr.isEmpty())
         return emblemsMap;
 
-    const QString &emblemsStr = emblemData.first();
-
-    if (!emblemsStr.isEmpty()) {
 #if (QT_VERSION <= QT_VERSION_CHECK(5, 15, 0))
-        const QStringList &emblemsStrList = emblemsStr.split("|", QString::SkipEmptyParts);
+    const QStringList &emblemsStrList = emblemsStr.split("|", QString::SkipEmptyParts);
 #else
-        const QStringList &emblemsStrList = emblemsStr.split("|", Qt::SkipEmptyParts);
+    const QStringList &emblemsStrList = emblemsStr.split("|", Qt::SkipEmptyParts);
 #endif
-        for (int i = 0; i < emblemsStrList.length(); i++) {
-            QString pos;
-            QIcon emblem;
-            if (parseEmblemString(&emblem, pos, emblemsStrList.at(i)))
-                setEmblemIntoIcons(pos, emblem, &emblemsMap);
-        }
-
-        return emblemsMap;
+    for (int i = 0; i < emblemsStrList.length(); i++) {
+        QIcon emblem;
+        int index = 0;
+        if (internedEmblem(emblemsStrList.at(i), &emblem, &index))
+            emblemsMap[index] = emblem;
     }
 
     return emblemsMap;
 }
 
+bool GioEmblemWorker::internedEmblem(const QString &emblemStr, QIcon *emblem, int *index) const
+{
+    auto it = emblemTable.constFind(emblemStr);
+    if (it == emblemTable.constEnd()) {
+        if (emblemTable.size() >= kMaxInternedEmblems)
+            emblemTable.clear();
+
+        QString pos;
+        QIcon icon;
+        if (!parseEmblemString(&icon, pos, emblemStr))
+            icon = QIcon();
+        // 无效的角标同样记录下来，避免反复检查图片文件
+        it = emblemTable.insert(emblemStr, qMakePair(emblemIndexOfPos(pos), icon));
+    }
+
+    if (it->second.isNull())
+        return false;
+
+    *index = it->first;
+    *emblem = it->second;
+    return true;
+}
+
 bool GioEmblemWorker::parseEmblemString(QIcon *emblem, QString &pos, const QString &emblemStr) const
 {
     // default position
@@ -155,43 +267,20 @@ bool GioEmblemWorker::parseEmblemString(QIcon *emblem, QString &pos, const QStri
     return false;
 }
 
-bool GioEmblemWorker::iconNamesEqual(const QList<QIcon> &first, const QList<QIcon> &second)
-{
-    if (first.isEmpty() && second.isEmpty())
-        return true;
-
-    if (first.size() != second.size())
-        return false;
-
-    QVector<QString> firstNames { first.size(), QString() };
-    QVector<QString> secondNames { second.size(), QString() };
-
-    std::transform(first.begin(), first.end(), firstNames.begin(), [](const QIcon &icon) {
-        return icon.name();
-    });
-
-    std::transform(second.begin(), second.end(), secondNames.begin(), [](const QIcon &icon) {
-        return icon.name();
-    });
-
-    return firstNames == secondNames;
-}
-
-void GioEmblemWorker::setEmblemIntoIcons(const QString &pos, const QIcon &emblem, QMap<int, QIcon> *iconMap) const
+int GioEmblemWorker::emblemIndexOfPos(const QString &pos) const
 {
-    int emblemIndex = 0;   // default position rd = 0, rightdown
-
+    // default position rd = 0, rightdown
     // left down
     if (pos == "ld")
-        emblemIndex = 1;
+        return 1;
     // left up
-    else if (pos == "lu")
-        emblemIndex = 2;
+    if (pos == "lu")
+        return 2;
     // right up
-    else if (pos == "ru")
-        emblemIndex = 3;
+    if (pos == "ru")
+        return 3;
 
-    (*iconMap)[emblemIndex] = emblem;
+    return 0;
 }
 
 EmblemHelper::EmblemHelper(QObject *parent)
@@ -272,8 +361,25 @@ void EmblemHelper::pending(const FileInfoPointer &info)
 {
     if (!info)
         return;
-    
-    emit requestProduce(info);
+
+    const QUrl &url = info->urlOf(UrlInfoType::kUrl);
+    if (pendingUrls.contains(url))
+        return;
+
+    pendingUrls.insert(url);
+    pendingInfos.append(info);
+    if (pendingInfos.size() == 1)
+        QTimer::singleShot(0, this, &EmblemHelper::flushPending);
+}
+
+void EmblemHelper::flushPending()
+{
+    if (pendingInfos.isEmpty())
+        return;
+
+    emit requestProduce(pendingInfos);
+    pendingInfos.clear();
+    pendingUrls.clear();
 }
 
 bool EmblemHelper::isExtEmblemProhibited(const FileInfoPointer &info, const QUrl &url)
@@ -323,6 +429,8 @@ void EmblemHelper::initialize()
     Q_ASSERT(qApp->thread() == QThread::currentThread());
     dpfSignalDispatcher->installEventFilter(GlobalEventType::kChangeCurrentUrl, this, &EmblemHelper::onUrlChanged);
 
+    qRegisterMetaType<QList<FileInfoPointer>>();
+
     worker->moveToThread(&workerThread);
     connect(this, &EmblemHelper::requestProduce, worker, &GioEmblemWorker::onProduce, Qt::QueuedConnection);
     connect(this, &EmblemHelper::requestClear, worker, &GioEmblemWorker::onClear, Qt::QueuedConnection);
@@ -11,6 +11,7 @@
 
 #include <dfm-framework/dpf.h>
 
+#include <QCache>
 #include <QIcon>
 #include <QThread>
 #include <QSet>
@@ -27,20 +28,26 @@ public:
     QList<QIcon> fetchEmblems(const FileInfoPointer &info) const;
 
 public Q_SLOTS:
-    void onProduce(const FileInfoPointer &info);
+    void onProduce(const QList<FileInfoPointer> &infos);
     void onClear();
 
 Q_SIGNALS:
     void emblemChanged(const QUrl &url, const Product &product);
 
 private:
-    QMap<int, QIcon> getGioEmblems(const FileInfoPointer &info) const;
+    QHash<QUrl, QString> readEmblemAttributes(const QList<FileInfoPointer> &infos) const;
+    QString readEmblemAttribute(const FileInfoPointer &info) const;
+    QList<QIcon> makeEmblems(const QString &emblemsStr) const;
+    QMap<int, QIcon> getGioEmblems(const QString &emblemsStr) const;
+    bool internedEmblem(const QString &emblemStr, QIcon *emblem, int *index) const;
     bool parseEmblemString(QIcon *emblem, QString &pos, const QString &emblemStr) const;
-    bool iconNamesEqual(const QList<QIcon> &first, const QList<QIcon> &second);
-    void setEmblemIntoIcons(const QString &pos, const QIcon &emblem, QMap<int, QIcon> *iconMap) const;
+    int emblemIndexOfPos(const QString &pos) const;
 
 private:
-    ProductQueue cache;
+    // 每个文件上次读到的 metadata::emblems 原始值，未变化时不再重复生成角标
+    QCache<QUrl, QString> cache { kMaxCachedEmblemFiles };
+    // 同一角标字符串（图片路径与位置）只解析一次，所有文件共享同一个 QIcon
+    mutable QHash<QString, QPair<int, QIcon>> emblemTable;
 };
 
 class EmblemHelper : public QObject
@@ -52,7 +59,12 @@ public:
     ~EmblemHelper() override;
 
     inline bool hasEmblem(const QUrl &url) const { return productQueue.contains(url); }
-    inline void clearEmblem() { productQueue.clear(); }
+    inline void clearEmblem()
+    {
+        productQueue.clear();
+        pendingInfos.clear();
+        pendingUrls.clear();
+    }
 
     QList<QIcon> systemEmblems(const FileInfoPointer &info) const;
     QList<QRectF> emblemRects(const QRectF &paintArea) const;
@@ -61,12 +73,13 @@ public:
     bool isExtEmblemProhibited(const FileInfoPointer &info, const QUrl &url);
 
 Q_SIGNALS:
-    void requestProduce(const FileInfoPointer &info);
+    void requestProduce(const QList<FileInfoPointer> &infos);
     void requestClear();
 
 private Q_SLOTS:
     void onEmblemChanged(const QUrl &url, const Product &product);
     bool onUrlChanged(quint64 windowId, const QUrl &url);
+    void flushPending();
 
 private:
     void initialize();
@@ -75,6 +88,9 @@ private:
 private:
     GioEmblemWorker *worker { new GioEmblemWorker };
     ProductQueue productQueue;
+    // 绘制时逐个提交的请求合并到一起，回到事件循环后整批交给工作线程
+    QList<FileInfoPointer> pendingInfos;
+    QSet<QUrl> pendingUrls;
     QThread workerThread;
 };
 
@@ -609,7 +609,8 @@ void AbstractWorker::startAsyncStatistics(const QList<QUrl> &urls)
         // Call scanSyncWithCallback with progress callback
         auto result = DFMBASE_NAMESPACE::FileScanner::scanSyncWithCallback(
                 urls,
-                DFMBASE_NAMESPACE::FileScanner::ScanOption::IncludeSource,
+                DFMBASE_NAMESPACE::FileScanner::ScanOption::IncludeSource
+                        | DFMBASE_NAMESPACE::FileScanner::ScanOption::Parallel,
                 progressCallback);
 
         // Only update data if not stopped
@@ -8,6 +8,7 @@
 #include <dfm-base/base/standardpaths.h>
 #include <dfm-base/base/urlroute.h>
 #include <dfm-base/utils/universalutils.h>
+#include <dfm-base/utils/trashindex.h>
 
 #include <dfm-io/dfmio_utils.h>
 #include <dfm-io/denumerator.h>
@@ -281,8 +282,12 @@ DFileInfoPointer DoRestoreTrashFilesWorker::checkRestoreInfo(const QUrl &url)
 
         QUrl restoreFileUrl;
         if (!this->targetUrl.isValid()) {
-            // 获取回收站文件的原路径
-            restoreFileUrl = QUrl::fromLocalFile(fileInfo->attribute(DFileInfo::AttributeID::kTrashOrigPath).toString());
+            // 获取回收站文件的原路径，顶层条目优先从本地索引读取，避免经过 gvfsd-trash
+            DFMBASE_NAMESPACE::TrashIndex::Entry entry;
+            if (DFMBASE_NAMESPACE::TrashIndex::instance()->find(url, &entry))
+                restoreFileUrl = QUrl::fromLocalFile(entry.originPath);
+            else
+                restoreFileUrl = QUrl::fromLocalFile(fileInfo->attribute(DFileInfo::AttributeID::kTrashOrigPath).toString());
             if (!restoreFileUrl.isValid()) {
                 fmWarning() << "Failed to get restore path from trash - url:" << url << "origPath:" << fileInfo->attribute(DFileInfo::AttributeID::kTrashOrigPath).toString();
                 action = doHandleErrorAndWait(url, restoreFileUrl, AbstractJobHandler::JobErrorType::kGetRestorePathError);
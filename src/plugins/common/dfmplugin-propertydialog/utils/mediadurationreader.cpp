@@ -0,0 +1,476 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "mediadurationreader.h"
+
+#include <QtEndian>
+
+#include <cstring>
+
+DPPROPERTYDIALOG_USE_NAMESPACE
+
+namespace {
+constexpr int kMaxBoxes { 4096 };   // 防止损坏的文件导致长时间遍历
+constexpr int kMaxElements { 256 };
+constexpr int kMaxChunks { 64 };
+constexpr qint64 kOggTailSize { 65536 };   // Ogg 页最大约 64KB，最后一页必然落在这个范围内
+constexpr qint64 kMp3SyncSearchSize { 4096 };
+
+// Matroska 元素 ID（含长度标记位）
+constexpr quint32 kEbmlHeaderId { 0x1A45DFA3 };
+constexpr quint32 kSegmentId { 0x18538067 };
+constexpr quint32 kInfoId { 0x1549A966 };
+constexpr quint32 kClusterId { 0x1F43B675 };
+constexpr quint32 kTimestampScaleId { 0x2AD7B1 };
+constexpr quint32 kDurationId { 0x4489 };
+
+// MPEG 音频码率表（kbps），下标为帧头中的码率索引
+constexpr int kMpeg1Layer1Bitrates[] { 0, 32, 64, 96, 128, 160, 192, 224, 256, 288, 320, 352, 384, 416, 448 };
+constexpr int kMpeg1Layer2Bitrates[] { 0, 32, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384 };
+constexpr int kMpeg1Layer3Bitrates[] { 0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320 };
+constexpr int kMpeg2Layer1Bitrates[] { 0, 32, 48, 56, 64, 80, 96, 112, 128, 144, 160, 176, 192, 224, 256 };
+constexpr int kMpeg2Layer23Bitrates[] { 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160 };
+constexpr int kMpeg1SampleRates[] { 44100, 48000, 32000 };
+
+inline quint16 le16(const char *p)
+{
+    return qFromLittleEndian<quint16>(reinterpret_cast<const uchar *>(p));
+}
+
+inline quint32 le32(const char *p)
+{
+    return qFromLittleEndian<quint32>(reinterpret_cast<const uchar *>(p));
+}
+
+inline qint64 le64(const char *p)
+{
+    return qFromLittleEndian<qint64>(reinterpret_cast<const uchar *>(p));
+}
+
+inline quint32 be32(const char *p)
+{
+    return qFromBigEndian<quint32>(reinterpret_cast<const uchar *>(p));
+}
+
+inline quint64 be64(const char *p)
+{
+    return qFromBigEndian<quint64>(reinterpret_cast<const uchar *>(p));
+}
+
+inline quint64 beN(const char *p, int len)
+{
+    quint64 value = 0;
+    for (int i = 0; i < len; ++i)
+        value = (value << 8) | static_cast<uchar>(p[i]);
+    return value;
+}
+
+// 避免 duration * 1000 溢出
+inline qint64 toMSecs(quint64 duration, quint64 timescale)
+{
+    return static_cast<qint64>(duration / timescale * 1000 + duration % timescale * 1000 / timescale);
+}
+
+// EBML 变长整数的字节数，由首字节前导 0 的个数决定
+inline int vintLength(uchar first)
+{
+    int len = 1;
+    for (uchar mask = 0x80; mask && !(first & mask); mask >>= 1)
+        ++len;
+    return len;
+}
+}   // namespace
+
+qint64 MediaDurationReader::readDuration(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return -1;
+
+    MediaDurationReader reader(&file);
+    char head[12];
+    if (!reader.readAt(0, head, sizeof(head)))
+        return -1;
+
+    static const char *const kMp4TopBoxes[] { "ftyp", "moov", "mdat", "free", "skip", "wide" };
+    for (const char *type : kMp4TopBoxes) {
+        if (memcmp(head + 4, type, 4) == 0)
+            return reader.readMp4();
+    }
+
+    if (be32(head) == kEbmlHeaderId)
+        return reader.readMatroska();
+    if (memcmp(head, "RIFF", 4) == 0 && memcmp(head + 8, "WAVE", 4) == 0)
+        return reader.readWav();
+    if (memcmp(head, "OggS", 4) == 0)
+        return reader.readOgg();
+
+    // FLAC 与 MP3 前面都可能有 ID3v2 标签
+    qint64 offset = 0;
+    const bool hasId3 = memcmp(head, "ID3", 3) == 0;
+    if (hasId3) {
+        qint64 tagSize = 0;
+        for (int i = 6; i < 10; ++i)
+            tagSize = (tagSize << 7) | (static_cast<uchar>(head[i]) & 0x7F);
+        offset = 10 + tagSize + ((head[5] & 0x10) ? 10 : 0);
+    }
+
+    char magic[4];
+    if (!reader.readAt(offset, magic, sizeof(magic)))
+        return -1;
+    if (memcmp(magic, "fLaC", 4) == 0)
+        return reader.readFlac(offset);
+
+    return reader.readMp3(offset, hasId3);
+}
+
+MediaDurationReader::MediaDurationReader(QFile *file)
+    : file(file), fileSize(file->size())
+{
+}
+
+qint64 MediaDurationReader::readMp4()
+{
+    qint64 moov = 0, moovEnd = 0;
+    if (!findBox(0, fileSize, "moov", &moov, &moovEnd))
+        return -1;
+
+    qint64 mvhd = 0, mvhdEnd = 0;
+    if (!findBox(moov, moovEnd, "mvhd", &mvhd, &mvhdEnd))
+        return -1;
+
+    // version(1) flags(3)，之后的创建/修改时间在 version 1 中为 64 位
+    char data[32];
+    if (!readAt(mvhd, data, 1))
+        return -1;
+
+    quint64 timescale = 0;
+    quint64 duration = 0;
+    if (data[0] == 1) {
+        if (mvhdEnd - mvhd < 32 || !readAt(mvhd, data, 32))
+            return -1;
+        timescale = be32(data + 20);
+        duration = be64(data + 24);
+        if (duration == ~quint64(0))
+            return -1;
+    } else {
+        if (mvhdEnd - mvhd < 20 || !readAt(mvhd, data, 20))
+            return -1;
+        timescale = be32(data + 12);
+        duration = be32(data + 16);
+        if (duration == 0xFFFFFFFF)
+            return -1;
+    }
+
+    if (timescale == 0 || duration == 0)
+        return -1;
+
+    return toMSecs(duration, timescale);
+}
+
+qint64 MediaDurationReader::readMatroska()
+{
+    quint32 id = 0;
+    qint64 dataPos = 0, dataSize = 0;
+    if (!readElement(0, &id, &dataPos, &dataSize) || id != kEbmlHeaderId || dataSize < 0)
+        return -1;
+
+    if (!readElement(dataPos + dataSize, &id, &dataPos, &dataSize) || id != kSegmentId)
+        return -1;
+
+    // 直播录制的文件 Segment 长度可能未知
+    const qint64 segmentEnd = dataSize < 0 ? fileSize : qMin(fileSize, dataPos + dataSize);
+    qint64 pos = dataPos;
+    for (int i = 0; i < kMaxElements && pos < segmentEnd; ++i) {
+        if (!readElement(pos, &id, &dataPos, &dataSize) || dataSize < 0 || id == kClusterId)
+            return -1;
+
+        if (id != kInfoId) {
+            pos = dataPos + dataSize;
+            continue;
+        }
+
+        quint64 timestampScale = 1000000;   // 默认单位为 1ms
+        double duration = -1;
+        const qint64 infoEnd = dataPos + dataSize;
+        qint64 child = dataPos;
+        for (int j = 0; j < kMaxElements && child < infoEnd; ++j) {
+            quint32 childId = 0;
+            qint64 childPos = 0, childSize = 0;
+            if (!readElement(child, &childId, &childPos, &childSize) || childSize < 0)
+                break;
+
+            char value[8];
+            if (childId == kTimestampScaleId && childSize >= 1 && childSize <= 8) {
+                if (readAt(childPos, value, childSize))
+                    timestampScale = beN(value, static_cast<int>(childSize));
+            } else if (childId == kDurationId && childSize == 4) {
+                if (readAt(childPos, value, 4)) {
+                    const quint32 bits = be32(value);
+                    float f;
+                    memcpy(&f, &bits, sizeof(f));
+                    duration = f;
+                }
+            } else if (childId == kDurationId && childSize == 8) {
+                if (readAt(childPos, value, 8)) {
+                    const quint64 bits = be64(value);
+                    memcpy(&duration, &bits, sizeof(duration));
+                }
+            }
+            child = childPos + childSize;
+        }
+
+        if (!(duration > 0) || timestampScale == 0)
+            return -1;
+        return static_cast<qint64>(duration * static_cast<double>(timestampScale) / 1000000.0);
+    }
+
+    return -1;
+}
+
+qint64 MediaDurationReader::readWav()
+{
+    quint16 format = 0;
+    quint32 sampleRate = 0;
+    quint32 byteRate = 0;
+    quint32 factSamples = 0;
+    bool hasFormat = false;
+
+    qint64 pos = 12;
+    for (int i = 0; i < kMaxChunks && pos + 8 <= fileSize; ++i) {
+        char chunk[16];
+        if (!readAt(pos, chunk, 8))
+            return -1;
+        const quint32 size = le32(chunk + 4);
+
+        if (memcmp(chunk, "fmt ", 4) == 0) {
+            if (size < 16 || !readAt(pos + 8, chunk, 16))
+                return -1;
+            format = le16(chunk);
+            sampleRate = le32(chunk + 4);
+            byteRate = le32(chunk + 8);
+            hasFormat = true;
+        } else if (memcmp(chunk, "fact", 4) == 0) {
+            if (size >= 4 && readAt(pos + 8, chunk, 4))
+                factSamples = le32(chunk);
+        } else if (memcmp(chunk, "data", 4) == 0) {
+            if (!hasFormat)
+                return -1;
+
+            // 录制中断或流式写入的文件 data 长度可能不准确
+            qint64 dataSize = size;
+            if (size == 0xFFFFFFFF || pos + 8 + dataSize > fileSize)
+                dataSize = fileSize - pos - 8;
+
+            // 压缩格式的字节率不可靠，优先使用 fact 中的采样数
+            const bool isPcm = format == 1 || format == 3 || format == 0xFFFE;
+            if (!isPcm && factSamples > 0 && sampleRate > 0)
+                return toMSecs(factSamples, sampleRate);
+            if (byteRate == 0)
+                return -1;
+            return toMSecs(static_cast<quint64>(dataSize), byteRate);
+        }
+
+        pos += 8 + static_cast<qint64>(size) + (size & 1);
+    }
+
+    return -1;
+}
+
+qint64 MediaDurationReader::readOgg()
+{
+    // 首页给出编码格式和采样率，最后一页的 granule position 即总采样数
+    char head[27];
+    if (!readAt(0, head, sizeof(head)))
+        return -1;
+
+    const quint32 serial = le32(head + 14);
+    const int segments = static_cast<uchar>(head[26]);
+    char packet[19];
+    if (!readAt(27 + segments, packet, sizeof(packet)))
+        return -1;
+
+    quint32 sampleRate = 0;
+    qint64 preSkip = 0;
+    if (memcmp(packet, "\x01vorbis", 7) == 0) {
+        sampleRate = le32(packet + 12);
+    } else if (memcmp(packet, "OpusHead", 8) == 0) {
+        sampleRate = 48000;   // Opus 的 granule 固定按 48kHz 计
+        preSkip = le16(packet + 10);
+    }
+    if (sampleRate == 0)
+        return -1;
+
+    const qint64 tailSize = qMin(fileSize, kOggTailSize);
+    QByteArray tail(static_cast<int>(tailSize), Qt::Uninitialized);
+    if (!readAt(fileSize - tailSize, tail.data(), tailSize))
+        return -1;
+
+    for (int idx = tail.lastIndexOf("OggS"); idx >= 0; idx = idx > 0 ? tail.lastIndexOf("OggS", idx - 1) : -1) {
+        if (idx + 27 > tail.size() || le32(tail.constData() + idx + 14) != serial)
+            continue;
+
+        const qint64 granule = le64(tail.constData() + idx + 6);
+        if (granule < 0)
+            continue;
+        return toMSecs(static_cast<quint64>(qMax<qint64>(0, granule - preSkip)), sampleRate);
+    }
+
+    return -1;
+}
+
+qint64 MediaDurationReader::readFlac(qint64 offset)
+{
+    // STREAMINFO 必须是第一个元数据块
+    char data[26];
+    if (!readAt(offset, data, sizeof(data)))
+        return -1;
+    if ((data[4] & 0x7F) != 0 || beN(data + 5, 3) < 34)
+        return -1;
+
+    const char *info = data + 8;
+    const quint32 sampleRate = (static_cast<uchar>(info[10]) << 12) | (static_cast<uchar>(info[11]) << 4)
+            | (static_cast<uchar>(info[12]) >> 4);
+    const quint64 totalSamples = (static_cast<quint64>(static_cast<uchar>(info[13]) & 0x0F) << 32) | be32(info + 14);
+    if (sampleRate == 0 || totalSamples == 0)
+        return -1;
+
+    return toMSecs(totalSamples, sampleRate);
+}
+
+qint64 MediaDurationReader::readMp3(qint64 offset, bool hasId3)
+{
+    // 没有 ID3 标签时只接受文件开头的帧同步，避免把其他二进制文件误认为 MP3
+    const qint64 searchSize = qMin(fileSize - offset, hasId3 ? kMp3SyncSearchSize : 4);
+    if (searchSize < 4)
+        return -1;
+
+    QByteArray buffer(static_cast<int>(searchSize), Qt::Uninitialized);
+    if (!readAt(offset, buffer.data(), searchSize))
+        return -1;
+
+    for (int i = 0; i + 4 <= buffer.size(); ++i) {
+        const uchar *h = reinterpret_cast<const uchar *>(buffer.constData() + i);
+        if (h[0] != 0xFF || (h[1] & 0xE0) != 0xE0)
+            continue;
+
+        const int version = (h[1] >> 3) & 0x03;   // 0: MPEG2.5, 2: MPEG2, 3: MPEG1
+        const int layer = (h[1] >> 1) & 0x03;   // 1: Layer III, 2: Layer II, 3: Layer I
+        const int bitrateIndex = h[2] >> 4;
+        const int sampleRateIndex = (h[2] >> 2) & 0x03;
+        if (version == 1 || layer == 0 || bitrateIndex == 15 || sampleRateIndex == 3)
+            continue;
+
+        const bool mpeg1 = version == 3;
+        const bool mono = (h[3] >> 6) == 3;
+        const int sampleRate = kMpeg1SampleRates[sampleRateIndex] >> (mpeg1 ? 0 : (version == 2 ? 1 : 2));
+        const int samplesPerFrame = layer == 3 ? 384 : (layer == 2 || mpeg1 ? 1152 : 576);
+
+        int bitrate = 0;
+        if (mpeg1)
+            bitrate = layer == 3 ? kMpeg1Layer1Bitrates[bitrateIndex] : (layer == 2 ? kMpeg1Layer2Bitrates[bitrateIndex] : kMpeg1Layer3Bitrates[bitrateIndex]);
+        else
+            bitrate = layer == 3 ? kMpeg2Layer1Bitrates[bitrateIndex] : kMpeg2Layer23Bitrates[bitrateIndex];
+
+        // VBR 文件首帧中的 Xing/Info 或 VBRI 头记录了总帧数
+        const qint64 frameStart = offset + i;
+        const int sideInfoSize = mpeg1 ? (mono ? 17 : 32) : (mono ? 9 : 17);
+        char frame[4 + 32 + 26];
+        quint32 frames = 0;
+        if (readAt(frameStart, frame, sizeof(frame))) {
+            const char *xing = frame + 4 + sideInfoSize;
+            const char *vbri = frame + 4 + 32;
+            if ((memcmp(xing, "Xing", 4) == 0 || memcmp(xing, "Info", 4) == 0) && (be32(xing + 4) & 0x01))
+                frames = be32(xing + 8);
+            else if (memcmp(vbri, "VBRI", 4) == 0)
+                frames = be32(vbri + 14);
+        }
+
+        if (frames > 0)
+            return toMSecs(static_cast<quint64>(frames) * samplesPerFrame, sampleRate);
+
+        // 没有 VBR 头时按 CBR 估算，去掉末尾的 ID3v1 标签
+        if (bitrate == 0)
+            return -1;
+
+        qint64 audioSize = fileSize - frameStart;
+        char tag[3];
+        if (fileSize >= 128 && readAt(fileSize - 128, tag, sizeof(tag)) && memcmp(tag, "TAG", 3) == 0)
+            audioSize -= 128;
+        // 字节数 * 8 / kbps 即为毫秒数
+        return audioSize > 0 ? audioSize * 8 / bitrate : -1;
+    }
+
+    return -1;
+}
+
+bool MediaDurationReader::findBox(qint64 from, qint64 to, const char *type, qint64 *payload, qint64 *payloadEnd)
+{
+    qint64 pos = from;
+    for (int i = 0; i < kMaxBoxes && pos + 8 <= to; ++i) {
+        char header[16];
+        if (!readAt(pos, header, 8))
+            return false;
+
+        qint64 size = be32(header);
+        qint64 headerSize = 8;
+        if (size == 1) {
+            if (!readAt(pos + 8, header + 8, 8))
+                return false;
+            size = static_cast<qint64>(be64(header + 8));
+            headerSize = 16;
+        } else if (size == 0) {
+            size = to - pos;   // 延伸到文件末尾
+        }
+
+        if (size < headerSize)
+            return false;
+
+        if (memcmp(header + 4, type, 4) == 0) {
+            *payload = pos + headerSize;
+            *payloadEnd = qMin(to, pos + size);
+            return true;
+        }
+        pos += size;
+    }
+
+    return false;
+}
+
+bool MediaDurationReader::readElement(qint64 pos, quint32 *id, qint64 *dataPos, qint64 *dataSize)
+{
+    char header[12];
+    const qint64 len = qMin<qint64>(sizeof(header), fileSize - pos);
+    if (len < 2 || !readAt(pos, header, len))
+        return false;
+
+    const int idLength = vintLength(static_cast<uchar>(header[0]));
+    if (idLength > 4 || idLength >= len)
+        return false;
+
+    const uchar first = static_cast<uchar>(header[idLength]);
+    const int sizeLength = vintLength(first);
+    if (sizeLength > 8 || idLength + sizeLength > len)
+        return false;
+
+    quint64 size = first & (0xFF >> sizeLength);
+    bool allOnes = size == (0xFFu >> sizeLength);
+    for (int i = 1; i < sizeLength; ++i) {
+        const uchar byte = static_cast<uchar>(header[idLength + i]);
+        size = (size << 8) | byte;
+        allOnes = allOnes && byte == 0xFF;
+    }
+
+    *id = static_cast<quint32>(beN(header, idLength));
+    *dataPos = pos + idLength + sizeLength;
+    *dataSize = allOnes ? -1 : static_cast<qint64>(size);
+    return true;
+}
+
+bool MediaDurationReader::readAt(qint64 pos, char *data, qint64 len)
+{
+    if (pos < 0 || len < 0 || pos + len > fileSize || !file->seek(pos))
+        return false;
+    return file->read(data, len) == len;
+}
@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef MEDIADURATIONREADER_H
+#define MEDIADURATIONREADER_H
+
+#include "dfmplugin_propertydialog_global.h"
+
+#include <QFile>
+
+namespace dfmplugin_propertydialog {
+
+// 从常见容器的头部读取媒体时长，只读取少量字节，不解码：
+// MP4/MOV 的 mvhd、Matroska/WebM 的 Segment Info、WAV 的 fmt/data、FLAC 的 STREAMINFO、
+// Ogg Vorbis/Opus 的首尾页，以及 MP3 的 Xing/Info/VBRI 头（没有时按 CBR 估算）。
+class MediaDurationReader
+{
+public:
+    // 返回毫秒数，格式不认识或头部不完整时返回 -1
+    static qint64 readDuration(const QString &filePath);
+
+private:
+    explicit MediaDurationReader(QFile *file);
+
+    qint64 readMp4();
+    qint64 readMatroska();
+    qint64 readWav();
+    qint64 readOgg();
+    qint64 readFlac(qint64 offset);
+    qint64 readMp3(qint64 offset, bool hasId3);
+
+    bool findBox(qint64 from, qint64 to, const char *type, qint64 *payload, qint64 *payloadEnd);
+    bool readElement(qint64 pos, quint32 *id, qint64 *dataPos, qint64 *dataSize);
+    bool readAt(qint64 pos, char *data, qint64 len);
+
+    QFile *file { nullptr };
+    qint64 fileSize { 0 };
+};
+
+}
+
+#endif   // MEDIADURATIONREADER_H
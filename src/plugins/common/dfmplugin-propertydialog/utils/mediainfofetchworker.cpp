@@ -3,29 +3,112 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "mediainfofetchworker.h"
+#include "mediadurationreader.h"
 
+#include <QCache>
+#include <QFile>
+#include <QMutex>
 #include <QProcess>
 #include <QStandardPaths>
 #include <QRegularExpression>
 
+#include <sys/stat.h>
+
 DPPROPERTYDIALOG_USE_NAMESPACE
 
+namespace {
+constexpr int kMaxCachedDurations { 512 };
+
+// 按 (设备, inode) 缓存，修改时间或大小变化后失效；每个属性窗口有各自的工作线程，缓存在进程内共享
+struct CachedDuration
+{
+    qint64 mtimeNs { 0 };
+    qint64 size { 0 };
+    QString duration;   // 为空表示无法获取时长
+};
+
+using DurationKey = QPair<quint64, quint64>;
+
+QMutex &durationCacheMutex()
+{
+    static QMutex mutex;
+    return mutex;
+}
+
+QCache<DurationKey, CachedDuration> &durationCache()
+{
+    static QCache<DurationKey, CachedDuration> cache(kMaxCachedDurations);
+    return cache;
+}
+
+QString formatDuration(qint64 msecs)
+{
+    const qint64 secs = msecs / 1000;
+    return QString("%1:%2:%3")
+            .arg(secs / 3600, 2, 10, QChar('0'))
+            .arg(secs / 60 % 60, 2, 10, QChar('0'))
+            .arg(secs % 60, 2, 10, QChar('0'));
+}
+}   // namespace
+
 MediaInfoFetchWorker::MediaInfoFetchWorker(QObject *parent)
     : QObject(parent)
 {
 }
 
 void MediaInfoFetchWorker::getDuration(const QString &filePath)
+{
+    struct stat st {};
+    const bool hasStat = ::stat(QFile::encodeName(filePath).constData(), &st) == 0;
+    const DurationKey key { static_cast<quint64>(st.st_dev), static_cast<quint64>(st.st_ino) };
+    const qint64 mtimeNs = static_cast<qint64>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+
+    if (hasStat) {
+        QMutexLocker locker(&durationCacheMutex());
+        const CachedDuration *cached = durationCache().object(key);
+        if (cached && cached->mtimeNs == mtimeNs && cached->size == st.st_size) {
+            const QString duration = cached->duration;
+            locker.unlock();
+            if (!duration.isEmpty())
+                Q_EMIT durationReady(duration);
+            return;
+        }
+    }
+
+    // 常见格式直接读取文件头，其他格式才启动 ffmpeg
+    QString duration;
+    const qint64 msecs = MediaDurationReader::readDuration(filePath);
+    if (msecs >= 0) {
+        duration = formatDuration(msecs);
+    } else {
+        bool timedOut = false;
+        duration = durationFromFFmpeg(filePath, &timedOut);
+        if (timedOut) {
+            Q_EMIT durationReady("");
+            return;
+        }
+    }
+
+    if (hasStat) {
+        QMutexLocker locker(&durationCacheMutex());
+        durationCache().insert(key, new CachedDuration { mtimeNs, static_cast<qint64>(st.st_size), duration });
+    }
+
+    if (!duration.isEmpty())
+        Q_EMIT durationReady(duration);
+}
+
+QString MediaInfoFetchWorker::durationFromFFmpeg(const QString &filePath, bool *timedOut)
 {
     if (!hasFFmpeg())
-        return;
+        return QString();
 
     QProcess ffmpeg;
     ffmpeg.start("ffmpeg", {"-i", filePath});
     bool finished = ffmpeg.waitForFinished(5000); // 5秒超时
     if (!finished) {
-        Q_EMIT durationReady("");
-        return;
+        *timedOut = true;
+        return QString();
     }
 
     QByteArray output = ffmpeg.readAllStandardError();
@@ -33,10 +116,9 @@ void MediaInfoFetchWorker::getDuration(const QString &filePath)
     QRegularExpressionMatch match = re.match(output);
 
     if (!match.hasMatch())
-        return;
+        return QString();
 
-    QString duration = match.captured(1);
-    Q_EMIT durationReady(duration);
+    return match.captured(1);
 }
 
 bool MediaInfoFetchWorker::hasFFmpeg()
@@ -22,6 +22,7 @@ Q_SIGNALS:
     void durationReady(const QString &duration);
 
 private:
+    QString durationFromFFmpeg(const QString &filePath, bool *timedOut);
     bool hasFFmpeg();
 };
 } // namespace dfmplugin_propertydialog
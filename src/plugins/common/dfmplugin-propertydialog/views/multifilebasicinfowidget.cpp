@@ -28,7 +28,9 @@ MultiFileBasicInfoWidget::MultiFileBasicInfoWidget(const QList<QUrl> &urls,
     : DArrowLineDrawer(parent)
     , fileCalculationUtils(new FileScanner)
 {
-    fileCalculationUtils->setOptions(FileScanner::ScanOption::IncludeSource);
+    fileCalculationUtils->setOptions(FileScanner::ScanOption::IncludeSource
+                                     | FileScanner::ScanOption::Parallel
+                                     | FileScanner::ScanOption::UseSizeCache);
     initUI();
     loadData(urls);
 }
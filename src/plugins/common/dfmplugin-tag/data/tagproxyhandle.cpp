@@ -198,6 +198,15 @@ bool TagProxyHandle::changeFilePaths(const QVariantMap &value)
     return reply.value();
 }
 
+bool TagProxyHandle::setTagsOfFiles(const QVariantMap &value)
+{
+    auto &&reply = d->tagDBusInterface->Update(int(UpdateOpts::kTagsOfFiles), value);
+    reply.waitForFinished();
+    if (!reply.isValid())
+        return {};
+    return reply.value();
+}
+
 bool TagProxyHandle::deleteTags(const QVariantMap &value)
 {
     if (value.isEmpty())
@@ -33,6 +33,7 @@ public:
     bool changeTagsColor(const QVariantMap &value);
     bool changeTagNamesWithFiles(const QVariantMap &value);
     bool changeFilePaths(const QVariantMap &value);
+    bool setTagsOfFiles(const QVariantMap &value);
 
     bool deleteTags(const QVariantMap &value);
     bool deleteFiles(const QVariantMap &value);
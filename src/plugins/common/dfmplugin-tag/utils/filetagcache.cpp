@@ -12,6 +12,8 @@
 #include <QDebug>
 #include <QSet>
 
+#include <algorithm>
+
 DPTAG_USE_NAMESPACE
 
 FileTagCacheWorker::FileTagCacheWorker(QObject *parent)
@@ -49,9 +51,6 @@ void FileTagCacheWorker::onTagsColorChanged(const QVariantMap &tagAndColorName)
 void FileTagCacheWorker::onTagsNameChanged(const QVariantMap &oldAndNew)
 {
     FileTagCache::instance().changeTagName(oldAndNew);
-    auto &&map { oldAndNew.toStdMap() };
-    for (auto [oldName, newName] : map)
-        FileTagCache::instance().changeFilesTagName(oldName, newName.toString());
     emit FileTagCacheIns.tagsNameChanged(oldAndNew);
 }
 
@@ -81,6 +80,85 @@ FileTagCachePrivate::~FileTagCachePrivate()
 {
 }
 
+int FileTagCachePrivate::internTag(const QString &name)
+{
+    auto it = tagIds.constFind(name);
+    if (it != tagIds.constEnd())
+        return it.value();
+
+    const int id = tagTable.size();
+    TagEntry entry;
+    entry.name = name;
+    tagTable.append(entry);
+    tagIds.insert(name, id);
+    updateTagRanks();
+    return id;
+}
+
+void FileTagCachePrivate::updateTagRanks()
+{
+    // painting orders the colors by tag name, keep the order precomputed
+    QStringList names = tagIds.keys();
+    names.sort();
+    for (int i = 0; i < names.size(); ++i)
+        tagTable[tagIds.value(names.at(i))].rank = i;
+}
+
+QStringList FileTagCachePrivate::tagNames(const TagIds &ids) const
+{
+    QStringList names;
+    for (int id : ids) {
+        const TagEntry &entry = tagTable.at(id);
+        if (!entry.removed)
+            names.append(entry.name);
+    }
+    return names;
+}
+
+const FileTagCachePrivate::TagIds *FileTagCachePrivate::findFile(const QString &path) const
+{
+    QString dir, name;
+    if (!splitPath(path, &dir, &name))
+        return nullptr;
+
+    auto dirIt = filesByDir.constFind(dir);
+    if (dirIt == filesByDir.constEnd())
+        return nullptr;
+
+    auto fileIt = dirIt->constFind(name);
+    return fileIt == dirIt->constEnd() ? nullptr : &fileIt.value();
+}
+
+void FileTagCachePrivate::setFileTags(const QString &path, const TagIds &ids)
+{
+    QString dir, name;
+    if (!splitPath(path, &dir, &name))
+        return;
+
+    if (!ids.isEmpty()) {
+        filesByDir[dir].insert(name, ids);
+        return;
+    }
+
+    auto dirIt = filesByDir.find(dir);
+    if (dirIt == filesByDir.end())
+        return;
+    dirIt->remove(name);
+    if (dirIt->isEmpty())
+        filesByDir.erase(dirIt);
+}
+
+bool FileTagCachePrivate::splitPath(const QString &path, QString *dir, QString *name)
+{
+    const int slash = path.lastIndexOf('/');
+    if (slash < 0 || slash == path.size() - 1)
+        return false;
+
+    *dir = slash == 0 ? QStringLiteral("/") : path.left(slash);
+    *name = path.mid(slash + 1);
+    return true;
+}
+
 FileTagCache::FileTagCache(QObject *parent)
     : QObject(parent), d(new FileTagCachePrivate(this))
 {
@@ -96,101 +174,128 @@ void FileTagCache::loadFileTagsFromDatabase()
 {
     fmInfo() << "Start initilize FileTagCache";
     // 加载数据库所有文件标记,和标记属性到缓存
-    if (!TagProxyHandle::instance()->isValid())
+    const bool valid = TagProxyHandle::instance()->isValid();
+    if (!valid)
         fmWarning() << "tagService is inValid";
-    d->fileTagsCache = TagProxyHandle::instance()->getAllFileWithTags();
+    const auto &fileTags = TagProxyHandle::instance()->getAllFileWithTags();
     const auto &tagsColor = TagProxyHandle::instance()->getAllTags();
-    auto it = tagsColor.begin();
-    for (; it != tagsColor.end(); ++it)
-        d->tagProperty.insert(it.key(), QColor(it.value().toString()));
-
     // 加载回收站标记数据
-    d->trashFileTagsCache = TagProxyHandle::instance()->getAllTrashFileTags();
+    const auto &trashFileTags = TagProxyHandle::instance()->getAllTrashFileTags();
+
+    QWriteLocker locker(&d->lock);
+    d->tagTable.clear();
+    d->tagIds.clear();
+    d->filesByDir.clear();
+
+    for (auto it = tagsColor.begin(); it != tagsColor.end(); ++it) {
+        const int id = d->internTag(it.key());
+        d->tagTable[id].color = QColor(it.value().toString());
+    }
+
+    for (auto it = fileTags.begin(); it != fileTags.end(); ++it) {
+        FileTagCachePrivate::TagIds ids;
+        for (const QString &tag : it.value().toStringList())
+            ids.append(d->internTag(tag));
+        d->setFileTags(it.key(), ids);
+    }
+
+    d->trashFileTagsCache = trashFileTags;
+    d->loaded = valid;
 }
 
 void FileTagCache::addTags(const QVariantMap &tags)
 {
-    auto it = tags.begin();
-    for (; it != tags.end(); ++it) {
-        if (d->tagProperty.contains(it.key()))
-            continue;
-        d->tagProperty.insert(it.key(), QColor(it.value().toString()));
+    QWriteLocker locker(&d->lock);
+    for (auto it = tags.begin(); it != tags.end(); ++it) {
+        auto &entry = d->tagTable[d->internTag(it.key())];
+        if (!entry.color.isValid())
+            entry.color = QColor(it.value().toString());
     }
 }
 
 void FileTagCache::deleteTags(const QStringList &tags)
 {
-    QVariantMap map {};
+    // 文件上残留的标记 id 在读取时过滤，不再遍历所有文件
+    QWriteLocker locker(&d->lock);
     for (const QString &tag : tags) {
-        d->tagProperty.remove(tag);
-
-        auto iter = d->fileTagsCache.begin();
-        while (iter != d->fileTagsCache.end()) {
-            if (iter.value().toStringList().contains(tag)) {
-                QStringList fileTags = map[iter.key()].toStringList();
-                fileTags.append(tag);
-                map[iter.key()] = fileTags;
-            }
-
-            ++iter;
-        }
+        auto it = d->tagIds.find(tag);
+        if (it == d->tagIds.end())
+            continue;
+        d->tagTable[it.value()].removed = true;
+        d->tagIds.erase(it);
     }
-
-    if (!map.isEmpty())
-        untaggeFiles(map);
+    d->updateTagRanks();
 }
 
 void FileTagCache::changeTagColor(const QVariantMap &tagAndColorName)
 {
-    auto it = tagAndColorName.begin();
-    for (; it != tagAndColorName.end(); ++it) {
-        if (d->tagProperty.contains(it.key()))
-            d->tagProperty[it.key()] = QColor(it.value().toString());
+    QWriteLocker locker(&d->lock);
+    for (auto it = tagAndColorName.begin(); it != tagAndColorName.end(); ++it) {
+        auto id = d->tagIds.constFind(it.key());
+        if (id != d->tagIds.constEnd())
+            d->tagTable[id.value()].color = QColor(it.value().toString());
     }
 }
 
 void FileTagCache::changeTagName(const QVariantMap &oldAndNew)
 {
-    auto it = oldAndNew.begin();
-    for (; it != oldAndNew.end(); ++it) {
+    QWriteLocker locker(&d->lock);
+    for (auto it = oldAndNew.begin(); it != oldAndNew.end(); ++it) {
         const QString &oldName { it.key() };
         const QString &newName { it.value().toString() };
-        if (d->tagProperty.contains(oldName)) {
-            const auto &color { d->tagProperty.value(oldName) };
-            d->tagProperty.remove(oldName);
-            d->tagProperty.insert(newName, color);
+        auto oldId = d->tagIds.find(oldName);
+        if (oldId == d->tagIds.end() || oldName == newName)
+            continue;
+
+        const int id = oldId.value();
+        d->tagIds.erase(oldId);
+
+        auto newId = d->tagIds.constFind(newName);
+        if (newId == d->tagIds.constEnd()) {
+            // 文件只引用 id，改名只需修改标记表
+            d->tagTable[id].name = newName;
+            d->tagIds.insert(newName, id);
+            continue;
         }
-    }
-}
 
-void FileTagCache::changeFilesTagName(const QString &oldName, const QString &newName)
-{
-    std::for_each(d->fileTagsCache.begin(), d->fileTagsCache.end(), [oldName, newName](QVariant &var) {
-        QStringList tagNames { var.toStringList() };
-        auto result { std::find(tagNames.begin(), tagNames.end(), oldName) };
-        if (result != tagNames.end()) {
-            int index { result - tagNames.begin() };
-            tagNames.replace(index, newName);
-            var.setValue(tagNames);
+        // 改为已存在的名称时合并两个标记
+        const int target = newId.value();
+        d->tagTable[id].removed = true;
+        for (auto dirIt = d->filesByDir.begin(); dirIt != d->filesByDir.end(); ++dirIt) {
+            for (auto fileIt = dirIt->begin(); fileIt != dirIt->end(); ++fileIt) {
+                auto &ids = fileIt.value();
+                const int index = ids.indexOf(id);
+                if (index < 0)
+                    continue;
+                if (ids.contains(target))
+                    ids.remove(index);
+                else
+                    ids[index] = target;
+            }
         }
-    });
+    }
+    d->updateTagRanks();
 }
 
 void FileTagCache::taggeFiles(const QVariantMap &fileAndTags)
 {
-    auto it = fileAndTags.begin();
-    for (; it != fileAndTags.end(); ++it) {
-        if (!d->fileTagsCache.contains(it.key())) {
-            d->fileTagsCache.insert(it.key(), it.value().toStringList());
-        } else {
-            const auto &lst = it.value().toStringList();
-            auto cacheLst = d->fileTagsCache.value(it.key()).toStringList();
-            for (const QString &tag : lst)
-                if (!cacheLst.contains(tag))
-                    cacheLst.append(tag);
-
-            d->fileTagsCache[it.key()] = cacheLst;
+    QWriteLocker locker(&d->lock);
+    for (auto it = fileAndTags.begin(); it != fileAndTags.end(); ++it) {
+        const auto *cached = d->findFile(it.key());
+        FileTagCachePrivate::TagIds ids;
+        if (cached) {
+            for (int id : *cached) {
+                if (!d->tagTable.at(id).removed)
+                    ids.append(id);
+            }
         }
+
+        for (const QString &tag : it.value().toStringList()) {
+            const int id = d->internTag(tag);
+            if (!ids.contains(id))
+                ids.append(id);
+        }
+        d->setFileTags(it.key(), ids);
     }
 }
 
@@ -203,27 +308,27 @@ QStringList FileTagCache::getTrashTags(const QString &path, qint64 inode) const
 
 void FileTagCache::reloadTrashFileTagsCache()
 {
+    const auto &trashFileTags = TagProxyHandle::instance()->getAllTrashFileTags();
     QWriteLocker locker(&d->lock);
-    d->trashFileTagsCache = TagProxyHandle::instance()->getAllTrashFileTags();
+    d->trashFileTagsCache = trashFileTags;
 }
 
 void FileTagCache::untaggeFiles(const QVariantMap &fileAndTags)
 {
-    auto it = fileAndTags.begin();
-    for (; it != fileAndTags.end(); ++it) {
-        if (d->fileTagsCache.contains(it.key())) {
-            const auto &lst = it.value().toStringList();
-            auto cacheLst = d->fileTagsCache.value(it.key()).toStringList();
-            for (const QString &tag : lst)
-                if (cacheLst.contains(tag))
-                    cacheLst.removeOne(tag);
-
-            if (cacheLst.isEmpty()) {
-                d->fileTagsCache.remove(it.key());
-            } else {
-                d->fileTagsCache[it.key()] = cacheLst;
-            }
+    QWriteLocker locker(&d->lock);
+    for (auto it = fileAndTags.begin(); it != fileAndTags.end(); ++it) {
+        const auto *cached = d->findFile(it.key());
+        if (!cached)
+            continue;
+
+        const auto &lst = it.value().toStringList();
+        FileTagCachePrivate::TagIds ids;
+        for (int id : *cached) {
+            const auto &entry = d->tagTable.at(id);
+            if (!entry.removed && !lst.contains(entry.name))
+                ids.append(id);
         }
+        d->setFileTags(it.key(), ids);
     }
 }
 
@@ -236,27 +341,35 @@ FileTagCache::~FileTagCache()
  * @param paths is a collection of file paths
  * @return QStringList intersectionTags
  */
+bool FileTagCache::isLoaded() const
+{
+    QReadLocker rlk(&d->lock);
+    return d->loaded;
+}
+
 QStringList FileTagCache::getTagsByFiles(const QStringList &paths) const
 {
     if (paths.isEmpty())
         return {};
 
-    QReadLocker wlk(&d->lock);
-    QStringList intersectionTags = d->fileTagsCache.value(paths.first()).toStringList();
-
-    for (const QString &path : paths) {
-        QStringList tags = d->fileTagsCache.value(path).toStringList();
-#if (QT_VERSION < QT_VERSION_CHECK(6, 0, 0))
-        intersectionTags = intersectionTags.toSet().intersect(tags.toSet()).values();
-#else
-        auto intersectionSet = QSet<QString> { intersectionTags.begin(), intersectionTags.end() };
-        auto tagsSet = QSet<QString> { tags.begin(), tags.end() };
-        intersectionTags = intersectionSet.intersect(tagsSet).values();
-#endif
-        if (intersectionTags.isEmpty())
-            break;
+    QReadLocker rlk(&d->lock);
+    const auto *first = d->findFile(paths.first());
+    if (!first)
+        return {};
+
+    FileTagCachePrivate::TagIds intersection = *first;
+    for (int i = 1; i < paths.size() && !intersection.isEmpty(); ++i) {
+        const auto *ids = d->findFile(paths.at(i));
+        if (!ids)
+            return {};
+
+        for (int j = intersection.size() - 1; j >= 0; --j) {
+            if (!ids->contains(intersection.at(j)))
+                intersection.remove(j);
+        }
     }
-    return intersectionTags;
+
+    return d->tagNames(intersection);
 }
 
 QHash<QString, QStringList> FileTagCache::findChildren(const QString &parentPath) const
@@ -266,11 +379,19 @@ QHash<QString, QStringList> FileTagCache::findChildren(const QString &parentPath
     if (!normalizedParent.endsWith('/'))
         normalizedParent += '/';
 
-    QReadLocker wlk(&d->lock);
-    for (auto it = d->fileTagsCache.cbegin(); it != d->fileTagsCache.cend(); ++it) {
-        const QString &filePath = it.key();
-        if (filePath.startsWith(normalizedParent))
-            children.insert(filePath, it.value().toStringList());
+    // 只遍历有标记文件的目录，而不是所有标记文件
+    QReadLocker rlk(&d->lock);
+    for (auto dirIt = d->filesByDir.cbegin(); dirIt != d->filesByDir.cend(); ++dirIt) {
+        const QString &dir = dirIt.key();
+        const QString &dirPrefix = dir.endsWith('/') ? dir : dir + '/';
+        if (!dirPrefix.startsWith(normalizedParent))
+            continue;
+
+        for (auto fileIt = dirIt->cbegin(); fileIt != dirIt->cend(); ++fileIt) {
+            const QStringList &tags = d->tagNames(fileIt.value());
+            if (!tags.isEmpty())
+                children.insert(dirPrefix + fileIt.key(), tags);
+        }
     }
 
     return children;
@@ -281,22 +402,60 @@ FileTagCache::TagColorMap FileTagCache::getTagsColor(const QStringList &tags) co
     if (tags.isEmpty())
         return {};
 
-    QReadLocker wlk(&d->lock);
+    QReadLocker rlk(&d->lock);
     TagColorMap tagsColor;
     for (const auto &tag : tags) {
-        if (d->tagProperty.contains(tag))
-            tagsColor.insert(tag, d->tagProperty.value(tag));
+        auto id = d->tagIds.constFind(tag);
+        if (id == d->tagIds.constEnd())
+            continue;
+        const QColor &color = d->tagTable.at(id.value()).color;
+        if (color.isValid())
+            tagsColor.insert(tag, color);
     }
 
     return tagsColor;
 }
 
+/**
+ * @brief Colors of the tags on a file, ordered by tag name, for painting
+ */
+QList<QColor> FileTagCache::getTagColorsByFile(const QString &path) const
+{
+    QReadLocker rlk(&d->lock);
+    const auto *ids = d->findFile(path);
+    if (!ids)
+        return {};
+
+    QVarLengthArray<QPair<int, QColor>, 4> ranked;
+    for (int id : *ids) {
+        const auto &entry = d->tagTable.at(id);
+        if (!entry.removed && entry.color.isValid())
+            ranked.append({ entry.rank, entry.color });
+    }
+    rlk.unlock();
+
+    std::sort(ranked.begin(), ranked.end(), [](const QPair<int, QColor> &a, const QPair<int, QColor> &b) {
+        return a.first < b.first;
+    });
+
+    QList<QColor> colors;
+    colors.reserve(ranked.size());
+    for (const auto &item : ranked)
+        colors.append(item.second);
+    return colors;
+}
+
 FileTagCacheController &FileTagCacheController::instance()
 {
     static FileTagCacheController cacheController;
     return cacheController;
 }
 
+bool FileTagCacheController::isLoaded() const
+{
+    return FileTagCache::instance().isLoaded();
+}
+
 QStringList FileTagCacheController::getTagsByFiles(const QStringList &paths)
 {
     return FileTagCache::instance().getTagsByFiles(paths);
@@ -312,6 +471,11 @@ QMap<QString, QColor> FileTagCacheController::getCacheTagsColor(const QStringLis
     return FileTagCache::instance().getTagsColor(tags);
 }
 
+QList<QColor> FileTagCacheController::getCacheTagColorsByFile(const QString &path)
+{
+    return FileTagCache::instance().getTagColorsByFile(path);
+}
+
 QHash<QString, QStringList> FileTagCacheController::findChildren(const QString &parentPath) const
 {
     return FileTagCache::instance().findChildren(parentPath);
@@ -6,6 +6,7 @@
 #define FILETAGCACHE_H
 
 #include <QObject>
+#include <QColor>
 #include <QThread>
 #include <QSharedPointer>
 
@@ -49,8 +50,10 @@ public:
     virtual ~FileTagCache() override;
 
     //query
+    bool isLoaded() const;
     QStringList getTagsByFiles(const QStringList &paths) const;
     TagColorMap getTagsColor(const QStringList &tags) const;
+    QList<QColor> getTagColorsByFile(const QString &path) const;
     QHash<QString, QStringList> findChildren(const QString &parentPath) const;
 
 private:
@@ -62,7 +65,6 @@ private:
     void deleteTags(const QStringList &tags);
     void changeTagColor(const QVariantMap &tagAndColorName);
     void changeTagName(const QVariantMap &oldAndNew);
-    void changeFilesTagName(const QString &oldName, const QString &newName);
     void taggeFiles(const QVariantMap &fileAndTags);
     void untaggeFiles(const QVariantMap &fileAndTags);
 
@@ -82,9 +84,11 @@ public:
     static FileTagCacheController &instance();
 
     //query
+    bool isLoaded() const;
     QStringList getTagsByFiles(const QStringList &paths);
     QStringList getTagsByFile(const QString &path);
     QMap<QString, QColor> getCacheTagsColor(const QStringList &tags);
+    QList<QColor> getCacheTagColorsByFile(const QString &path);
     QHash<QString, QStringList> findChildren(const QString &parentPath) const;
 
     QStringList getTrashFileTags(const QString &path, qint64 inode);
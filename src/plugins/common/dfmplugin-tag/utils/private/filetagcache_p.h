@@ -10,6 +10,9 @@
 #include <QReadWriteLock>
 #include <QMutex>
 #include <QHash>
+#include <QColor>
+#include <QVarLengthArray>
+#include <QVector>
 
 namespace dfmplugin_tag {
 class FileTagCachePrivate
@@ -17,14 +20,37 @@ class FileTagCachePrivate
     friend class FileTagCache;
     FileTagCache *const q;
 
-    QHash<QString, QVariant> fileTagsCache;   // file path ->  tag name list
-    QHash<QString, QColor> tagProperty;   // tag name -> QColor
+    // tag names are interned to ids; a file only keeps a small array of ids
+    using TagIds = QVarLengthArray<int, 4>;
+
+    struct TagEntry
+    {
+        QString name;
+        QColor color;   // invalid until the tag property is known
+        int rank { 0 };   // position of the name in sorted order, used to order colors
+        bool removed { false };   // removed tags keep their id, files drop it lazily
+    };
+
+    QVector<TagEntry> tagTable;   // tag id -> tag property
+    QHash<QString, int> tagIds;   // tag name -> tag id, live tags only
+    QHash<QString, QHash<QString, TagIds>> filesByDir;   // dir path -> file name -> tag ids
     QHash<QString, QVariant> trashFileTagsCache;   // "path:inode" -> tag name list
     QReadWriteLock lock;
+    bool loaded { false };   // set once the tags of the database are in the cache
 
 public:
     explicit FileTagCachePrivate(FileTagCache *qq);
     virtual ~FileTagCachePrivate();
+
+private:
+    // the following helpers expect the caller to hold the lock
+    int internTag(const QString &name);
+    void updateTagRanks();
+    QStringList tagNames(const TagIds &ids) const;
+    const TagIds *findFile(const QString &path) const;
+    void setFileTags(const QString &path, const TagIds &ids);
+
+    static bool splitPath(const QString &path, QString *dir, QString *name);
 };
 }
 
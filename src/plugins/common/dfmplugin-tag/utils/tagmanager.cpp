@@ -132,17 +132,13 @@ bool TagManager::paintListTagsHandle(int role, const FileInfoPointer &info, QPai
 
     QString path = info->pathOf(PathInfoType::kFilePath);
     path = FileUtils::bindPathTransform(path, false);
-    const auto &tags = FileTagCacheIns.getTagsByFile(path);
-    if (tags.isEmpty())
-        return false;
-
-    const auto &tagsColor = FileTagCacheIns.getCacheTagsColor(tags);
+    const auto &tagsColor = FileTagCacheIns.getCacheTagColorsByFile(path);
     if (!tagsColor.isEmpty()) {
         QRectF boundingRect(0, 0, (tagsColor.size() + 1) * kTagDiameter / 2, kTagDiameter);
         boundingRect.moveCenter(rect->center());
         boundingRect.moveRight(rect->right());
 
-        TagHelper::instance()->paintTags(painter, boundingRect, tagsColor.values());
+        TagHelper::instance()->paintTags(painter, boundingRect, tagsColor);
 
         rect->setRight(boundingRect.left() - 10);
     }
@@ -157,18 +153,13 @@ bool TagManager::addIconTagsHandle(const FileInfoPointer &info, ElideTextLayout
 
     QString path = info->pathOf(PathInfoType::kFilePath);
     path = FileUtils::bindPathTransform(path, false);
-    const auto &fileTags = FileTagCacheIns.getTagsByFile(path);
-    if (fileTags.isEmpty())
-        return false;
-
-    const auto &tagsColor = FileTagCacheIns.getCacheTagsColor(fileTags);
-
+    const auto &tagsColor = FileTagCacheIns.getCacheTagColorsByFile(path);
     if (!tagsColor.isEmpty()) {
         auto document = layout->documentHandle();
         if (document) {
             document->documentLayout()->registerHandler(textObjectType, tagPainter);
             QTextCursor cursor(document);
-            TagTextFormat format(textObjectType, tagsColor.values(), Qt::white);
+            TagTextFormat format(textObjectType, tagsColor, Qt::white);
 
             cursor.setPosition(0);
             cursor.insertText(QString(QChar::ObjectReplacementCharacter), format);
@@ -315,35 +306,74 @@ bool TagManager::setTagsForFiles(const QStringList &tags, const QList<QUrl> &fil
 
     QList<QUrl> realUrls;
     UniversalUtils::urlsTransformToLocal(files, &realUrls);
+    const QList<QUrl> &urls = TagHelper::commonUrls(realUrls);
+    if (urls.isEmpty())
+        return false;
+
+    // the diff is computed from the cache, then sent to the daemon as one call.
+    // the keys must match the paths the daemon stores, as removeTagsOfFiles does
+    QStringList paths;
+    for (const QUrl &url : urls)
+        paths.append(UrlRoute::urlToPath(url));
+
+    // the cache is loaded asynchronously, ask the daemon until it is ready
+    // so that the tags to remove are never taken from an empty cache
+    QHash<QString, QStringList> tagsOfFiles;
+    if (FileTagCacheIns.isLoaded()) {
+        for (const QString &path : paths)
+            tagsOfFiles.insert(path, FileTagCacheIns.getTagsByFile(path));
+    } else {
+        fmDebug() << "File tag cache is not ready, query tags of" << paths.size() << "files from daemon";
+        const QVariantMap &dataMap = TagProxyHandleIns->getTagsThroughFile(paths);
+        for (auto it = dataMap.cbegin(); it != dataMap.cend(); ++it)
+            tagsOfFiles.insert(it.key(), it.value().toStringList());
+    }
 
     // set tags for mult files
-    QStringList mutualTagNames = TagManager::instance()->getTagsByUrls(realUrls);
+    QStringList mutualTagNames = tagsOfFiles.value(paths.first());
+    for (int i = 1; i < paths.size() && !mutualTagNames.isEmpty(); ++i) {
+        const QStringList &tagsOfFile = tagsOfFiles.value(paths.at(i));
+        for (int j = mutualTagNames.size() - 1; j >= 0; --j) {
+            if (!tagsOfFile.contains(mutualTagNames.at(j)))
+                mutualTagNames.removeAt(j);
+        }
+    }
+
     // for deleting.
     QStringList dirtyTagNames;
     for (const QString &tag : mutualTagNames)
         if (!tags.contains(tag))
             dirtyTagNames << tag;
 
-    bool result = false;
-    if (!dirtyTagNames.isEmpty())
-        result = TagManager::instance()->removeTagsOfFiles(dirtyTagNames, realUrls) || result;
+    QVariantMap untagged;
+    QVariantMap tagged;
+    for (const QString &path : paths) {
+        if (!dirtyTagNames.isEmpty())
+            untagged[path] = QVariant(dirtyTagNames);
 
-    for (const QUrl &url : TagHelper::commonUrls(realUrls)) {
-        QStringList tagsOfFile = TagManager::instance()->getTagsByUrls({ url });
+        const QStringList &tagsOfFile = tagsOfFiles.value(path);
         QStringList newTags;
-
         for (const QString &tag : tags) {
             if (!tagsOfFile.contains(tag))
                 newTags.append(tag);
         }
 
-        if (!newTags.isEmpty()) {
-            tagsOfFile.append(newTags);
-            result = TagManager::instance()->addTagsForFiles(newTags, { url }) || result;
-        }
+        if (!newTags.isEmpty())
+            tagged[path] = QVariant(newTags);
     }
 
-    return result;
+    if (untagged.isEmpty() && tagged.isEmpty())
+        return false;
+
+    QVariantMap data;
+    data["tags"] = tagsWithColorName(tags);
+    data["tagged"] = tagged;
+    data["untagged"] = untagged;
+    if (TagProxyHandleIns->setTagsOfFiles(data))
+        return true;
+
+    fmWarning() << "Failed to set tags of files, tagged:" << tagged.size() << "untagged:" << untagged.size();
+    return false;
 }
 
 bool TagManager::addTagsForFiles(const QList<QString> &tags, const QList<QUrl> &files)
@@ -355,11 +385,7 @@ bool TagManager::addTagsForFiles(const QList<QString> &tags, const QList<QUrl> &
     QList<QUrl> urls;
     UniversalUtils::urlsTransformToLocal(files, &urls);
     // tag --- color
-    QMap<QString, QVariant> tagWithColor {};
-    for (const QString &tagName : tags) {
-        QString colorName = tagColorMap.contains(tagName) ? tagColorMap[tagName] : TagHelper::instance()->queryColorByDisplayName(tagName).name();
-        tagWithColor[tagName] = QVariant { QList<QString> { colorName } };
-    }
+    const QVariantMap &tagWithColor = tagsWithColorName(tags);
 
     // make tag for files
     QVariant checkTagResult { TagProxyHandleIns->addTags(tagWithColor) };
@@ -562,6 +588,16 @@ QMap<QString, QString> TagManager::getTagsColorName(const QStringList &tags) con
     return result;
 }
 
+QVariantMap TagManager::tagsWithColorName(const QStringList &tags) const
+{
+    QVariantMap tagWithColor;
+    for (const QString &tagName : tags) {
+        QString colorName = tagColorMap.contains(tagName) ? tagColorMap[tagName] : TagHelper::instance()->queryColorByDisplayName(tagName).name();
+        tagWithColor[tagName] = QVariant { QList<QString> { colorName } };
+    }
+    return tagWithColor;
+}
+
 bool TagManager::deleteTagData(const QStringList &data, const DeleteOpts &type)
 {
     if (data.isEmpty())
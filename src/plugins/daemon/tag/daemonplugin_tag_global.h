@@ -46,7 +46,8 @@ enum class DeleteOpts : int {
 enum class UpdateOpts : int {
     kColors,
     kTagsNameWithFiles,
-    kFilesPaths
+    kFilesPaths,
+    kTagsOfFiles   // add and remove tags of files in one transaction
 };
 
 DAEMONPTAG_END_NAMESPACE
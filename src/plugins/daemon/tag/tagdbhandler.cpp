@@ -463,6 +463,77 @@ bool TagDbHandler::changeFilePaths(const QVariantMap &data)
     return true;
 }
 
+bool TagDbHandler::setTagsOfFiles(const QVariantMap &tags, const QVariantMap &tagged, const QVariantMap &untagged)
+{
+    DFMBASE_NAMESPACE::FinallyUtil finally([&]() { lastErr.clear(); });
+
+    if (tagged.isEmpty() && untagged.isEmpty()) {
+        lastErr = "input parameter is empty!";
+        fmWarning() << "TagDbHandler::setTagsOfFiles: Empty data provided";
+        finally.dismiss();
+        return false;
+    }
+
+    fmInfo() << "TagDbHandler::setTagsOfFiles: Tagging" << tagged.size() << "files and untagging" << untagged.size() << "files";
+
+    // the client computes the diff from its cache, filter out what is already stored
+    const QVariantMap &dbData = tagged.isEmpty() ? QVariantMap() : getTagsByUrls(tagged.keys());
+    QVariantMap newTags;
+    QVariantMap tmpTagged;
+    bool ret = handle->transaction([&]() -> bool {
+        for (auto it = tags.begin(); it != tags.end(); ++it) {
+            if (checkTag(it.key()))
+                continue;
+            if (!insertTagProperty(it.key(), it.value())) {
+                fmCritical() << "TagDbHandler::setTagsOfFiles: Failed to insert tag property for tag:" << it.key();
+                return false;
+            }
+            newTags.insert(it.key(), it.value());
+        }
+
+        for (auto it = untagged.begin(); it != untagged.end(); ++it) {
+            if (!removeSpecifiedTagOfFile(it.key(), it.value())) {
+                fmCritical() << "TagDbHandler::setTagsOfFiles: Failed to remove tags from file:" << it.key();
+                return false;
+            }
+        }
+
+        for (auto it = tagged.begin(); it != tagged.end(); ++it) {
+            const QStringList &stored = dbData.value(it.key()).toStringList();
+            QStringList fileTags;
+            for (const QString &tag : it.value().toStringList()) {
+                if (!stored.contains(tag) && !fileTags.contains(tag))
+                    fileTags.append(tag);
+            }
+            if (fileTags.isEmpty())
+                continue;
+
+            if (!tagFile(it.key(), fileTags)) {
+                fmCritical() << "TagDbHandler::setTagsOfFiles: Failed to tag file:" << it.key();
+                return false;
+            }
+            tmpTagged.insert(it.key(), fileTags);
+        }
+        return true;
+    });
+
+    if (!ret) {
+        fmCritical() << "TagDbHandler::setTagsOfFiles: Transaction failed while setting tags of files";
+        return false;
+    }
+
+    // one notification per kind of change for the whole batch
+    if (!newTags.isEmpty())
+        emit newTagsAdded(newTags);
+    if (!untagged.isEmpty())
+        emit filesUntagged(untagged);
+    if (!tmpTagged.isEmpty())
+        emit filesWereTagged(tmpTagged);
+
+    fmInfo() << "TagDbHandler::setTagsOfFiles: Successfully set tags of files";
+    return true;
+}
+
 QString TagDbHandler::lastError() const
 {
     return lastErr;
@@ -495,6 +566,13 @@ void TagDbHandler::initialize()
                                                      Global::DataBase::kDfmDBName,
                                                      nullptr);
     handle.reset(new SqliteHandle(dbFilePath));
+
+    // only the daemon writes tags, WAL lets readers proceed while a batch commits
+    SqliteConnectionOptions options;
+    options.walMode = true;
+    options.synchronous = SqliteConnectionOptions::Synchronous::kNormal;
+    handle->setConnectionOptions(options);
+
     QSqlDatabase db { SqliteConnectionPool::instance().openConnection(dbFilePath) };
     if (!db.isValid() || db.isOpenError()) {
         fmCritical() << "TagDbHandler::initialize: Failed to open tag database:" << dbFilePath;
@@ -595,24 +673,23 @@ bool TagDbHandler::tagFile(const QString &file, const QVariant &tags)
         return false;
     }
 
-    // insert file--tags
+    // insert file--tags as one prepared batch
     const QStringList &tempTags = tags.toStringList();
-    int suc = tempTags.count();
+    QVariantList paths;
+    QVariantList tagNames;
+    QVariantList orders;
+    QVariantList futures;
     for (const auto &tag : tempTags) {
-        FileTagInfo temp;
-        temp.setFilePath(file);
-        temp.setTagName(tag);
-        temp.setTagOrder(0);
-        temp.setFuture("null");
-        if (-1 == handle->insert<FileTagInfo>(temp)) {
-            fmCritical() << "TagDbHandler::tagFile: Failed to insert file tag - file:" << file << "tag:" << tag;
-            break;
-        }
-        suc--;
+        paths.append(file);
+        tagNames.append(tag);
+        orders.append(0);
+        futures.append(QString("null"));
     }
 
-    if (0 < suc) {
-        lastErr = QString("Tag file failed! file: %1, tagName: %2").arg(file).arg(tempTags.at(--suc));
+    if (!handle->insertColumns<FileTagInfo>({ "filePath", "tagName", "tagOrder", "future" },
+                                            { paths, tagNames, orders, futures })) {
+        fmCritical() << "TagDbHandler::tagFile: Failed to insert file tags - file:" << file << "tags:" << tempTags;
+        lastErr = QString("Tag file failed! file: %1, tagName: %2").arg(file).arg(tempTags.join(","));
         return false;
     }
 
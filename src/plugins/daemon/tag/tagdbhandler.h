@@ -54,6 +54,7 @@ public:
     bool changeTagColors(const QVariantMap &data);
     bool changeTagNamesWithFiles(const QVariantMap &data);
     bool changeFilePaths(const QVariantMap &data);
+    bool setTagsOfFiles(const QVariantMap &tags, const QVariantMap &tagged, const QVariantMap &untagged);
 
     // Trash file tags operations
     bool saveTrashFileTags(const QString &originalPath, qint64 inode, const QStringList &tags);
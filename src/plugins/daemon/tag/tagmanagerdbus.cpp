@@ -6,8 +6,18 @@
 #include "daemonplugin_tag_global.h"
 #include "tagdbhandler.h"
 
+#include <QDBusArgument>
+
 DAEMONPTAG_USE_NAMESPACE
 
+// nested maps arrive as QDBusArgument
+static QVariantMap toVariantMap(const QVariant &value)
+{
+    if (value.userType() == qMetaTypeId<QDBusArgument>())
+        return qdbus_cast<QVariantMap>(value.value<QDBusArgument>());
+    return value.toMap();
+}
+
 TagManagerDBus::TagManagerDBus(QObject *parent)
     : QObject(parent)
 {
@@ -115,6 +125,10 @@ bool TagManagerDBus::Update(int opt, const QVariantMap value)
         return TagDbHandler::instance()->changeTagNamesWithFiles(value);
     case UpdateOpts::kFilesPaths:
         return TagDbHandler::instance()->changeFilePaths(value);
+    case UpdateOpts::kTagsOfFiles:
+        return TagDbHandler::instance()->setTagsOfFiles(toVariantMap(value.value("tags")),
+                                                        toVariantMap(value.value("tagged")),
+                                                        toVariantMap(value.value("untagged")));
     }
 
     return false;
@@ -75,6 +75,7 @@ void CanvasProxyModelPrivate::sourceRowsInserted(const QModelIndex &sourceParent
     q->beginInsertRows(q->rootIndex(), row, row + files.count() - 1);
 
     fileList.append(files);
+    rowIndex.append(files);
     for (const QUrl &url : files)
         fileMap.insert(url, srcModel->fileInfo(srcModel->index(url)));
 
@@ -104,12 +105,13 @@ void CanvasProxyModelPrivate::sourceRowsAboutToBeRemoved(const QModelIndex &sour
 
     // remove one by one
     for (const QUrl &url : files) {
-        int row = fileList.indexOf(url);
+        int row = rowIndex.row(url);
         if (row < 0)
             continue;
 
         q->beginRemoveRows(q->rootIndex(), row, row);
         fileList.removeAt(row);
+        rowIndex.remove(url);
         fileMap.remove(url);
         q->endRemoveRows();
     }
@@ -120,11 +122,12 @@ void CanvasProxyModelPrivate::sourceDataRenamed(const QUrl &oldUrl, const QUrl &
     // canvas filter
     bool ignore = renameFilter(oldUrl, newUrl);
 
-    int row = fileList.indexOf(oldUrl);
+    int row = rowIndex.row(oldUrl);
     if (ignore) {
         if (row >= 0) {
             q->beginRemoveRows(q->rootIndex(), row, row);
             fileList.removeAt(row);
+            rowIndex.remove(oldUrl);
             fileMap.remove(oldUrl);
             q->endRemoveRows();
         }
@@ -137,6 +140,7 @@ void CanvasProxyModelPrivate::sourceDataRenamed(const QUrl &oldUrl, const QUrl &
             row = fileList.count();
             q->beginInsertRows(q->rootIndex(), row, row);
             fileList.append(newUrl);
+            rowIndex.append(newUrl);
             fileMap.insert(newUrl, newInfo);
             q->endInsertRows();
             return;
@@ -147,12 +151,14 @@ void CanvasProxyModelPrivate::sourceDataRenamed(const QUrl &oldUrl, const QUrl &
             //! treat as removing if newurl is existed in canvas.
             q->beginRemoveRows(q->rootIndex(), row, row);
             fileList.removeAt(row);
+            rowIndex.remove(oldUrl);
             fileMap.remove(oldUrl);
             q->endRemoveRows();
 
-            row = fileList.indexOf(newUrl);
+            row = rowIndex.row(newUrl);
         } else {
             fileList.replace(row, newUrl);
+            rowIndex.replace(oldUrl, newUrl);
             fileMap.remove(oldUrl);
             fileMap.insert(newUrl, newInfo);
             emit q->dataReplaced(oldUrl, newUrl);
@@ -340,6 +346,7 @@ void CanvasProxyModelPrivate::standardSort(QList<QUrl> &files) const
 void CanvasProxyModelPrivate::clearMapping()
 {
     fileList.clear();
+    rowIndex.clear();
     fileMap.clear();
 }
 
@@ -362,6 +369,7 @@ void CanvasProxyModelPrivate::createMapping()
 
     // set unsorted files into model to enable create module index that doSort will used.
     fileList = urls;
+    rowIndex.reset();
     fileMap = maps;
 
     doSort(urls);
@@ -374,6 +382,7 @@ void CanvasProxyModelPrivate::createMapping()
     }
 
     fileList = urls;
+    rowIndex.reset();
     fileMap = maps;
 }
 
@@ -483,10 +492,9 @@ QModelIndex CanvasProxyModel::index(const QUrl &url, int column) const
     if (!url.isValid())
         return QModelIndex();
 
-    if (d->fileMap.contains(url)) {
-        int row = d->fileList.indexOf(url);
+    int row = d->rowIndex.row(url);
+    if (row >= 0)
         return createIndex(row, column);
-    }
 
     return QModelIndex();
 }
@@ -840,7 +848,9 @@ bool CanvasProxyModel::sort()
         QModelIndexList from = d->indexs();
         auto fromUlrs = d->fileList;
 
+        // sorting reorders every row, rebuild the url index
         d->fileList = orderFiles;
+        d->rowIndex.reset();
         d->fileMap = tempFileMap;
 
         // get the indexs of fromUlrs after sorting
@@ -913,6 +923,7 @@ bool CanvasProxyModel::fetch(const QUrl &url)
         beginInsertRows(rootIndex(), row, row);
 
         d->fileList.append(url);
+        d->rowIndex.append(url);
         d->fileMap.insert(url, info);
 
         endInsertRows();
@@ -933,7 +944,7 @@ bool CanvasProxyModel::take(const QUrl &url)
     // canvas filter
     d->removeFilter(url);
 
-    int row = d->fileList.indexOf(url);
+    int row = d->rowIndex.row(url);
     if (Q_UNLIKELY(row < 0)) {
         fmCritical() << "Invalid index for file in take operation:" << url;
         return false;
@@ -941,6 +952,7 @@ bool CanvasProxyModel::take(const QUrl &url)
 
     beginRemoveRows(rootIndex(), row, row);
     d->fileList.removeAt(row);
+    d->rowIndex.remove(url);
     d->fileMap.remove(url);
     endRemoveRows();
     return true;
@@ -11,6 +11,7 @@
 #include "canvasmodelfilter.h"
 
 #include <dfm-base/dfm_global_defines.h>
+#include <dfm-base/utils/urlrowindex.h>
 
 #include <QTimer>
 
@@ -59,6 +60,7 @@ private:
 public:
     QDir::Filters filters = QDir::AllEntries | QDir::NoDotAndDotDot | QDir::System;
     QList<QUrl> fileList;
+    DFMBASE_NAMESPACE::UrlRowIndex rowIndex { &fileList };
     QMap<QUrl, FileInfoPointer> fileMap;
     FileInfoModel *srcModel = nullptr;
     QSharedPointer<QTimer> refreshTimer;
@@ -68,6 +68,7 @@ void FileInfoModelPrivate::resetData(const QList<QUrl> &urls)
     {
         QWriteLocker lk(&lock);
         fileList = fileUrls;
+        rowIndex.reset();
         fileMap = fileMaps;
     }
 
@@ -115,6 +116,7 @@ void FileInfoModelPrivate::insertData(const QUrl &url)
     {
         QWriteLocker lk(&lock);
         fileList.append(url);
+        rowIndex.append(url);
         fileMap.insert(url, itemInfo);
     }
     q->endInsertRows();
@@ -134,7 +136,7 @@ void FileInfoModelPrivate::removeData(const QUrl &url)
     int position = -1;
     {
         QReadLocker lk(&lock);
-        position = fileList.indexOf(url);
+        position = rowIndex.row(url);
     }
 
     if (Q_UNLIKELY(position < 0)) {
@@ -145,8 +147,9 @@ void FileInfoModelPrivate::removeData(const QUrl &url)
     q->beginRemoveRows(q->rootIndex(), position, position);
     {
         QWriteLocker lk(&lock);
-        position = fileList.indexOf(url);
+        position = rowIndex.row(url);
         fileList.removeAt(position);
+        rowIndex.remove(url);
         fileMap.remove(url);
     }
     q->endRemoveRows();
@@ -171,7 +174,7 @@ void FileInfoModelPrivate::replaceData(const QUrl &oldUrl, const QUrl &newUrl)
 
     {
         QWriteLocker lk(&lock);
-        int position = fileList.indexOf(oldUrl);
+        int position = rowIndex.row(oldUrl);
         if (Q_LIKELY(position < 0)) {
             if (!fileMap.contains(newUrl)) {
                 lk.unlock();
@@ -180,7 +183,7 @@ void FileInfoModelPrivate::replaceData(const QUrl &oldUrl, const QUrl &newUrl)
                 return;
             }
         } else {
-            if (fileList.contains(newUrl)) {
+            if (rowIndex.contains(newUrl)) {
                 // e.g. a mv to b(b is existed)
                 //! emit replace signal first.
                 fmInfo() << "Target URL already exists, handling overwrite - old:" << oldUrl << "new:" << newUrl;
@@ -190,7 +193,7 @@ void FileInfoModelPrivate::replaceData(const QUrl &oldUrl, const QUrl &newUrl)
                 lk.unlock();
                 removeData(oldUrl);
                 lk.relock();
-                position = fileList.indexOf(newUrl);
+                position = rowIndex.row(newUrl);
                 lk.unlock();
 
                 // Re-fetch to ensure consistency with InfoCacheController
@@ -202,6 +205,7 @@ void FileInfoModelPrivate::replaceData(const QUrl &oldUrl, const QUrl &newUrl)
                 fmInfo() << "File moved to overwrite existing file:" << oldUrl << "->" << newUrl;
             } else {
                 fileList.replace(position, newUrl);
+                rowIndex.replace(oldUrl, newUrl);
                 fileMap.remove(oldUrl);
                 fileMap.insert(newUrl, newInfo);
                 lk.unlock();
@@ -430,10 +434,9 @@ QModelIndex FileInfoModel::index(const QUrl &url, int column) const
     if (url.isEmpty())
         return QModelIndex();
 
-    if (d->fileMap.contains(url)) {
-        int row = d->fileList.indexOf(url);
+    int row = d->rowIndex.row(url);
+    if (row >= 0)
         return createIndex(row, column);
-    }
 
     if (url == rootUrl())
         return rootIndex();
@@ -8,6 +8,8 @@
 #include "fileinfomodel.h"
 #include "fileprovider.h"
 
+#include <dfm-base/utils/urlrowindex.h>
+
 #include <QReadWriteLock>
 
 namespace ddplugin_canvas {
@@ -40,6 +42,7 @@ public:
     ModelState modelState = NullState;
     FileProvider *fileProvider = nullptr;
     QList<QUrl> fileList;
+    DFMBASE_NAMESPACE::UrlRowIndex rowIndex { &fileList };
     QMap<QUrl, FileInfoPointer> fileMap;
     QReadWriteLock lock;
 
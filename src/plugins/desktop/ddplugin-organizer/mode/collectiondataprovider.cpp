@@ -6,6 +6,7 @@
 
 #include <QDebug>
 #include <QPair>
+#include <QSet>
 
 using namespace ddplugin_organizer;
 
@@ -21,15 +22,7 @@ CollectionDataProvider::~CollectionDataProvider()
 
 QString CollectionDataProvider::key(const QUrl &url) const
 {
-    QString ret;
-    auto it = std::find_if(collections.begin(), collections.end(), [&url](const CollectionBaseDataPtr &ptr) {
-        return ptr->items.contains(url);
-    });
-
-    if (it != collections.end())
-        ret = (*it)->key;
-
-    return ret;
+    return urlIndex.value(url);
 }
 
 QString CollectionDataProvider::name(const QString &key) const
@@ -57,13 +50,12 @@ QList<QUrl> CollectionDataProvider::items(const QString &key) const
 
 bool CollectionDataProvider::contains(const QString &key, const QUrl &url) const
 {
-    auto it = collections.find(key);
-    if (it == collections.end()) {
+    if (!collections.contains(key)) {
         fmDebug() << "Collection not found:" << key;
         return false;
     }
 
-    return (*it)->items.contains(url);
+    return urlIndex.value(url) == key;
 }
 
 bool CollectionDataProvider::sorted(const QString &key, const QList<QUrl> &urls)
@@ -82,13 +74,14 @@ bool CollectionDataProvider::sorted(const QString &key, const QList<QUrl> &urls)
 
     // check data, \a all member of urls must be in items.
     for (const QUrl &url : urls) {
-        if (!(*it)->items.contains(url)) {
+        if (urlIndex.value(url) != key) {
             fmWarning() << "Cannot sort: url not found in collection" << key << "url:" << url.toString();
             return false;
         }
     }
 
     (*it)->items = urls;
+    indexPositions(key);
     fmInfo() << "Collection sorted successfully:" << key << "with" << urls.size() << "items";
     emit itemsChanged(key);
     return true;
@@ -106,54 +99,69 @@ void CollectionDataProvider::moveUrls(const QList<QUrl> &urls, const QString &ta
         fmWarning() << "Source collection not found for urls, cannot move";
         return;
     }
-    // In Qt6, when the size of the list is exceeded, the insert operation of QList will trigger an assertion crash
-    // To avoid the crash, if the size bigger than list's size, use append instead.
-    auto moveUrlInItems = [&urls](QHash<QString, CollectionBaseDataPtr>::Iterator &it, int targetIndex) {
-        if (targetIndex > it.value()->items.size()) {
-            for (auto url : urls) {
-                it.value()->items.append(url);
-            }
-        } else {
-            for (auto url : urls) {
-                it.value()->items.insert(targetIndex++, url);
-            }
-        }
-    };
-    if (sourceId == targetKey) {
-        // same collection
-        auto it = collections.find(sourceId);
-        if (it != collections.end()) {
-            for (auto url : urls) {
-                int oldIndex = it.value()->items.indexOf(url);
-                if (-1 == oldIndex) {
-                    fmWarning() << "Unknown error: url not found in collection" << url.toString() << "collection items:" << it.value()->items.size();
-                    continue;
-                }
-                if (oldIndex < targetIndex)
-                    targetIndex--;
-                it.value()->items.removeOne(url);
-            }
-            moveUrlInItems(it, targetIndex);
 
-            emit itemsChanged(sourceId);
-        }
-    } else {
-        // collection to other collection
-        auto it = collections.find(sourceId);
-        if (it != collections.end()) {
-            for (auto url : urls) {
-                it.value()->items.removeOne(url);
+    auto target = collections.find(targetKey);
+    if (target == collections.end()) {
+        fmWarning() << "Cannot find target collection:" << targetKey;
+        return;
+    }
+
+    // take all urls out of their collections in one pass per collection.
+    const QSet<QUrl> moving(urls.begin(), urls.end());
+    QStringList sources;
+    for (const QUrl &url : urls) {
+        const QString &from = urlIndex.value(url);
+        if (!from.isEmpty() && !sources.contains(from))
+            sources.append(from);
+    }
+
+    for (const QString &from : sources) {
+        auto ptr = collections.value(from);
+        if (!ptr)
+            continue;
+
+        auto &items = ptr->items;
+        QList<QUrl> kept;
+        kept.reserve(items.size());
+        for (int i = 0; i < items.size(); ++i) {
+            if (!moving.contains(items.at(i))) {
+                kept.append(items.at(i));
+            } else if (from == targetKey && i < targetIndex) {
+                // the target position moves forward with every url taken before it.
+                --targetIndex;
             }
-            emit itemsChanged(sourceId);
-        } else {
-            fmWarning() << "Cannot find source collection:" << sourceId;
-        }
-        it = collections.find(targetKey);
-        if (it != collections.end()) {
-            moveUrlInItems(it, targetIndex);
-            emit itemsChanged(targetKey);
         }
+        items = kept;
+    }
+
+    // In Qt6, when the size of the list is exceeded, the insert operation of QList will trigger an assertion crash
+    // To avoid the crash, if the size bigger than list's size, use append instead.
+    auto &items = target.value()->items;
+    if (targetIndex > items.size() || targetIndex < 0)
+        targetIndex = items.size();
+
+    QList<QUrl> merged;
+    merged.reserve(items.size() + urls.size());
+    merged.append(items.mid(0, targetIndex));
+    merged.append(urls);
+    merged.append(items.mid(targetIndex));
+    items = merged;
+
+    for (const QUrl &url : urls)
+        urlIndex.insert(url, targetKey);
+
+    // every touched collection was rebuilt above, renumber them once
+    for (const QString &from : sources) {
+        if (from != targetKey)
+            indexPositions(from);
     }
+    indexPositions(targetKey);
+
+    for (const QString &from : sources) {
+        if (from != targetKey)
+            emit itemsChanged(from);
+    }
+    emit itemsChanged(targetKey);
 }
 
 void CollectionDataProvider::addPreItems(const QString &targetKey, const QList<QUrl> &urls, int targetIndex)
@@ -166,37 +174,146 @@ void CollectionDataProvider::addPreItems(const QString &targetKey, const QList<Q
         // merge to existing index
         it.value().second.append(urls);
     }
+
+    for (const QUrl &url : urls)
+        preItemIndex.insert(url, targetKey);
 }
 
 bool CollectionDataProvider::checkPreItem(const QUrl &url, QString &key, int &index)
 {
-    for (auto it = preCollectionItems.constBegin(); it != preCollectionItems.constEnd(); ++it) {
-        if (it.value().second.contains(url)) {
-            key = it.key();
-            index = it.value().first;
-            return true;
-        }
-    }
+    auto it = preCollectionItems.constFind(preItemIndex.value(url));
+    if (it == preCollectionItems.constEnd())
+        return false;
 
-    return false;
+    key = it.key();
+    index = it.value().first;
+    return true;
 }
 
 bool CollectionDataProvider::takePreItem(const QUrl &url, QString &key, int &index)
 {
-    for (auto it = preCollectionItems.begin(); it != preCollectionItems.end(); ++it) {
-        if (it.value().second.contains(url)) {
-            key = it.key();
-            // current index will to be used,add it
-            index = it.value().first++;
+    auto it = preCollectionItems.find(preItemIndex.value(url));
+    if (it == preCollectionItems.end())
+        return false;
+
+    key = it.key();
+    // current index will to be used,add it
+    index = it.value().first++;
+
+    it.value().second.removeAll(url);
+    preItemIndex.remove(url);
+    if (it.value().second.isEmpty())
+        preCollectionItems.remove(key);
+
+    return true;
+}
+
+void CollectionDataProvider::setItems(const QString &key, const QList<QUrl> &urls)
+{
+    auto it = collections.find(key);
+    if (it == collections.end()) {
+        fmWarning() << "Cannot set items: collection not found:" << key;
+        return;
+    }
+
+    unindexItems(key);
+    it.value()->items = urls;
+    indexItems(key);
+}
+
+bool CollectionDataProvider::replaceItem(const QUrl &oldUrl, const QUrl &newUrl)
+{
+    const QString &cur = urlIndex.value(oldUrl);
+    auto ptr = collections.value(cur);
+    if (!ptr)
+        return false;
+
+    auto &items = ptr->items;
+    const int idx = positionIndex.value(oldUrl, -1);
+    if (idx < 0 || idx >= items.size() || items.at(idx) != oldUrl)
+        return false;
+
+    items.replace(idx, newUrl);
+    urlIndex.remove(oldUrl);
+    urlIndex.insert(newUrl, cur);
+    positionIndex.remove(oldUrl);
+    positionIndex.insert(newUrl, idx);
+    return true;
+}
+
+bool CollectionDataProvider::removeItem(const QUrl &url)
+{
+    auto it = urlIndex.find(url);
+    if (it == urlIndex.end())
+        return false;
+
+    const QString key = it.value();
+    urlIndex.erase(it);
+    const int idx = positionIndex.take(url);
+    if (auto ptr = collections.value(key)) {
+        if (idx >= 0 && idx < ptr->items.size() && ptr->items.at(idx) == url) {
+            ptr->items.removeAt(idx);
+            indexPositions(key, idx);
+        }
+    }
+    return true;
+}
+
+void CollectionDataProvider::insertItem(const QString &key, const QUrl &url, int index)
+{
+    auto it = collections.find(key);
+    if (it == collections.end())
+        return;
+
+    auto &items = it.value()->items;
+    if (index < 0 || index > items.size())
+        index = items.size();
+    items.insert(index, url);
+    urlIndex.insert(url, key);
+    // appending only numbers the new url, inserting shifts the rest of this collection
+    indexPositions(key, index);
+}
 
-            it.value().second.removeAll(url);
-            if (it.value().second.isEmpty())
-                preCollectionItems.remove(key);
+void CollectionDataProvider::indexItems(const QString &key)
+{
+    if (auto ptr = collections.value(key)) {
+        for (const QUrl &url : ptr->items)
+            urlIndex.insert(url, key);
+    }
+    indexPositions(key);
+}
 
-            return true;
+void CollectionDataProvider::unindexItems(const QString &key)
+{
+    if (auto ptr = collections.value(key)) {
+        for (const QUrl &url : ptr->items) {
+            auto it = urlIndex.find(url);
+            if (it != urlIndex.end() && it.value() == key) {
+                urlIndex.erase(it);
+                positionIndex.remove(url);
+            }
         }
     }
+}
 
-    return false;
+void CollectionDataProvider::rebuildIndex()
+{
+    urlIndex.clear();
+    positionIndex.clear();
+    for (auto it = collections.cbegin(); it != collections.cend(); ++it) {
+        const QList<QUrl> &items = it.value()->items;
+        for (int i = 0; i < items.size(); ++i) {
+            urlIndex.insert(items.at(i), it.key());
+            positionIndex.insert(items.at(i), i);
+        }
+    }
 }
 
+void CollectionDataProvider::indexPositions(const QString &key, int from)
+{
+    if (auto ptr = collections.value(key)) {
+        const QList<QUrl> &items = ptr->items;
+        for (int i = qMax(from, 0); i < items.size(); ++i)
+            positionIndex.insert(items.at(i), i);
+    }
+}
@@ -36,13 +36,30 @@ public:
     virtual void insert(const QUrl &, const QString &, const int) = 0;
     virtual QString remove(const QUrl &) = 0;
     virtual QString change(const QUrl &) = 0;
+
+    // low level edits that keep the url index in sync, no signal is emitted.
+    void setItems(const QString &key, const QList<QUrl> &urls);
+    bool replaceItem(const QUrl &oldUrl, const QUrl &newUrl);
+    bool removeItem(const QUrl &url);
 signals:
     void nameChanged(const QString &key, const QString &name);
     void itemsChanged(const QString &key);
 
 protected:
+    void insertItem(const QString &key, const QUrl &url, int index = -1);
+    void indexItems(const QString &key);
+    void unindexItems(const QString &key);
+    void rebuildIndex();
+    void indexPositions(const QString &key, int from = 0);
+
+protected:
+    // items of collections must only be changed through the functions above,
+    // or be followed by indexItems/rebuildIndex.
     QHash<QString, CollectionBaseDataPtr> collections;
+    QHash<QUrl, QString> urlIndex;   // url -> key of the collection that holds it
+    QHash<QUrl, int> positionIndex;   // url -> position in the items of that collection
     QHash<QString, QPair<int, QList<QUrl>>> preCollectionItems;
+    QHash<QUrl, QString> preItemIndex;   // url -> key in preCollectionItems
 };
 
 }
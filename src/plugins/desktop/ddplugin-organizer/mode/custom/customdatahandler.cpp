@@ -28,6 +28,8 @@ void CustomDataHandler::check(const QSet<QUrl> &vaild)
             }
         }
     }
+
+    rebuildIndex();
 }
 
 QList<CollectionBaseDataPtr> CustomDataHandler::baseDatas() const
@@ -48,11 +50,13 @@ bool CustomDataHandler::addBaseData(const CollectionBaseDataPtr &base)
     }
 
     collections.insert(base->key, base);
+    indexItems(base->key);
     return true;
 }
 
 void CustomDataHandler::removeBaseData(const QString &key)
 {
+    unindexItems(key);
     collections.remove(key);
 }
 
@@ -61,19 +65,19 @@ bool CustomDataHandler::reset(const QList<CollectionBaseDataPtr> &datas)
     for (const CollectionBaseDataPtr &ptr : datas)
         collections.insert(ptr->key, ptr);
 
+    rebuildIndex();
     return true;
 }
 
 QString CustomDataHandler::remove(const QUrl &url)
 {
-    for (auto iter = collections.begin(); iter != collections.end(); ++iter) {
-        if (iter.value()->items.removeOne(url)) {
-            emit itemsChanged(iter.key());
-            return iter.key();
-        }
-    }
+    const QString cur = key(url);
+    if (cur.isEmpty())
+        return "";
 
-    return "";
+    removeItem(url);
+    emit itemsChanged(cur);
+    return cur;
 }
 
 QString CustomDataHandler::change(const QUrl &)
@@ -83,40 +87,21 @@ QString CustomDataHandler::change(const QUrl &)
 
 QString CustomDataHandler::replace(const QUrl &oldUrl, const QUrl &newUrl)
 {
-    CollectionBaseDataPtr old;
-    int oldIdx = -1;
-    int newIdx = -1;
-    for (auto iter = collections.begin(); iter != collections.end(); ++iter) {
-        if (oldIdx < 0) {
-            oldIdx = iter.value()->items.indexOf(oldUrl);
-            if (oldIdx >= 0) {
-                // find old
-                old = iter.value();
-            }
-        }
-
-        if (newIdx < 0)
-            newIdx = iter.value()->items.indexOf(newUrl);
-
-        if (oldIdx >= 0 && newIdx >= 0)
-            break;
-    }
-
-    if (oldIdx < 0) {
+    const QString oldKey = key(oldUrl);
+    if (oldKey.isEmpty()) {
         fmWarning() << "Replace failed - old URL not found:" << oldUrl;
         return "";
     }
 
-    if (newIdx >= 0) {
+    if (!key(newUrl).isEmpty()) {
         fmWarning() << "Replace failed - new URL already exists:" << newUrl;
         return "";
     }
 
-    Q_ASSERT(old);
-    old->items.replace(oldIdx, newUrl);
-    emit itemsChanged(old->key);
+    replaceItem(oldUrl, newUrl);
+    emit itemsChanged(oldKey);
 
-    return old->key;
+    return oldKey;
 }
 
 QString CustomDataHandler::append(const QUrl &)
@@ -138,10 +123,7 @@ void CustomDataHandler::insert(const QUrl &url, const QString &key, const int in
         base->key = key;
         base->items << url;
     } else {
-        if (it.value()->items.size() < index || index < 0)
-            it.value()->items.append(url);
-        else
-            it.value()->items.insert(index, url);
+        insertItem(key, url, index);
     }
 
     emit itemsChanged(key);
@@ -151,24 +133,15 @@ bool CustomDataHandler::acceptInsert(const QUrl &url)
 {
     // todo(wcl) 新建流程
 
-    for (auto iter = collections.begin(); iter != collections.end(); ++iter) {
-        if (iter.value()->items.contains(url)) {
-            return true;
-        }
-    }
-
-    return false;
+    return urlIndex.contains(url);
 }
 
 QList<QUrl> CustomDataHandler::acceptReset(const QList<QUrl> &urls)
 {
     QList<QUrl> ret;
     for (const QUrl &url : urls) {
-        for (auto iter = collections.begin(); iter != collections.end(); ++iter) {
-            if (iter.value()->items.contains(url)) {
-                ret << url;
-            }
-        }
+        if (urlIndex.contains(url))
+            ret << url;
     }
 
     return ret;
@@ -176,11 +149,5 @@ QList<QUrl> CustomDataHandler::acceptReset(const QList<QUrl> &urls)
 
 bool CustomDataHandler::acceptRename(const QUrl &oldUrl, const QUrl &newUrl)
 {
-    for (auto iter = collections.begin(); iter != collections.end(); ++iter) {
-        if (iter.value()->items.contains(oldUrl)
-            || iter.value()->items.contains(newUrl))
-            return true;
-    }
-
-    return false;
+    return urlIndex.contains(oldUrl) || urlIndex.contains(newUrl);
 }
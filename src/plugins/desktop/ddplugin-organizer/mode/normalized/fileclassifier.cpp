@@ -35,6 +35,8 @@ FileClassifier::FileClassifier(QObject *parent)
 void FileClassifier::reset(const QList<QUrl> &urls)
 {
     collections.clear();
+    urlIndex.clear();
+    positionIndex.clear();
     for (const QString &id : classes()) {
         CollectionBaseDataPtr dp(new CollectionBaseData);
         dp->name = className(id);
@@ -52,7 +54,7 @@ void FileClassifier::reset(const QList<QUrl> &urls)
 
         auto it = collections.find(type);
         if (it != collections.end())
-            it.value()->items.append(url);
+            insertItem(type, url);
         else
             Q_ASSERT_X(it == collections.end(), "TypeClassifier", QString("unrecognized type %0").arg(type).toStdString().c_str());
     }
@@ -82,19 +84,18 @@ QString FileClassifier::replace(const QUrl &oldUrl, const QUrl &newUrl)
 
     if (Q_UNLIKELY(newType.isEmpty())) {
         fmWarning() << "can not find file:" << newUrl;
-        collections[oldType]->items.removeOne(oldUrl);
+        removeItem(oldUrl);
         return newType;
     }
 
     if (oldType == newType) {
-        int idx = collections[newType]->items.indexOf(oldUrl);
-        collections[newType]->items.replace(idx, newUrl);
+        replaceItem(oldUrl, newUrl);
         emit itemsChanged(newType);
     } else {
-        collections[oldType]->items.removeOne(oldUrl);
+        removeItem(oldUrl);
         emit itemsChanged(oldType);
 
-        collections[newType]->items.append(newUrl);
+        insertItem(newType, newUrl);
         emit itemsChanged(newType);
     }
 #else
@@ -156,17 +157,17 @@ QString FileClassifier::append(const QUrl &url)
     if (cur.isEmpty()) {
         auto it = collections.find(ret);
         if (it != collections.end()) {
-            it.value()->items.append(url);
+            insertItem(ret, url);
             emit itemsChanged(ret);
         } else {
             Q_ASSERT_X(it == collections.end(), "TypeClassifier", QString("unrecognized type %0").arg(ret).toStdString().c_str());
         }
     } else {   // existed
         if (cur != ret) {
-            collections[cur]->items.removeOne(url);
+            removeItem(url);
             emit itemsChanged(cur);
 
-            collections[ret]->items.append(url);
+            insertItem(ret, url);
             emit itemsChanged(ret);
         }
     }
@@ -188,17 +189,17 @@ QString FileClassifier::prepend(const QUrl &url)
     if (cur.isEmpty()) {
         auto it = collections.find(ret);
         if (it != collections.end()) {
-            it.value()->items.prepend(url);
+            insertItem(ret, url, 0);
             emit itemsChanged(ret);
         } else {
             Q_ASSERT_X(it == collections.end(), "TypeClassifier", QString("unrecognized type %0").arg(ret).toStdString().c_str());
         }
     } else {   // existed
         if (cur != ret) {
-            collections[cur]->items.removeOne(url);
+            removeItem(url);
             emit itemsChanged(cur);
 
-            collections[ret]->items.prepend(url);
+            insertItem(ret, url, 0);
             emit itemsChanged(ret);
         }
     }
@@ -213,14 +214,10 @@ void FileClassifier::insert(const QUrl &, const QString &, const int)
 
 QString FileClassifier::remove(const QUrl &url)
 {
-    QString ret;
-    for (auto itor = collections.begin(); itor != collections.end(); ++itor) {
-        if (itor.value()->items.contains(url)) {
-            itor.value()->items.removeOne(url);
-            ret = itor.key();
-            emit itemsChanged(ret);
-            break;
-        }
+    QString ret = key(url);
+    if (!ret.isEmpty()) {
+        removeItem(url);
+        emit itemsChanged(ret);
     }
 
     return ret;
@@ -236,10 +233,10 @@ QString FileClassifier::change(const QUrl &url)
 
     QString ret = classify(url);
     if (ret != cur) {
-        collections[cur]->items.removeOne(url);
+        removeItem(url);
         emit itemsChanged(cur);
 
-        collections[ret]->items.append(url);
+        insertItem(ret, url);
         emit itemsChanged(ret);
 
         return ret;
@@ -262,11 +262,8 @@ bool TypeClassifier::acceptRename(const QUrl &oldUrl, const QUrl &newUrl)
     if (!CfgPresenter->organizeOnTriggered())
         return FileClassifier::acceptRename(oldUrl, newUrl);
 
-    QList<QUrl> collected;
-    for (auto base : baseData())
-        collected.append(base->items);
-    if (collected.contains(newUrl)) {
-        if (!collected.contains(oldUrl)) {
+    if (!key(newUrl).isEmpty()) {
+        if (key(oldUrl).isEmpty()) {
             // oldUrl not in collection (e.g., temporary file .EmvVrz), newUrl in collection
             // This is a file content replacement (save operation), not file overwrite
             // Keep the file in collection without removing it
@@ -277,7 +274,7 @@ bool TypeClassifier::acceptRename(const QUrl &oldUrl, const QUrl &newUrl)
         // Remove newUrl before processing the rename
         remove(newUrl);
         return true;
-    } else if (collected.contains(oldUrl)) {
+    } else if (!key(oldUrl).isEmpty()) {
         return true;
     }
     return false;
@@ -24,6 +24,7 @@
 #include <dfm-framework/dpf.h>
 
 #include <QScrollBar>
+#include <QSet>
 #include <QDebug>
 #include <QTime>
 
@@ -435,15 +436,21 @@ void NormalizedModePrivate::restore(const QList<CollectionBaseDataPtr> &cfgs, bo
     // order by config
     for (const CollectionBaseDataPtr &cfg : cfgs) {
         if (auto base = classifier->baseData(cfg->key)) {
-            QList<QUrl> org = base->items;
             QList<QUrl> ordered;
+            QSet<QUrl> picked;
             for (const QUrl &old : cfg->items) {
-                if (org.contains(old)) {
+                if (classifier->key(old) == cfg->key && !picked.contains(old)) {
                     ordered << old;
-                    org.removeOne(old);
+                    picked.insert(old);
                 }
             }
 
+            QList<QUrl> org;
+            for (const QUrl &url : base->items) {
+                if (!picked.contains(url))
+                    org << url;
+            }
+
             // those are not in config files should not be organized.
             if (reorganized || !CfgPresenter->organizeOnTriggered())
                 ordered.append(org);
@@ -452,7 +459,7 @@ void NormalizedModePrivate::restore(const QList<CollectionBaseDataPtr> &cfgs, bo
                 relayoutedCollectionIDs.insert(cfg->key);
             }
 
-            base->items = ordered;
+            classifier->setItems(cfg->key, ordered);
         }
     }
 }
@@ -777,10 +784,11 @@ void NormalizedMode::rebuild(bool reorganize)
         // This prevents newly enabled categories from auto-organizing files on desktop restart.
         if (!reorganize && CfgPresenter->organizeOnTriggered()) {
             QList<QUrl> organizedFiles;
+            const QSet<QUrl> fileSet(files.cbegin(), files.cend());
             for (const CollectionBaseDataPtr &profile : profiles) {
                 std::copy_if(profile->items.cbegin(), profile->items.cend(),
                              std::back_inserter(organizedFiles),
-                             [&files](const QUrl &url) { return files.contains(url); });
+                             [&fileSet](const QUrl &url) { return fileSet.contains(url); });
             }
             fmInfo() << "Organize on trigger mode: only restoring" << organizedFiles.size()
                      << "organized files from" << files.size() << "total files";
@@ -870,10 +878,9 @@ void NormalizedMode::onFileRenamed(const QUrl &oldUrl, const QUrl &newUrl)
         }
         QString newType = d->classifier->classify(newUrl);
         if (newType == oldType) {
-            auto idx = d->classifier->baseData(oldType)->items.indexOf(oldUrl);
-            d->classifier->baseData(oldType)->items.replace(idx, newUrl);
+            d->classifier->replaceItem(oldUrl, newUrl);
         } else {
-            d->classifier->baseData(oldType)->items.removeAll(oldUrl);
+            d->classifier->removeItem(oldUrl);
             dpfSlotChannel->push("ddplugin_canvas", "slot_CanvasView_Select", QList<QUrl> { newUrl });
         }
 
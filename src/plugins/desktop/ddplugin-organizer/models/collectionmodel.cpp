@@ -37,6 +37,7 @@ CollectionModelPrivate::~CollectionModelPrivate()
 void CollectionModelPrivate::reset()
 {
     fileList.clear();
+    rowIndex.clear();
     fileMap.clear();
 
     auto model = q->sourceModel();
@@ -68,6 +69,7 @@ void CollectionModelPrivate::reset()
 void CollectionModelPrivate::clearMapping()
 {
     fileList.clear();
+    rowIndex.clear();
     fileMap.clear();
 }
 
@@ -84,6 +86,7 @@ void CollectionModelPrivate::createMapping()
     }
 
     fileList = handler->acceptReset(shell->files());
+    rowIndex.reset();
     QMap<QUrl, FileInfoPointer> maps;
     for (const QUrl &url : fileList)
         maps.insert(url, shell->fileInfo(shell->index(url)));
@@ -106,8 +109,9 @@ void CollectionModelPrivate::sourceDataChanged(const QModelIndex &sourceTopleft,
         auto cur = q->index(url);
 
         if (handler && handler->acceptUpdate(url, roles)) {
-            if (!fileList.contains(url)) {
+            if (!rowIndex.contains(url)) {
                 fileList.append(url);
+                rowIndex.append(url);
                 fileMap.insert(url, shell->fileInfo(q->sourceModel()->index(i, 0)));
             }
         }
@@ -164,6 +168,7 @@ void CollectionModelPrivate::sourceRowsInserted(const QModelIndex &sourceParent,
     q->beginInsertRows(q->rootIndex(), row, row + files.count() - 1);
 
     fileList.append(files);
+    rowIndex.append(files);
     for (const QUrl &url : files)
         fileMap.insert(url, shell->fileInfo(shell->index(url)));
 
@@ -185,25 +190,12 @@ void CollectionModelPrivate::sourceRowsAboutToBeRemoved(const QModelIndex &sourc
             files << url;
     }
 
-    if (files.isEmpty())
-        return;
-
-    // remove one by one
-    for (const QUrl &url : files) {
-        int row = fileList.indexOf(url);
-        if (row < 0)
-            continue;
-
-        q->beginRemoveRows(q->rootIndex(), row, row);
-        fileList.removeAt(row);
-        fileMap.remove(url);
-        q->endRemoveRows();
-    }
+    removeUrls(files);
 }
 
 void CollectionModelPrivate::sourceDataRenamed(const QUrl &oldUrl, const QUrl &newUrl)
 {
-    int row = fileList.indexOf(oldUrl);
+    int row = rowIndex.row(oldUrl);
     auto newInfo = shell->fileInfo(shell->index(newUrl));
     bool accept = false;
     if (handler)
@@ -216,6 +208,7 @@ void CollectionModelPrivate::sourceDataRenamed(const QUrl &oldUrl, const QUrl &n
             row = fileList.count();
             q->beginInsertRows(q->rootIndex(), row, row);
             fileList.append(newUrl);
+            rowIndex.append(newUrl);
             fileMap.insert(newUrl, newInfo);
             q->endInsertRows();
             fmDebug() << "Inserted renamed file as new item";
@@ -228,12 +221,14 @@ void CollectionModelPrivate::sourceDataRenamed(const QUrl &oldUrl, const QUrl &n
                 //! treat as removing if newurl is existed in organizer.
                 q->beginRemoveRows(q->rootIndex(), row, row);
                 fileList.removeAt(row);
+                rowIndex.remove(oldUrl);
                 fileMap.remove(oldUrl);
                 q->endRemoveRows();
 
-                row = fileList.indexOf(newUrl);
+                row = rowIndex.row(newUrl);
             } else {
                 fileList.replace(row, newUrl);
+                rowIndex.replace(oldUrl, newUrl);
                 fileMap.remove(oldUrl);
                 fileMap.insert(newUrl, newInfo);
                 emit q->dataReplaced(oldUrl, newUrl);
@@ -244,12 +239,50 @@ void CollectionModelPrivate::sourceDataRenamed(const QUrl &oldUrl, const QUrl &n
         } else {
             q->beginRemoveRows(q->rootIndex(), row, row);
             fileList.removeAt(row);
+            rowIndex.remove(oldUrl);
             fileMap.remove(oldUrl);
             q->endRemoveRows();
         }
     }
 }
 
+void CollectionModelPrivate::removeUrls(const QList<QUrl> &urls)
+{
+    QList<int> rows;
+    rows.reserve(urls.size());
+    for (const QUrl &url : urls) {
+        int row = rowIndex.row(url);
+        if (row >= 0)
+            rows.append(row);
+    }
+
+    if (rows.isEmpty())
+        return;
+
+    // merge contiguous rows into one range and remove from the bottom,
+    // so that the rows of the remaining ranges stay valid.
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    int end = rows.size() - 1;
+    while (end >= 0) {
+        int begin = end;
+        while (begin > 0 && rows.at(begin - 1) == rows.at(begin) - 1)
+            --begin;
+
+        const int first = rows.at(begin);
+        const int last = rows.at(end);
+        q->beginRemoveRows(q->rootIndex(), first, last);
+        for (int i = last; i >= first; --i) {
+            const QUrl url = fileList.takeAt(i);
+            rowIndex.remove(url);
+            fileMap.remove(url);
+        }
+        q->endRemoveRows();
+
+        end = begin - 1;
+    }
+}
+
 void CollectionModelPrivate::doRefresh(bool global, bool file)
 {
     if (global) {
@@ -327,10 +360,9 @@ QModelIndex CollectionModel::index(const QUrl &url, int column) const
     if (!url.isValid())
         return QModelIndex();
 
-    if (d->fileMap.contains(url)) {
-        int row = d->fileList.indexOf(url);
+    int row = d->rowIndex.row(url);
+    if (row >= 0)
         return createIndex(row, column);
-    }
 
     return QModelIndex();
 }
@@ -397,6 +429,7 @@ bool CollectionModel::fetch(const QList<QUrl> &urls)
     beginInsertRows(rootIndex(), row, row + urls.count() - 1);
 
     d->fileList.append(urls);
+    d->rowIndex.append(urls);
     for (const QUrl &url : urls)
         d->fileMap.insert(url, d->shell->fileInfo(d->shell->index(url)));
 
@@ -407,18 +440,7 @@ bool CollectionModel::fetch(const QList<QUrl> &urls)
 
 bool CollectionModel::take(const QList<QUrl> &urls)
 {
-    // remove one by one
-    for (const QUrl &url : urls) {
-        int row = d->fileList.indexOf(url);
-        if (row < 0)
-            continue;
-
-        beginRemoveRows(rootIndex(), row, row);
-        d->fileList.removeAt(row);
-        d->fileMap.remove(url);
-        endRemoveRows();
-    }
-
+    d->removeUrls(urls);
     return true;
 }
 
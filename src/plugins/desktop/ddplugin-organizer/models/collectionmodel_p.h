@@ -8,6 +8,7 @@
 #include "collectionmodel.h"
 
 #include <dfm-base/file/local/syncfileinfo.h>
+#include <dfm-base/utils/urlrowindex.h>
 
 #include <QTimer>
 
@@ -23,6 +24,7 @@ public:
     void clearMapping();
     void createMapping();
     void doRefresh(bool global, bool file);
+    void removeUrls(const QList<QUrl> &urls);
 public slots:
     void sourceDataChanged(const QModelIndex &sourceTopleft,
                            const QModelIndex &sourceBottomright,
@@ -39,6 +41,7 @@ public:
     FileInfoModelShell *shell = nullptr;
     ModelDataHandler *handler = nullptr;
     QList<QUrl> fileList;
+    DFMBASE_NAMESPACE::UrlRowIndex rowIndex { &fileList };
     QMap<QUrl, FileInfoPointer> fileMap;
     QSharedPointer<QTimer> refreshTimer;
 
@@ -9,31 +9,38 @@
 
 #include <QStandardPaths>
 #include <QApplication>
+#include <QDateTime>
 #include <QDir>
 #include <QtConcurrent>
 #include <QImageReader>
+#include <QImageWriter>
+#include <QSaveFile>
+#include <QThread>
 
 using namespace ddplugin_wallpapersetting;
 
+// the source file's mtime and size are stored in the thumbnail's PNG text chunk,
+// a changed wallpaper no longer matches and is regenerated.
+static constexpr char kSourceStampKey[] { "Source-Stamp" };
+
 ThumbnailManager::ThumbnailManager(qreal _scale, QObject *parent)
-    : QObject(parent), scale(_scale), cacheDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation))
+    : QObject(parent), scale(_scale), cacheDir(cacheDirectory(_scale))
 {
-
-    // old dir
-    //cacheDir = cacheDir + QDir::separator() + qApp->applicationVersion() + QDir::separator() + QString::number(scale);
-    // using `wallpaperthumbnail` dir to replace `applicationVersion(` dir to reduce redundant disk usage
-    cacheDir = DFMIO::DFMUtils::buildFilePath(cacheDir.toStdString().c_str(),
-                                              "wallpaperthumbnail", QString::number(scale).toStdString().c_str(), nullptr);
-
-    connect(&futureWatcher, &QFutureWatcher<QPixmap>::finished, this, &ThumbnailManager::onProcessFinished, Qt::QueuedConnection);
+    // decoding is CPU bound, leave some cores for the desktop itself
+    maxRunning = qBound(1, QThread::idealThreadCount() / 2, 4);
 
     QDir::root().mkpath(cacheDir);
 }
 
 ThumbnailManager::~ThumbnailManager()
 {
-    if (!queuedRequests.isEmpty())
-        emit findAborted(queuedRequests);
+    QQueue<QString> aborted;
+    for (const QString &key : runningRequests)
+        aborted << key;
+    aborted << queuedRequests;
+
+    if (!aborted.isEmpty())
+        emit findAborted(aborted);
 }
 
 ThumbnailManager *ThumbnailManager::instance(qreal scale)
@@ -51,84 +58,167 @@ ThumbnailManager *ThumbnailManager::instance(qreal scale)
     return manager;
 }
 
-void ThumbnailManager::find(const QString &key)
+void ThumbnailManager::find(const QString &key, bool prior)
 {
     QString file = QDir(cacheDir).absoluteFilePath(key);
-    const QPixmap pixmap(file);
-    if (!pixmap.isNull()) {
-        emit thumbnailFounded(key, pixmap);
+    QImageReader reader(file);
+    if (reader.canRead() && reader.text(kSourceStampKey) == sourceStamp(sourcePath(key))) {
+        const QPixmap pixmap = QPixmap::fromImage(reader.read());
+        if (!pixmap.isNull()) {
+            emit thumbnailFounded(key, pixmap);
+            return;
+        }
+    }
+
+    for (const QString &running : runningRequests) {
+        if (running == key)
+            return;
+    }
+
+    const int pos = queuedRequests.indexOf(key);
+    if (pos >= 0) {
+        if (prior)
+            queuedRequests.move(pos, 0);
         return;
     }
 
-    queuedRequests << key;
+    if (prior)
+        queuedRequests.prepend(key);
+    else
+        queuedRequests.enqueue(key);
 
-    // first item, start
-    if (queuedRequests.size() == 1)
-        processNextReq();
+    processNextReq();
 }
 
 void ThumbnailManager::stop()
 {
-    futureWatcher.cancel();
+    // running tasks can not be interrupted, they finish in background and still fill the disk cache.
+    for (auto it = runningRequests.begin(); it != runningRequests.end(); ++it) {
+        it.key()->disconnect(this);
+        it.key()->deleteLater();
+    }
+    runningRequests.clear();
     queuedRequests.clear();
 }
 
 bool ThumbnailManager::replace(const QString &key, const QPixmap &pixmap)
 {
     QString file = QDir(cacheDir).absoluteFilePath(key);
-    if (QFile::exists(file)) {
-        QFile(file).remove();
-    }
-
-    return pixmap.save(file);
+    return saveThumbnail(file, pixmap, sourceStamp(sourcePath(key)));
 }
 
 QPixmap ThumbnailManager::thumbnailImage(const QString &key, qreal scale)
 {
-    ThumbnailManager *tnm = ThumbnailManager::instance(scale);
-    // key is percent-encoded filepath. see WallpaperItem::setPath and WallpaperItem::thumbnailKey
-    const QString realPath = QUrl(QUrl::fromPercentEncoding(key.toUtf8())).toLocalFile();
+    // running in thread pool, do not touch the manager instance here.
+    const QString realPath = sourcePath(key);
+    const QString stamp = sourceStamp(realPath);
     const qreal ratio = scale;
+    const int itemWidth = static_cast<int>(WallpaperList::kItemWidth * ratio);
+    const int itemHeight = static_cast<int>(WallpaperList::kItemHeight * ratio);
+    const QSize size(itemWidth, itemHeight);
 
     QImageReader imageReader(realPath);
     imageReader.setDecideFormatFromContent(true);
+
+    // let the decoder produce the target size directly instead of decoding full resolution:
+    // jpeg downsamples during IDCT, other formats at least never keep the full image around.
+    const QSize sourceSize = imageReader.size();
+    if (sourceSize.isValid()) {
+        const QSize decodeSize = sourceSize.scaled(size, Qt::KeepAspectRatioByExpanding);
+        if (decodeSize.width() < sourceSize.width())
+            imageReader.setScaledSize(decodeSize);
+    }
+
     QImage image = imageReader.read();
-    const int itemWidth = static_cast<int>(WallpaperList::kItemWidth * ratio);
-    const int itemHeight = static_cast<int>(WallpaperList::kItemHeight * ratio);
-    QPixmap pix = QPixmap::fromImage(image.scaled(QSize(itemWidth, itemHeight), Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation));
+    if (image.size() != size)
+        image = image.scaled(size, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+    QPixmap pix = QPixmap::fromImage(image);
 
     const QRect r(0, 0, itemWidth, itemHeight);
-    const QSize size(itemWidth, itemHeight);
 
     if (pix.width() > itemWidth || pix.height() > itemHeight)
         pix = pix.copy(QRect(pix.rect().center() - r.center(), size));
 
     pix.setDevicePixelRatio(ratio);
 
-    tnm->replace(key, pix);
+    saveThumbnail(QDir(cacheDirectory(scale)).absoluteFilePath(key), pix, stamp);
 
     return pix;
 }
 
-void ThumbnailManager::onProcessFinished()
+void ThumbnailManager::onProcessFinished(QFutureWatcher<QPixmap> *watcher)
 {
-    if (futureWatcher.isCanceled())
-        return;
+    const QString key = runningRequests.take(watcher);
+    watcher->deleteLater();
 
-    emit thumbnailFounded(queuedRequests.front(), futureWatcher.result());
+    if (key.isEmpty())
+        return;
 
-    queuedRequests.pop_front();
+    emit thumbnailFounded(key, watcher->result());
 
-    if (!queuedRequests.isEmpty())
-        processNextReq();
+    processNextReq();
 }
 
 void ThumbnailManager::processNextReq()
 {
-    Q_ASSERT(futureWatcher.isFinished());
+    while (!queuedRequests.isEmpty() && runningRequests.size() < maxRunning) {
+        const QString item = queuedRequests.dequeue();
+
+        auto watcher = new QFutureWatcher<QPixmap>(this);
+        connect(watcher, &QFutureWatcher<QPixmap>::finished, this, [this, watcher]() {
+            onProcessFinished(watcher);
+        });
+        runningRequests.insert(watcher, item);
+
+        QFuture<QPixmap> future = QtConcurrent::run(ThumbnailManager::thumbnailImage, item, scale);
+        watcher->setFuture(future);
+    }
+}
 
-    const QString &item = queuedRequests.front();
+QString ThumbnailManager::cacheDirectory(qreal scale)
+{
+    // old dir
+    //cacheDir = cacheDir + QDir::separator() + qApp->applicationVersion() + QDir::separator() + QString::number(scale);
+    // using `wallpaperthumbnail` dir to replace `applicationVersion(` dir to reduce redundant disk usage
+    const QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    return DFMIO::DFMUtils::buildFilePath(cacheDir.toStdString().c_str(),
+                                          "wallpaperthumbnail", QString::number(scale).toStdString().c_str(), nullptr);
+}
+
+QString ThumbnailManager::sourcePath(const QString &key)
+{
+    // key is percent-encoded filepath. see WallpaperItem::setPath and WallpaperItem::thumbnailKey
+    return QUrl(QUrl::fromPercentEncoding(key.toUtf8())).toLocalFile();
+}
+
+QString ThumbnailManager::sourceStamp(const QString &path)
+{
+    const QFileInfo info(path);
+    if (!info.exists())
+        return QString();
+
+    return QString("%1-%2").arg(info.lastModified().toMSecsSinceEpoch()).arg(info.size());
+}
+
+bool ThumbnailManager::saveThumbnail(const QString &file, const QPixmap &pixmap, const QString &stamp)
+{
+    if (pixmap.isNull())
+        return false;
+
+    QImage image = pixmap.toImage();
+    image.setText(kSourceStampKey, stamp);
+
+    // always png: the key keeps the wallpaper's suffix, which would otherwise pick a lossy format.
+    // write to a temp file so that a concurrent reader never sees a partial image.
+    QSaveFile saveFile(file);
+    if (!saveFile.open(QIODevice::WriteOnly))
+        return false;
+
+    QImageWriter writer(&saveFile, "png");
+    if (!writer.write(image)) {
+        saveFile.cancelWriting();
+        return false;
+    }
 
-    QFuture<QPixmap> future = QtConcurrent::run(ThumbnailManager::thumbnailImage, item, scale);
-    futureWatcher.setFuture(future);
+    return saveFile.commit();
 }
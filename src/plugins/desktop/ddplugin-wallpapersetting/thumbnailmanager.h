@@ -9,6 +9,7 @@
 
 #include <QObject>
 #include <QQueue>
+#include <QHash>
 #include <QFutureWatcher>
 #include <QPixmap>
 
@@ -21,7 +22,8 @@ public:
     explicit ThumbnailManager(qreal scale, QObject *parent = nullptr);
     ~ThumbnailManager();
     static ThumbnailManager* instance(qreal scale);
-    void find(const QString & key);
+    // prior: visible items jump ahead of queued off-screen requests
+    void find(const QString & key, bool prior = false);
     void stop();
 protected:
     bool replace(const QString & key, const QPixmap & pixmap);
@@ -30,15 +32,18 @@ signals:
     void thumbnailFounded(const QString &key, const QPixmap &pixmap);
     void findAborted(QQueue<QString> queue);
 
-public slots:
-private slots:
-    void onProcessFinished();
 private:
     void processNextReq();
+    void onProcessFinished(QFutureWatcher<QPixmap> *watcher);
+    static QString cacheDirectory(qreal scale);
+    static QString sourcePath(const QString &key);
+    static QString sourceStamp(const QString &path);
+    static bool saveThumbnail(const QString &file, const QPixmap &pixmap, const QString &stamp);
 private:
     qreal scale;
     QString cacheDir;
-    QFutureWatcher<QPixmap> futureWatcher;
+    int maxRunning;
+    QHash<QFutureWatcher<QPixmap> *, QString> runningRequests;
     QQueue<QString> queuedRequests;
 };
 
@@ -134,10 +134,10 @@ void WallpaperItem::slideDown()
     }
 }
 
-void WallpaperItem::renderPixmap()
+void WallpaperItem::renderPixmap(bool prior)
 {
     if (enablethumbnail) {
-        refindPixmap();
+        refindPixmap(prior);
     } else {
         QIcon icon(sketch());
         // scale to full up
@@ -319,14 +319,14 @@ bool WallpaperItem::eventFilter(QObject *watched, QEvent *event)
     return QFrame::eventFilter(watched, event);
 }
 
-void WallpaperItem::refindPixmap()
+void WallpaperItem::refindPixmap(bool prior)
 {
     ThumbnailManager *tnm = ThumbnailManager::instance(devicePixelRatioF());
 
     connect(tnm, &ThumbnailManager::thumbnailFounded, this, &WallpaperItem::onThumbnailFounded, Qt::UniqueConnection);
     connect(tnm, &ThumbnailManager::findAborted, this, &WallpaperItem::onFindAborted, Qt::UniqueConnection);
 
-    tnm->find(thumbnailKey());
+    tnm->find(thumbnailKey(), prior);
 }
 
 void WallpaperItem::focusOnLastButton()
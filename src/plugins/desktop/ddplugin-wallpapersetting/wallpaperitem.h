@@ -67,7 +67,7 @@ public:
     void setOpacity(qreal opacity);
     void slideUp();
     void slideDown();
-    void renderPixmap();
+    void renderPixmap(bool prior = false);
     QRect contentGeometry() const;
     QPushButton *addButton(const QString &id, const QString &text, const int btnWidth, int row, int column, int rowSpan, int columnSpan);
     void setEntranceIconOfSettings(const QString &id);
@@ -91,7 +91,7 @@ protected:
     void leaveEvent(QEvent *event) override;
     void resizeEvent(QResizeEvent *event) override;
     bool eventFilter(QObject *watched, QEvent *event) override;
-    void refindPixmap();
+    void refindPixmap(bool prior = false);
     void focusOnLastButton();
     void focusOnFirstButton();
     QString thumbnailKey() const;
@@ -387,12 +387,23 @@ void WallpaperList::updateItemThumb()
     showDeleteButtonForItem(static_cast<WallpaperItem *>(itemAt(mapFromGlobal(QCursor::pos()))));
     QRect r = rect();
     QRect cacheRect(r.x() - r.width(), r.y(), r.width() * 3, r.height());
+    QList<WallpaperItem *> visibleItems;
+    QList<WallpaperItem *> neighbors;
     for (WallpaperItem *item : items) {
-        if (cacheRect.intersects(QRect(item->mapTo(this, QPoint()), item->size()))) {
-            item->renderPixmap();
-        }
+        const QRect itemRect(item->mapTo(this, QPoint()), item->size());
+        if (r.intersects(itemRect))
+            visibleItems.append(item);
+        else if (cacheRect.intersects(itemRect))
+            neighbors.append(item);
     }
 
+    // visible items jump to the head of the queue (in reverse, so the leftmost comes first),
+    // the pages on both sides are prepared afterwards.
+    for (auto it = visibleItems.crbegin(); it != visibleItems.crend(); ++it)
+        (*it)->renderPixmap(true);
+    for (WallpaperItem *item : neighbors)
+        item->renderPixmap();
+
     updateBothEndsItem();
 }
 
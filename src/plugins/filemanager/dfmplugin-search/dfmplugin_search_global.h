@@ -64,6 +64,7 @@ inline constexpr char kEnableFullTextSearch[] { "enableFullTextSearch" };
 inline constexpr char kEnableOcrTextSearch[] { "enableOcrTextSearch" };
 inline constexpr char kEnableSemanticSearch[] { "enableSemanticSearch" };
 inline constexpr char kSearchAuthHintDone[] { "searchAuthHintDone" };
+inline constexpr char kSearchWatchBudget[] { "searchWatchBudget" };
 }
 
 DPSEARCH_END_NAMESPACE
@@ -80,6 +80,7 @@ void SearchDirIteratorPrivate::doSearch()
 
     winId = SearchHelper::searchWinId(fileUrl).toULongLong();
     taskId = QUuid::createUuid().toString(QUuid::WithoutBraces);
+    fetchedSeq = 0;
     SearchEventCaller::sendStartSpinner(winId);
     SearchManager::instance()->search(winId, taskId, targetUrl, SearchHelper::searchKeyword(fileUrl));
 }
@@ -87,10 +88,10 @@ void SearchDirIteratorPrivate::doSearch()
 void SearchDirIteratorPrivate::onMatched(const QString &id)
 {
     if (taskId == id) {
-        // 直接在主线程更新结果，但使用高效的双缓冲机制
-        const auto &results = SearchManager::instance()->matchedResults(taskId);
+        // 只取上次之后新增的结果
+        const auto &results = SearchManager::instance()->matchedResults(taskId, fetchedSeq, &fetchedSeq);
         if (!results.isEmpty()) {
-            resultBuffer.updateResults(results);
+            resultBuffer.appendResults(results);
             hasConsumedResults.store(false, std::memory_order_release);   // 标记有新数据
         }
 
@@ -206,11 +207,11 @@ QList<QSharedPointer<SortFileInfo>> SearchDirIterator::sortFileInfoList()
     // SortInfoPointer into getGroupKey) to classify Exact vs Smart. No shared
     // registry: the match method travels with the data, so there is nothing
     // to race against or to outlive.
-    for (auto it = results.begin(); it != results.end(); ++it) {
+    for (const DFMSearchResult &searchResult : results) {
         auto sortInfo = QSharedPointer<SortFileInfo>(new SortFileInfo());
-        sortInfo->setUrl(it.key());
-        sortInfo->setSearchKeyword(it->keyword());
-        sortInfo->setSearchType(static_cast<int>(it->searchType()));
+        sortInfo->setUrl(searchResult.url());
+        sortInfo->setSearchKeyword(searchResult.keyword());
+        sortInfo->setSearchType(static_cast<int>(searchResult.searchType()));
         doCompleteSortInfo(sortInfo);
         files.append(sortInfo);
     }
@@ -301,42 +302,24 @@ void SearchDirIterator::doCompleteSortInfo(SortInfoPointer sortInfo)
 
 // ======== SearchResultBuffer 实现 ========
 
-void SearchResultBuffer::updateResults(const DFMSearchResultMap &newResults)
+void SearchResultBuffer::appendResults(const DFMSearchResultList &newResults)
 {
-    QMutexLocker lock(&writerMutex);
-
-    // 写入非活跃缓冲区
-    if (useBufferA.load(std::memory_order_acquire)) {
-        bufferB = newResults;
-        useBufferA.store(false, std::memory_order_release);   // 原子切换
-    } else {
-        bufferA = newResults;
-        useBufferA.store(true, std::memory_order_release);   // 原子切换
-    }
+    QMutexLocker lock(&mutex);
+    pending.append(newResults);
 }
 
-DFMSearchResultMap SearchResultBuffer::getResults() const
+DFMSearchResultList SearchResultBuffer::consumeResults()
 {
-    // 无锁读取活跃缓冲区
-    return useBufferA.load(std::memory_order_acquire) ? bufferA : bufferB;
-}
-
-DFMSearchResultMap SearchResultBuffer::consumeResults()
-{
-    QMutexLocker lock(&writerMutex);
-    DFMSearchResultMap results;
-    if (useBufferA.load(std::memory_order_acquire)) {
-        results.swap(bufferA);
-    } else {
-        results.swap(bufferB);
-    }
+    QMutexLocker lock(&mutex);
+    DFMSearchResultList results;
+    results.swap(pending);
     return results;
 }
 
 bool SearchResultBuffer::isEmpty() const
 {
-    // 检查当前活跃缓冲区是否为空
-    return useBufferA.load(std::memory_order_acquire) ? bufferA.isEmpty() : bufferB.isEmpty();
+    QMutexLocker lock(&mutex);
+    return pending.isEmpty();
 }
 
 }
@@ -24,30 +24,25 @@ DFMBASE_USE_NAMESPACE
 
 namespace dfmplugin_search {
 
-// 双缓冲搜索结果管理器
+// 待消费的增量搜索结果
 class SearchResultBuffer
 {
 public:
     SearchResultBuffer() = default;
     ~SearchResultBuffer() = default;
 
-    // 生产者：更新搜索结果（主线程调用）
-    void updateResults(const DFMSearchResultMap &newResults);
+    // 生产者：追加新到达的搜索结果（主线程调用）
+    void appendResults(const DFMSearchResultList &newResults);
 
-    // 消费者：获取当前搜索结果快照（子线程调用）
-    DFMSearchResultMap getResults() const;
-
-    // 消费者：获取并清空当前搜索结果（子线程调用）
-    DFMSearchResultMap consumeResults();
+    // 消费者：取出所有未消费的结果（子线程调用）
+    DFMSearchResultList consumeResults();
 
     // 检查是否有数据
     bool isEmpty() const;
 
 private:
-    mutable DFMSearchResultMap bufferA;
-    mutable DFMSearchResultMap bufferB;
-    std::atomic<bool> useBufferA { true };
-    mutable QMutex writerMutex;   // 只保护写操作
+    DFMSearchResultList pending;
+    mutable QMutex mutex;
 };
 
 class SearchDirIterator;
@@ -72,6 +67,7 @@ public:
     QUrl currentFileUrl;   // 当前处理的URL
     QString currentFileContent;   // 当前处理的文件内容
     QString taskId;   // 搜索任务ID
+    int fetchedSeq { 0 };   // 已从搜索任务取到的结果序号（主线程访问）
     quint64 winId;   // 窗口ID
 
     std::atomic<bool> searchFinished { false };   // 搜索是否完成(原子操作保证线程安全)
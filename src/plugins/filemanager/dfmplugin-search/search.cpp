@@ -78,8 +78,8 @@ void Search::initialize()
     // 注册 HighlightProvider 的 fetchHighlight 回调（延迟加载模式）
     HighlightProvider::instance()->setFetchCallback(
             [](const QString &path, const QString &keyword, int searchType) -> QString {
-                // Reuse the retriever in the worker thread to avoid rebuilding it
-                // for every highlight request.
+                // Called concurrently from the provider's worker pool; one retriever
+                // per worker thread avoids rebuilding it for every highlight request.
                 thread_local DFMSEARCH::ContentRetriever retriever;
 
                 DFMSEARCH::HighlightOptions opts;
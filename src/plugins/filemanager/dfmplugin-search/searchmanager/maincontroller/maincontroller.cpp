@@ -63,10 +63,10 @@ void MainController::stop(QString taskId)
     }
 }
 
-DFMSearchResultMap MainController::getResults(QString taskId)
+DFMSearchResultList MainController::getResults(QString taskId, int from, int *next)
 {
     if (taskManager.contains(taskId))
-        return taskManager[taskId]->getResults();
+        return taskManager[taskId]->getResults(from, next);
 
     return {};
 }
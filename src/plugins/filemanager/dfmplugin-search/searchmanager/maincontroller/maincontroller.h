@@ -24,8 +24,8 @@ private:
     bool doSearchTask(QString taskId, const QUrl &url, const QString &keyword);
     void stop(QString taskId);
     
-    // 获取统一的搜索结果
-    DFMSearchResultMap getResults(QString taskId);
+    // 增量获取统一的搜索结果
+    DFMSearchResultList getResults(QString taskId, int from, int *next);
     
     // 为兼容性保留的接口
     QList<QUrl> getResultUrls(QString taskId);
@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "searchresultlog.h"
+
+DPSEARCH_USE_NAMESPACE
+
+void SearchResultLog::clear()
+{
+    QWriteLocker locker(&lock);
+    entries.clear();
+    index.clear();
+}
+
+int SearchResultLog::merge(const DFMSearchResultMap &batch)
+{
+    if (batch.isEmpty())
+        return 0;
+
+    QWriteLocker locker(&lock);
+    const int before = entries.size();
+    entries.reserve(before + batch.size());
+
+    for (auto it = batch.constBegin(); it != batch.constEnd(); ++it) {
+        auto existing = index.find(it.key());
+        if (existing == index.end()) {
+            index.insert(it.key(), entries.size());
+        } else {
+            // 保留匹配分数更高的结果
+            if (it.value().matchScore() <= entries.at(existing.value()).matchScore())
+                continue;
+            existing.value() = entries.size();
+        }
+        entries.append(it.value());
+    }
+
+    return entries.size() - before;
+}
+
+DFMSearchResultList SearchResultLog::resultsSince(int from, int *next) const
+{
+    QReadLocker locker(&lock);
+    const int total = entries.size();
+    if (next)
+        *next = total;
+
+    DFMSearchResultList results;
+    if (from < 0)
+        from = 0;
+    if (from >= total)
+        return results;
+
+    // 同一 url 在这段日志中出现多次时只返回最新的一条，消费者按 url 去重时不会丢掉分数更高的结果
+    results.reserve(total - from);
+    for (int i = from; i < total; ++i) {
+        const DFMSearchResult &result = entries.at(i);
+        if (index.value(result.url(), i) == i)
+            results.append(result);
+    }
+
+    return results;
+}
+
+QList<QUrl> SearchResultLog::urls() const
+{
+    QReadLocker locker(&lock);
+    return index.keys();
+}
@@ -0,0 +1,44 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef SEARCHRESULTLOG_H
+#define SEARCHRESULTLOG_H
+
+#include "dfmplugin_search_global.h"
+#include "searchmanager/searcher/searchresult_define.h"
+
+#include <QHash>
+#include <QReadWriteLock>
+#include <QVector>
+
+DPSEARCH_BEGIN_NAMESPACE
+
+// 只追加的搜索结果日志
+// 每条结果的序号即其在日志中的位置，消费者记住已读到的序号，每次只取之后的部分，
+// 不再复制整份结果。去重与分数比较使用 url 哈希索引，合并一批结果的代价只与批大小相关。
+// 同一 url 出现分数更高的结果时追加一条新记录，读取时只返回每个 url 最新的一条，消费者按 url 覆盖即可。
+// 生产者（搜索线程）与消费者（主线程）可并发访问。
+class SearchResultLog
+{
+public:
+    void clear();
+
+    // 合并一批结果，返回追加的条数
+    int merge(const DFMSearchResultMap &batch);
+
+    // 获取序号 from 之后的结果，next 返回下一次读取的起始序号
+    DFMSearchResultList resultsSince(int from, int *next) const;
+
+    // 当前每个 url 的最佳结果的 url 列表
+    QList<QUrl> urls() const;
+
+private:
+    mutable QReadWriteLock lock;
+    QVector<DFMSearchResult> entries;
+    QHash<QUrl, int> index;   // url -> 该 url 最新一条记录的序号
+};
+
+DPSEARCH_END_NAMESPACE
+
+#endif   // SEARCHRESULTLOG_H
@@ -23,8 +23,9 @@ DFM_SEARCH_USE_NS
 
 // ======== SimplifiedSearchWorker 实现 ========
 
-SimplifiedSearchWorker::SimplifiedSearchWorker(QObject *parent)
+SimplifiedSearchWorker::SimplifiedSearchWorker(QSharedPointer<SearchResultLog> log, QObject *parent)
     : QObject(parent),
+      resultLog(log),
       isRunning(false),
       finishedSearcherCount(0)
 {
@@ -35,28 +36,13 @@ SimplifiedSearchWorker::~SimplifiedSearchWorker()
     stopSearch();
 }
 
-DFMSearchResultMap SimplifiedSearchWorker::getResults()
-{
-    QReadLocker locker(&rwLock);
-    return resultMap;
-}
-
-QList<QUrl> SimplifiedSearchWorker::getResultUrls()
-{
-    QReadLocker locker(&rwLock);
-    return resultMap.keys();
-}
-
 void SimplifiedSearchWorker::startSearch()
 {
     // 重置状态
     isRunning = true;
     finishedSearcherCount = 0;
 
-    {
-        QWriteLocker locker(&rwLock);
-        resultMap.clear();
-    }
+    resultLog->clear();
 
     // 创建搜索器并启动搜索
     createSearchers();
@@ -186,48 +172,19 @@ void SimplifiedSearchWorker::onSearcherUnearthed()
     // 这个槽会在搜索器找到结果时被调用
     AbstractSearcher *searcher = qobject_cast<AbstractSearcher *>(sender());
     if (searcher && isRunning) {
-        // 合并结果
-        mergeResults(searcher);
-
-        // 通知UI更新结果
-        emit resultsUpdated(taskId);
+        // 合并结果，有新增时通知UI更新结果
+        if (mergeResults(searcher) > 0)
+            emit resultsUpdated(taskId);
     }
 }
 
-void SimplifiedSearchWorker::mergeResults(AbstractSearcher *searcher)
+int SimplifiedSearchWorker::mergeResults(AbstractSearcher *searcher)
 {
     if (!searcher || !searcher->hasItem())
-        return;
+        return 0;
 
-    // 获取新结果
-    DFMSearchResultMap newResults = searcher->takeAll();
-
-    if (newResults.isEmpty())
-        return;
-
-    // 合并到主结果集
-    {
-        QWriteLocker locker(&rwLock);
-
-        // 第一次直接复制结果
-        if (resultMap.isEmpty()) {
-            resultMap = newResults;
-            return;
-        }
-
-        // 合并结果，保留匹配分数更高的结果
-        for (auto it = newResults.constBegin(); it != newResults.constEnd(); ++it) {
-            const QUrl &url = it.key();
-            auto existing = resultMap.find(url);
-
-            if (existing != resultMap.end()) {
-                if (it.value().matchScore() > existing.value().matchScore())
-                    resultMap[url] = it.value();
-            } else {
-                resultMap.insert(url, it.value());
-            }
-        }
-    }
+    // 追加到结果日志，同一 url 只保留匹配分数更高的结果
+    return resultLog->merge(searcher->takeAll());
 }
 
 void SimplifiedSearchWorker::onSearcherFinished()
@@ -241,8 +198,8 @@ void SimplifiedSearchWorker::onSearcherFinished()
 
     // 最后一次检查是否有新结果
     if (searcher->hasItem() && isRunning) {
-        mergeResults(searcher);
-        emit resultsUpdated(taskId);
+        if (mergeResults(searcher) > 0)
+            emit resultsUpdated(taskId);
     }
 
     // 移除完成的搜索器
@@ -267,7 +224,8 @@ TaskCommanderPrivate::TaskCommanderPrivate(TaskCommander *parent)
       deleted(false)
 {
     // 创建搜索工作线程
-    searchWorker = new SimplifiedSearchWorker;
+    resultLog.reset(new SearchResultLog);
+    searchWorker = new SimplifiedSearchWorker(resultLog);
     searchWorker->moveToThread(&workerThread);
 
     // 连接信号
@@ -332,32 +290,14 @@ QString TaskCommander::taskID() const
     return d->taskId;
 }
 
-DFMSearchResultMap TaskCommander::getResults() const
+DFMSearchResultList TaskCommander::getResults(int from, int *next) const
 {
-    if (!d->searchWorker) {
-        fmWarning() << "Search worker not available for getting results";
-        return DFMSearchResultMap();
-    }
-
-    DFMSearchResultMap results;
-    QMetaObject::invokeMethod(d->searchWorker, "getResults", Qt::DirectConnection,
-                              Q_RETURN_ARG(DFMSearchResultMap, results));
-
-    return results;
+    return d->resultLog->resultsSince(from, next);
 }
 
 QList<QUrl> TaskCommander::getResultsUrls() const
 {
-    if (!d->searchWorker) {
-        fmWarning() << "Search worker not available for getting result URLs";
-        return QList<QUrl>();
-    }
-
-    QList<QUrl> results;
-    QMetaObject::invokeMethod(d->searchWorker, "getResultUrls", Qt::DirectConnection,
-                              Q_RETURN_ARG(QList<QUrl>, results));
-
-    return results;
+    return d->resultLog->urls();
 }
 
 bool TaskCommander::start()
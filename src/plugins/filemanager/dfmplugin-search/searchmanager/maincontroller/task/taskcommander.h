@@ -26,8 +26,8 @@ private:
     // 任务标识
     QString taskID() const;
     
-    // 获取搜索结果
-    DFMSearchResultMap getResults() const;
+    // 获取序号 from 之后的搜索结果，next 返回下一次读取的起始序号
+    DFMSearchResultList getResults(int from, int *next) const;
     QList<QUrl> getResultsUrls() const;
     
     // 控制搜索流程
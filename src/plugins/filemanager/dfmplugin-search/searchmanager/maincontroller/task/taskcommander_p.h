@@ -7,18 +7,17 @@
 
 #include "taskcommander.h"
 #include "searchmanager/searcher/abstractsearcher.h"
+#include "searchresultlog.h"
 
 #include <dfm-search/dsearch_global.h>
 #include <dfm-search/contentsearchapi.h>
 
 #include <QObject>
 #include <QList>
-#include <QReadWriteLock>
 #include <QAtomicInt>
-#include <QMap>
 #include <QSet>
+#include <QSharedPointer>
 #include <QThread>
-#include <QMutex>
 #include <QTimer>
 
 DPSEARCH_BEGIN_NAMESPACE
@@ -28,7 +27,7 @@ class SimplifiedSearchWorker : public QObject
 {
     Q_OBJECT
 public:
-    explicit SimplifiedSearchWorker(QObject *parent = nullptr);
+    explicit SimplifiedSearchWorker(QSharedPointer<SearchResultLog> log, QObject *parent = nullptr);
     ~SimplifiedSearchWorker() override;
 
     // 设置搜索参数
@@ -36,10 +35,6 @@ public:
     Q_INVOKABLE void setSearchUrl(const QUrl &url) { searchUrl = url; }
     Q_INVOKABLE void setKeyword(const QString &keyword) { searchKeyword = keyword; }
 
-    // 获取结果
-    Q_INVOKABLE DFMSearchResultMap getResults();
-    Q_INVOKABLE QList<QUrl> getResultUrls();
-
     // 控制搜索流程
     Q_INVOKABLE void startSearch();
     Q_INVOKABLE void stopSearch();
@@ -60,7 +55,7 @@ private:
     bool isParentPath(const QString &parentPath, const QString &childPath) const;
     void createSearchersForUrl(const QUrl &url);
     void cleanupSearchers();
-    void mergeResults(AbstractSearcher *searcher);
+    int mergeResults(AbstractSearcher *searcher);
 
     // 职责拆分：解析启用的搜索类型 / 注册 searcher
     QList<DFMSEARCH::SearchType> resolveEnabledSearchTypes() const;
@@ -71,10 +66,7 @@ private:
     QString searchKeyword;
 
     QList<AbstractSearcher *> searchers;
-    DFMSearchResultMap resultMap;
-
-    QReadWriteLock rwLock;
-    QMutex mutex;
+    QSharedPointer<SearchResultLog> resultLog;   // 与 TaskCommander 共享，主线程直接增量读取
 
     bool isRunning { false };
     int finishedSearcherCount { 0 };
@@ -102,6 +94,7 @@ private:
 
     QThread workerThread;
     SimplifiedSearchWorker *searchWorker { nullptr };
+    QSharedPointer<SearchResultLog> resultLog;
 
     bool deleted { false };
 };
@@ -56,6 +56,7 @@ private:
 
 // 使用QMap的优点：1.按URL自动排序 2.自动去重 3.提供高效查找
 typedef QMap<QUrl, DFMSearchResult> DFMSearchResultMap;
+typedef QList<DFMSearchResult> DFMSearchResultList;
 
 DPSEARCH_END_NAMESPACE
 
@@ -77,11 +77,11 @@ bool SearchManager::search(quint64 winId, const QString &taskId, const QUrl &url
     return false;
 }
 
-DFMSearchResultMap SearchManager::matchedResults(const QString &taskId)
+DFMSearchResultList SearchManager::matchedResults(const QString &taskId, int from, int *next)
 {
     // Get real-time results from controller
     if (mainController)
-        return mainController->getResults(taskId);
+        return mainController->getResults(taskId, from, next);
 
     fmWarning() << "MainController not available, cannot retrieve results for taskId:" << taskId;
     return {};
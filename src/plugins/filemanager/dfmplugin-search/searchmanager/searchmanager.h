@@ -29,8 +29,8 @@ public:
     void init();
     bool search(quint64 winId, const QString &taskId, const QUrl &url, const QString &keyword);
 
-    // 获取统一的搜索结果数据
-    DFMSearchResultMap matchedResults(const QString &taskId);
+    // 增量获取统一的搜索结果数据：返回序号 from 之后的结果，next 为下一次的起始序号
+    DFMSearchResultList matchedResults(const QString &taskId, int from, int *next);
 
     // 为向后兼容保留的接口，只获取URL列表
     QList<QUrl> matchedResultUrls(const QString &taskId);
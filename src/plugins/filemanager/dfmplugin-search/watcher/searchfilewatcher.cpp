@@ -4,6 +4,7 @@
 
 #include "searchfilewatcher.h"
 #include "searchfilewatcher_p.h"
+#include "searchwatchpool.h"
 #include "utils/searchhelper.h"
 #include "searchmanager/searchmanager.h"
 
@@ -11,8 +12,6 @@
 
 #include <dfm-framework/event/event.h>
 
-#include <algorithm>
-
 namespace dfmplugin_search {
 
 SearchFileWatcherPrivate::SearchFileWatcherPrivate(const QUrl &fileUrl, SearchFileWatcher *qq)
@@ -22,23 +21,15 @@ SearchFileWatcherPrivate::SearchFileWatcherPrivate(const QUrl &fileUrl, SearchFi
 
 bool SearchFileWatcherPrivate::start()
 {
-    bool ok = std::all_of(urlToWatcherHash.begin(), urlToWatcherHash.end(),
-                          [](const AbstractFileWatcherPointer watcher) {
-                              return watcher->startWatcher();
-                          });
-
-    return started = ok;
+    // 目录监视由 SearchWatchPool 统一维护，这里只控制是否转发事件
+    started = true;
+    return true;
 }
 
 bool SearchFileWatcherPrivate::stop()
 {
-    bool ok = std::all_of(urlToWatcherHash.begin(), urlToWatcherHash.end(),
-                          [](const AbstractFileWatcherPointer watcher) {
-                              return watcher->stopWatcher();
-                          });
-
-    started = !ok;
-    return ok;
+    started = false;
+    return true;
 }
 
 SearchFileWatcher::SearchFileWatcher(const QUrl &url, QObject *parent)
@@ -55,49 +46,57 @@ SearchFileWatcher::SearchFileWatcher(const QUrl &url, QObject *parent)
 
 SearchFileWatcher::~SearchFileWatcher()
 {
-    dptr->urlToWatcherHash.clear();
+    for (const QUrl &url : qAsConst(dptr->watchedFiles))
+        SearchWatchPool::instance()->unwatch(this, url);
+    dptr->watchedFiles.clear();
 }
 
 void SearchFileWatcher::setEnabledSubfileWatcher(const QUrl &subfileUrl, bool enabled)
 {
-    // When 'subfileUrl' is a directory, unable to receive it rename event,
-    // so monitor it's parent
-    QUrl tmpUrl = subfileUrl;
-    auto fileInfo = InfoFactory::create<FileInfo>(tmpUrl);
-    if (fileInfo && fileInfo->fileType() == FileInfo::FileType::kDirectory)
-        tmpUrl = fileInfo->urlOf(FileInfo::FileUrlInfoType::kParentUrl);
-
+    // Results are watched through their parent directory, which also covers
+    // the rename of a result that is itself a directory
     if (enabled) {
-        addWatcher(tmpUrl);
+        addWatcher(subfileUrl);
     } else {
-        removeWatcher(tmpUrl);
+        removeWatcher(subfileUrl);
     }
 }
 
 void SearchFileWatcher::addWatcher(const QUrl &url)
 {
-    if (!url.isValid() || dptr->urlToWatcherHash.contains(url))
+    if (!url.isValid() || dptr->watchedFiles.contains(url))
         return;
 
-    AbstractFileWatcherPointer watcher = WatcherFactory::create<AbstractFileWatcher>(url);
-    if (!watcher) {
-        fmWarning() << "Failed to create watcher for URL:" << url.toString();
-        return;
-    }
+    dptr->watchedFiles.insert(url);
+    SearchWatchPool::instance()->watch(this, url);
+}
+
+void SearchFileWatcher::removeWatcher(const QUrl &url)
+{
+    if (dptr->watchedFiles.remove(url))
+        SearchWatchPool::instance()->unwatch(this, url);
+}
 
-    watcher->moveToThread(this->thread());
-    connect(watcher.data(), &AbstractFileWatcher::fileAttributeChanged, this, &SearchFileWatcher::onFileAttributeChanged);
-    connect(watcher.data(), &AbstractFileWatcher::fileDeleted, this, &SearchFileWatcher::onFileDeleted);
-    connect(watcher.data(), &AbstractFileWatcher::fileRename, this, &SearchFileWatcher::onFileRenamed);
+void SearchFileWatcher::onWatchedFileDeleted(const QUrl &url)
+{
+    // 共享的目录监视器会报告同目录下的其他文件，只转发本视图的结果
+    if (dptr->started && dptr->watchedFiles.contains(url))
+        onFileDeleted(url);
+}
 
-    dptr->urlToWatcherHash[url] = watcher;
-    if (dptr->started)
-        watcher->startWatcher();
+void SearchFileWatcher::onWatchedFileAttributeChanged(const QUrl &url)
+{
+    if (dptr->started && dptr->watchedFiles.contains(url))
+        onFileAttributeChanged(url);
 }
 
-void SearchFileWatcher::removeWatcher(const QUrl &url)
+void SearchFileWatcher::onWatchedFileRenamed(const QUrl &fromUrl, const QUrl &toUrl)
 {
-    dptr->urlToWatcherHash.remove(url);
+    if (!dptr->started || !dptr->watchedFiles.contains(fromUrl))
+        return;
+
+    removeWatcher(fromUrl);
+    onFileRenamed(fromUrl, toUrl);
 }
 
 void SearchFileWatcher::onFileDeleted(const QUrl &url)
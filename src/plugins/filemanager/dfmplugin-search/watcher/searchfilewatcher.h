@@ -15,6 +15,8 @@ class SearchFileWatcherPrivate;
 class SearchFileWatcher : public DFMBASE_NAMESPACE::AbstractFileWatcher
 {
     Q_OBJECT
+    friend class SearchWatchPool;
+
 public:
     explicit SearchFileWatcher() = delete;
     explicit SearchFileWatcher(const QUrl &url, QObject *parent = nullptr);
@@ -25,6 +27,11 @@ private:
     void addWatcher(const QUrl &url);
     void removeWatcher(const QUrl &url);
 
+    // 由 SearchWatchPool 分发的目录事件
+    void onWatchedFileDeleted(const QUrl &url);
+    void onWatchedFileAttributeChanged(const QUrl &url);
+    void onWatchedFileRenamed(const QUrl &fromUrl, const QUrl &toUrl);
+
     void onFileDeleted(const QUrl &url);
     void onFileAttributeChanged(const QUrl &url);
     void onFileRenamed(const QUrl &fromUrl, const QUrl &toUrl);
@@ -9,6 +9,8 @@
 
 #include <dfm-base/interfaces/private/abstractfilewatcher_p.h>
 
+#include <QSet>
+
 DFMBASE_USE_NAMESPACE
 namespace dfmplugin_search {
 
@@ -24,7 +26,7 @@ private:
     bool start() override;
     bool stop() override;
 
-    QHash<QUrl, AbstractFileWatcherPointer> urlToWatcherHash;
+    QSet<QUrl> watchedFiles;   // 已订阅的搜索结果，目录监视由 SearchWatchPool 共享
 };
 
 }
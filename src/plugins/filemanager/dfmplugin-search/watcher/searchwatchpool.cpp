@@ -0,0 +1,272 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "searchwatchpool.h"
+#include "searchfilewatcher.h"
+
+#include <dfm-base/base/schemefactory.h>
+#include <dfm-base/base/configs/dconfig/dconfigmanager.h>
+
+#include <QFile>
+
+#include <sys/stat.h>
+
+DFMBASE_USE_NAMESPACE
+
+namespace dfmplugin_search {
+
+namespace {
+constexpr int kDefaultWatchBudget { 2048 };
+constexpr int kRevalidateIntervalMs { 5000 };
+constexpr int kMaxRevalidatePerTick { 2000 };   // 每轮最多复核的文件数，避免阻塞主线程
+constexpr int kAttributeCoalesceMs { 200 };
+}   // namespace
+
+SearchWatchPool *SearchWatchPool::instance()
+{
+    static SearchWatchPool ins;
+    return &ins;
+}
+
+SearchWatchPool::SearchWatchPool(QObject *parent)
+    : QObject(parent)
+{
+    watchBudget = DConfigManager::instance()->value(DConfig::kSearchCfgPath,
+                                                    DConfig::kSearchWatchBudget,
+                                                    kDefaultWatchBudget)
+                          .toInt();
+    if (watchBudget <= 0)
+        watchBudget = kDefaultWatchBudget;
+
+    // 释放目录延迟到事件循环中进行，避免在目录监视器的信号处理中销毁它
+    sweepTimer.setSingleShot(true);
+    sweepTimer.setInterval(0);
+    connect(&sweepTimer, &QTimer::timeout, this, &SearchWatchPool::sweepDirectories);
+
+    revalidateTimer.setInterval(kRevalidateIntervalMs);
+    connect(&revalidateTimer, &QTimer::timeout, this, &SearchWatchPool::revalidate);
+
+    attributeTimer.setSingleShot(true);
+    attributeTimer.setInterval(kAttributeCoalesceMs);
+    connect(&attributeTimer, &QTimer::timeout, this, &SearchWatchPool::flushAttributeChanges);
+}
+
+void SearchWatchPool::watch(SearchFileWatcher *client, const QUrl &fileUrl)
+{
+    const QUrl &dirUrl = fileUrl.adjusted(QUrl::RemoveFilename | QUrl::StripTrailingSlash);
+    if (!client || !dirUrl.isValid() || dirUrl == fileUrl)
+        return;
+
+    auto it = directories.find(dirUrl);
+    if (it == directories.end()) {
+        it = directories.insert(dirUrl, Directory());
+        if (!startWatching(dirUrl, &it.value())) {
+            polledDirectories.append(dirUrl);
+            if (!revalidateTimer.isActive())
+                revalidateTimer.start();
+        }
+    }
+
+    ++it->clients[client];
+    if (++it->files[fileUrl] == 1 && !it->watcher)
+        it->stamps.insert(fileUrl, changeTimeOf(fileUrl));
+}
+
+void SearchWatchPool::unwatch(SearchFileWatcher *client, const QUrl &fileUrl)
+{
+    const QUrl &dirUrl = fileUrl.adjusted(QUrl::RemoveFilename | QUrl::StripTrailingSlash);
+    auto it = directories.find(dirUrl);
+    if (it == directories.end())
+        return;
+
+    auto clientIt = it->clients.find(client);
+    if (clientIt == it->clients.end())
+        return;
+    if (--clientIt.value() <= 0)
+        it->clients.erase(clientIt);
+
+    auto fileIt = it->files.find(fileUrl);
+    if (fileIt != it->files.end() && --fileIt.value() <= 0) {
+        it->files.erase(fileIt);
+        it->stamps.remove(fileUrl);
+    }
+
+    if (it->files.isEmpty())
+        sweepTimer.start();
+}
+
+bool SearchWatchPool::startWatching(const QUrl &dirUrl, Directory *dir)
+{
+    if (watchedCount >= watchBudget)
+        return false;
+
+    AbstractFileWatcherPointer watcher = WatcherFactory::create<AbstractFileWatcher>(dirUrl);
+    if (!watcher) {
+        fmWarning() << "Failed to create watcher for search result directory:" << dirUrl.toString();
+        return false;
+    }
+
+    watcher->moveToThread(thread());
+    connect(watcher.data(), &AbstractFileWatcher::fileDeleted, this, [this, dirUrl](const QUrl &url) {
+        onFileDeleted(dirUrl, url);
+    });
+    connect(watcher.data(), &AbstractFileWatcher::fileAttributeChanged, this, [this, dirUrl](const QUrl &url) {
+        onFileAttributeChanged(dirUrl, url);
+    });
+    connect(watcher.data(), &AbstractFileWatcher::fileRename, this, [this, dirUrl](const QUrl &fromUrl, const QUrl &toUrl) {
+        onFileRenamed(dirUrl, fromUrl, toUrl);
+    });
+    watcher->startWatcher();
+
+    dir->watcher = watcher;
+    dir->stamps.clear();
+    ++watchedCount;
+    return true;
+}
+
+void SearchWatchPool::sweepDirectories()
+{
+    for (auto it = directories.begin(); it != directories.end();) {
+        if (!it->files.isEmpty()) {
+            ++it;
+            continue;
+        }
+
+        // 监视器可能被 WatcherFactory 缓存并与其他视图共享，只断开与本池的连接
+        if (it->watcher) {
+            it->watcher->disconnect(this);
+            --watchedCount;
+        } else {
+            polledDirectories.removeOne(it.key());
+        }
+        pendingAttributeChanges.remove(it.key());
+        it = directories.erase(it);
+    }
+
+    // 预算有空余时把轮询的目录升级为实时监视
+    while (!polledDirectories.isEmpty() && watchedCount < watchBudget) {
+        auto it = directories.find(polledDirectories.first());
+        if (it != directories.end() && !startWatching(it.key(), &it.value()))
+            break;
+        polledDirectories.removeFirst();
+    }
+
+    if (polledDirectories.isEmpty())
+        revalidateTimer.stop();
+    if (revalidateCursor >= polledDirectories.size())
+        revalidateCursor = 0;
+}
+
+void SearchWatchPool::revalidate()
+{
+    if (polledDirectories.isEmpty()) {
+        revalidateTimer.stop();
+        return;
+    }
+
+    int budget = kMaxRevalidatePerTick;
+    const int total = polledDirectories.size();
+    for (int n = 0; n < total && budget > 0; ++n) {
+        if (revalidateCursor >= polledDirectories.size())
+            revalidateCursor = 0;
+        const QUrl dirUrl = polledDirectories.at(revalidateCursor++);
+
+        auto it = directories.find(dirUrl);
+        if (it == directories.end())
+            continue;
+
+        QList<QUrl> deleted;
+        QList<QUrl> changed;
+        for (auto stamp = it->stamps.begin(); stamp != it->stamps.end(); ++stamp) {
+            const qint64 current = changeTimeOf(stamp.key());
+            --budget;
+            if (current == stamp.value())
+                continue;
+
+            if (current < 0)
+                deleted.append(stamp.key());
+            else
+                changed.append(stamp.key());
+            stamp.value() = current;
+        }
+
+        // 通知可能导致订阅者取消订阅，因此在遍历结束后统一分发
+        for (const QUrl &url : qAsConst(deleted))
+            onFileDeleted(dirUrl, url);
+        for (const QUrl &url : qAsConst(changed))
+            onFileAttributeChanged(dirUrl, url);
+    }
+}
+
+void SearchWatchPool::flushAttributeChanges()
+{
+    QHash<QUrl, QSet<QUrl>> changes;
+    changes.swap(pendingAttributeChanges);
+
+    for (auto it = changes.cbegin(); it != changes.cend(); ++it) {
+        const auto &clients = clientsOf(it.key());
+        for (const QUrl &url : it.value()) {
+            for (const auto &client : clients) {
+                if (client)
+                    client->onWatchedFileAttributeChanged(url);
+            }
+        }
+    }
+}
+
+void SearchWatchPool::onFileDeleted(const QUrl &dirUrl, const QUrl &url)
+{
+    const auto &clients = clientsOf(dirUrl);
+
+    // 目录本身被删除时，其下订阅的文件一并视为删除
+    QList<QUrl> urls { url };
+    if (url == dirUrl)
+        urls = directories.value(dirUrl).files.keys();
+
+    for (const QUrl &fileUrl : qAsConst(urls)) {
+        for (const auto &client : clients) {
+            if (client)
+                client->onWatchedFileDeleted(fileUrl);
+        }
+    }
+}
+
+void SearchWatchPool::onFileAttributeChanged(const QUrl &dirUrl, const QUrl &url)
+{
+    // 同一文件的连续变化合并为一次通知
+    pendingAttributeChanges[dirUrl].insert(url);
+    if (!attributeTimer.isActive())
+        attributeTimer.start();
+}
+
+void SearchWatchPool::onFileRenamed(const QUrl &dirUrl, const QUrl &fromUrl, const QUrl &toUrl)
+{
+    for (const auto &client : clientsOf(dirUrl)) {
+        if (client)
+            client->onWatchedFileRenamed(fromUrl, toUrl);
+    }
+}
+
+QList<QPointer<SearchFileWatcher>> SearchWatchPool::clientsOf(const QUrl &dirUrl) const
+{
+    QList<QPointer<SearchFileWatcher>> clients;
+    auto it = directories.constFind(dirUrl);
+    if (it == directories.constEnd())
+        return clients;
+
+    for (auto client = it->clients.cbegin(); client != it->clients.cend(); ++client)
+        clients.append(client.key());
+    return clients;
+}
+
+qint64 SearchWatchPool::changeTimeOf(const QUrl &fileUrl)
+{
+    struct stat st;
+    if (::lstat(QFile::encodeName(fileUrl.toLocalFile()).constData(), &st) != 0)
+        return -1;
+
+    return static_cast<qint64>(st.st_ctim.tv_sec) * 1000000000LL + st.st_ctim.tv_nsec;
+}
+
+}
@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef SEARCHWATCHPOOL_H
+#define SEARCHWATCHPOOL_H
+
+#include "dfmplugin_search_global.h"
+
+#include <dfm-base/interfaces/abstractfilewatcher.h>
+
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QTimer>
+#include <QUrl>
+
+namespace dfmplugin_search {
+
+class SearchFileWatcher;
+
+// 搜索结果视图共享的目录监视池
+// 按结果所在的父目录监视：同一目录下的所有结果、所有搜索视图共用一个目录监视器，
+// 目录按订阅的文件引用计数，无人订阅时释放。目录本身的删除/重命名由其父目录的事件覆盖。
+// 监视的目录数达到预算（DConfig searchWatchBudget）后，新的目录不再占用 inotify，
+// 改为定时复核其中订阅文件的 ctime，检测删除与属性变化；有目录释放时再升级为实时监视。
+// 只在主线程使用。
+class SearchWatchPool : public QObject
+{
+    Q_OBJECT
+public:
+    static SearchWatchPool *instance();
+
+    void watch(SearchFileWatcher *client, const QUrl &fileUrl);
+    void unwatch(SearchFileWatcher *client, const QUrl &fileUrl);
+
+private:
+    struct Directory
+    {
+        DFMBASE_NAMESPACE::AbstractFileWatcherPointer watcher;   // 为空表示处于轮询复核状态
+        QHash<SearchFileWatcher *, int> clients;   // 订阅者 -> 在该目录下订阅的文件数
+        QHash<QUrl, int> files;   // 订阅的文件 -> 引用计数
+        QHash<QUrl, qint64> stamps;   // 轮询状态下各文件上次复核的 ctime，-1 表示已不存在
+    };
+
+    explicit SearchWatchPool(QObject *parent = nullptr);
+
+    bool startWatching(const QUrl &dirUrl, Directory *dir);
+    void sweepDirectories();
+    void revalidate();
+    void flushAttributeChanges();
+
+    void onFileDeleted(const QUrl &dirUrl, const QUrl &url);
+    void onFileAttributeChanged(const QUrl &dirUrl, const QUrl &url);
+    void onFileRenamed(const QUrl &dirUrl, const QUrl &fromUrl, const QUrl &toUrl);
+
+    QList<QPointer<SearchFileWatcher>> clientsOf(const QUrl &dirUrl) const;
+    static qint64 changeTimeOf(const QUrl &fileUrl);
+
+    QHash<QUrl, Directory> directories;   // 父目录 -> 订阅信息
+    QList<QUrl> polledDirectories;   // 轮询复核的目录，按加入顺序
+    int watchedCount { 0 };
+    int watchBudget { 0 };
+    int revalidateCursor { 0 };
+    QHash<QUrl, QSet<QUrl>> pendingAttributeChanges;   // 父目录 -> 待合并通知的文件
+    QTimer sweepTimer;
+    QTimer revalidateTimer;
+    QTimer attributeTimer;
+};
+
+}
+
+#endif   // SEARCHWATCHPOOL_H
@@ -23,6 +23,7 @@
 #include <dfm-base/widgets/filemanagerwindowsmanager.h>
 #include <dfm-base/base/application/application.h>
 #include <dfm-base/base/application/settings.h>
+#include <dfm-base/base/application/viewstatestore.h>
 #include <dfm-base/base/configs/dconfig/dconfigmanager.h>
 
 #include <dfm-framework/dpf.h>
@@ -434,16 +435,13 @@ QUrl TitleBarHelper::transformViewModeUrl(const QUrl &url)
 QVariant TitleBarHelper::getFileViewStateValue(const QUrl &url, const QString &key, const QVariant &defaultValue)
 {
     QUrl viewModeUrl = transformViewModeUrl(url);
-    QMap<QString, QVariant> valueMap = Application::appObtuselySetting()->value("FileViewState", viewModeUrl).toMap();
-    return valueMap.value(key, defaultValue);
+    return ViewStateStore::instance()->value(viewModeUrl, key, defaultValue);
 }
 
 void TitleBarHelper::setFileViewStateValue(const QUrl &url, const QString &key, const QVariant &value)
 {
     QUrl viewModeUrl = transformViewModeUrl(url);
-    QVariantMap map = Application::appObtuselySetting()->value("FileViewState", viewModeUrl).toMap();
-    map[key] = value;
-    Application::appObtuselySetting()->setValue("FileViewState", viewModeUrl, map);
+    ViewStateStore::instance()->setValue(viewModeUrl, key, value);
 }
 
 bool TitleBarHelper::isTreeViewGloballyEnabled()
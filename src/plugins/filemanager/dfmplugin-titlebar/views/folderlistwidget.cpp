@@ -289,10 +289,13 @@ bool FolderListWidgetPrivate::matchText(const QString &source, const QString &in
 
     if (sourceLower.startsWith(inputLower))
         return true;
-    // 上面的英文未匹配，使用拼音再匹配一次
+    // 上面的英文未匹配，使用全拼和拼音首字母再匹配一次
     if (input[0].isLetter()) {
-        QString pinyinText = Pinyin::Chinese2Pinyin(source);
-        return pinyinText.toLower().startsWith(inputLower);
+        QString pinyinText;
+        QString pinyinInitials;
+        Pinyin::Chinese2Pinyin(source, &pinyinText, &pinyinInitials);
+        return pinyinText.toLower().startsWith(inputLower)
+                || pinyinInitials.toLower().startsWith(inputLower);
     }
 
     return false;
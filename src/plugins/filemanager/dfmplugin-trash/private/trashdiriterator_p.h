@@ -7,6 +7,7 @@
 
 #include "dfmplugin_trash_global.h"
 #include <dfm-base/interfaces/abstractdiriterator.h>
+#include <dfm-base/utils/trashindex.h>
 
 #include <dfm-io/denumerator.h>
 
@@ -26,6 +27,9 @@ public:
                             TrashDirIterator *qq);
     ~TrashDirIteratorPrivate();
 
+    bool isBindMounted(const QString &path) const;
+    bool acceptIndexed(const QString &path) const;
+
 private:
     TrashDirIterator *q { nullptr };
     QSharedPointer<DFMIO::DEnumerator> dEnumerator = nullptr;
@@ -33,6 +37,14 @@ private:
     QMap<QString, QString> fstabMap;
     FileInfoPointer fileInfo{nullptr};
     std::atomic_bool once{ false };
+
+    // 回收站根目录直接从本地索引列出，不经过 gvfsd-trash
+    QUrl rootUrl;
+    bool useIndex { false };
+    QDir::Filters indexFilters { QDir::NoFilter };
+    bool indexLoaded { false };
+    int indexPos { 0 };
+    QList<DFMBASE_NAMESPACE::TrashIndex::Entry> indexEntries;
 };
 
 }
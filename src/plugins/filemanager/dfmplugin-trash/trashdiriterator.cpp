@@ -11,22 +11,84 @@
 #include <dfm-base/base/device/deviceutils.h>
 #include <dfm-base/utils/universalutils.h>
 
+#include <QFileInfo>
+
 DFMBASE_USE_NAMESPACE
 using namespace dfmplugin_trash;
 
 TrashDirIteratorPrivate::TrashDirIteratorPrivate(const QUrl &url, const QStringList &nameFilters,
                                                  DFMIO::DEnumerator::DirFilters filters, DFMIO::DEnumerator::IteratorFlags flags,
                                                  TrashDirIterator *qq)
-    : q(qq)
+    : q(qq), rootUrl(url)
 {
     fstabMap = DeviceUtils::fstabBindInfo();
-    dEnumerator.reset(new DFMIO::DEnumerator(url, nameFilters, filters, flags));
+    // DEnumerator 的过滤条件与 QDir::Filters 取值一致
+    indexFilters = QDir::Filters(static_cast<int>(filters));
+    // 索引只能列出根目录的条目：名称过滤、递归遍历和按修改状态过滤只有 DEnumerator 支持，
+    // 此时仍走 gvfs；FollowSymlinks 只影响递归，不影响根目录的列举
+    useIndex = UniversalUtils::urlEquals(url, TrashHelper::rootUrl())
+            && nameFilters.isEmpty()
+            && !flags.testFlag(DFMIO::DEnumerator::IteratorFlag::kSubdirectories)
+            && !indexFilters.testFlag(QDir::Modified);
+    if (!useIndex)
+        dEnumerator.reset(new DFMIO::DEnumerator(url, nameFilters, filters, flags));
 }
 
 TrashDirIteratorPrivate::~TrashDirIteratorPrivate()
 {
 }
 
+bool TrashDirIteratorPrivate::isBindMounted(const QString &path) const
+{
+    for (auto it = fstabMap.cbegin(); it != fstabMap.cend(); ++it) {
+        if (path.startsWith(it.key()))
+            return true;
+    }
+    return false;
+}
+
+bool TrashDirIteratorPrivate::acceptIndexed(const QString &path) const
+{
+    // 与 QDirIterator 的过滤规则保持一致
+    QDir::Filters filters = indexFilters;
+    if (!(filters & QDir::TypeMask))
+        filters |= QDir::AllEntries;
+
+    const int permissions = static_cast<int>(filters & QDir::PermissionMask);
+    const bool filterPermissions = permissions != 0 && permissions != static_cast<int>(QDir::PermissionMask);
+    if ((filters & QDir::Dirs) && (filters & QDir::Files) && (filters & QDir::Hidden)
+        && (filters & QDir::System) && !(filters & QDir::NoSymLinks) && !filterPermissions)
+        return true;
+
+    const QFileInfo info(path);
+    if ((filters & QDir::NoSymLinks) && info.isSymLink())
+        return false;
+
+    const bool isSystem = !(info.isFile() || info.isDir() || info.isSymLink())
+            || (info.isSymLink() && !info.exists());
+    if (!(filters & QDir::System) && isSystem)
+        return false;
+
+    if (!(filters & (QDir::Dirs | QDir::AllDirs)) && info.isDir())
+        return false;
+    if (!(filters & QDir::Files) && info.isFile())
+        return false;
+
+    if (!(filters & QDir::Hidden) && info.fileName().startsWith('.'))
+        return false;
+
+    if (filterPermissions) {
+        if ((filters & QDir::Readable) && !info.isReadable())
+            return false;
+        if ((filters & QDir::Writable) && !info.isWritable())
+            return false;
+        if ((filters & QDir::Executable) && !info.isExecutable())
+            return false;
+    }
+
+    return true;
+}
+
 TrashDirIterator::TrashDirIterator(const QUrl &url,
                                    const QStringList &nameFilters,
                                    QDir::Filters filters,
@@ -43,6 +105,13 @@ TrashDirIterator::~TrashDirIterator()
 
 QUrl TrashDirIterator::next()
 {
+    if (d->useIndex) {
+        d->fileInfo.reset();
+        if (d->indexPos < d->indexEntries.size())
+            d->currentUrl = d->indexEntries.at(d->indexPos++).url;
+        return d->currentUrl;
+    }
+
     if (d->dEnumerator)
         d->currentUrl = d->dEnumerator->next();
 
@@ -51,6 +120,25 @@ QUrl TrashDirIterator::next()
 
 bool TrashDirIterator::hasNext() const
 {
+    if (d->useIndex) {
+        if (!d->indexLoaded) {
+            d->indexEntries = TrashIndex::instance()->entries();
+            d->indexLoaded = true;
+        }
+
+        while (d->indexPos < d->indexEntries.size()) {
+            const QString &filePath = d->indexEntries.at(d->indexPos).filePath;
+            if (!d->isBindMounted(filePath) && d->acceptIndexed(filePath)) {
+                if (!d->once)
+                    TrashHelper::instance()->trashNotEmpty();
+                d->once = true;
+                return true;
+            }
+            ++d->indexPos;
+        }
+        return false;
+    }
+
     bool has = false;
     if (d->dEnumerator)
         has = d->dEnumerator->hasNext();
@@ -68,10 +156,8 @@ bool TrashDirIterator::hasNext() const
         d->fileInfo = InfoFactory::create<FileInfo>(urlNext);
         if (d->fileInfo) {
             const QUrl &urlTarget = d->fileInfo->urlOf(UrlInfoType::kRedirectedFileUrl);
-            for (const QString &key : d->fstabMap.keys()) {
-                if (urlTarget.path().startsWith(key))
-                    return hasNext();
-            }
+            if (d->isBindMounted(urlTarget.path()))
+                return hasNext();
         }
     }
 
@@ -91,6 +177,9 @@ QString TrashDirIterator::fileName() const
 
 QUrl TrashDirIterator::fileUrl() const
 {
+    if (d->useIndex && d->indexPos > 0 && d->indexPos <= d->indexEntries.size())
+        return QUrl::fromLocalFile(d->indexEntries.at(d->indexPos - 1).filePath);
+
     auto fileinfo = fileInfo();
     if (fileinfo) {
         return fileinfo->urlOf(UrlInfoType::kRedirectedFileUrl);
@@ -105,6 +194,11 @@ const FileInfoPointer TrashDirIterator::fileInfo() const
     if (d->fileInfo)
         return d->fileInfo;
 
+    if (d->useIndex) {
+        d->fileInfo = InfoFactory::create<FileInfo>(d->currentUrl);
+        return d->fileInfo;
+    }
+
     return InfoFactory::create<FileInfo>(d->currentUrl, Global::CreateFileInfoType::kCreateFileInfoSync);
 }
 
@@ -112,5 +206,7 @@ QUrl TrashDirIterator::url() const
 {
     if (d->dEnumerator)
         return d->dEnumerator->uri();
+    if (d->useIndex)
+        return d->rootUrl;
     return TrashHelper::rootUrl();
 }
@@ -10,12 +10,22 @@
 
 #include <QElapsedTimer>
 #include <QDebug>
+#include <QThreadPool>
+#include <QtConcurrent>
 #include <algorithm>
 
 DPWORKSPACE_BEGIN_NAMESPACE
 DFMBASE_USE_NAMESPACE
 DFMGLOBAL_USE_NAMESPACE
 
+namespace {
+// Classification result of files that are not put into any group
+constexpr int kSkippedFile = -2;
+// Below this size splitting the work costs more than classifying on one thread
+constexpr int kParallelGroupingThreshold = 2000;
+constexpr int kMinGroupingChunkSize = 500;
+}   // namespace
+
 GroupingEngine::GroupingEngine(const QUrl &rootUrl, QObject *parent)
     : QObject(parent), m_rootUrl(rootUrl)
 {
@@ -586,55 +596,99 @@ GroupingEngine::GroupingResult GroupingEngine::performGrouping(const QList<FileI
     GroupingResult result;
 
     try {
-        // Use QHash for efficient grouping (O(1) average insertion time)
-        QHash<QString, QList<FileItemDataPointer>> groupMap;
+        strategy->beginGroupClassification();
+
+        // Classify every file first. Strategies with integer ordinals skip
+        // building a key string per file, and large lists are split across
+        // the thread pool; the results are merged below in file order.
+        QVector<int> ordinals(files.size(), kSkippedFile);
+        QVector<QString> keys(files.size());
+        const auto classifyRange = [&](int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                if (shouldCancel()) {
+                    return;
+                }
+                classifyFile(files.at(i), strategy, &ordinals[i], &keys[i]);
+            }
+        };
+
+        const int fileCount = static_cast<int>(files.size());
+        if (fileCount >= kParallelGroupingThreshold && strategy->isConcurrentClassificationSafe()) {
+            const int threads = qMax(1, QThreadPool::globalInstance()->maxThreadCount());
+            const int chunkSize = qMax(kMinGroupingChunkSize, fileCount / (threads * 4) + 1);
+            QVector<QPair<int, int>> chunks;
+            for (int begin = 0; begin < fileCount; begin += chunkSize) {
+                chunks.append({ begin, qMin(begin + chunkSize, fileCount) });
+            }
+            QtConcurrent::blockingMap(chunks, [&](const QPair<int, int> &chunk) {
+                classifyRange(chunk.first, chunk.second);
+            });
+        } else {
+            classifyRange(0, fileCount);
+        }
 
-        // Reserve space for better performance
-        groupMap.reserve(qMin(files.size() / 4 + 1, 50));   // Reasonable estimate
+        if (shouldCancel()) {
+            fmInfo() << "GroupingEngine: Grouping operation canceled by user";
+            result.success = false;
+            result.errorMessage = "Operation canceled";
+            return result;
+        }
 
-        // Single pass grouping
-        for (const auto &file : files) {
-            // Check for cancellation at the beginning of each iteration
-            if (shouldCancel()) {
-                fmInfo() << "GroupingEngine: Grouping operation canceled by user";
-                result.success = false;
-                result.errorMessage = "Operation canceled";
-                return result;
+        // Merge into buckets in file order so each group keeps the input order.
+        // Ordinals are resolved to their key once per group, not once per file.
+        QVector<QString> bucketKeys;
+        QVector<QList<FileItemDataPointer>> buckets;
+        QHash<QString, int> bucketOfKey;
+        QVector<int> bucketOfOrdinal;
+        const auto bucketForKey = [&](const QString &groupKey) {
+            auto it = bucketOfKey.constFind(groupKey);
+            if (it != bucketOfKey.constEnd()) {
+                return it.value();
             }
-
-            if (!file) {
-                continue;   // Skip null pointers
+            bucketKeys.append(groupKey);
+            buckets.append({});
+            bucketOfKey.insert(groupKey, buckets.size() - 1);
+            return static_cast<int>(buckets.size() - 1);
+        };
+
+        for (int i = 0; i < fileCount; ++i) {
+            const int ordinal = ordinals.at(i);
+            if (ordinal == kSkippedFile) {
+                continue;
             }
 
-            // Convert FileItemDataPointer to FileInfoPointer for strategy interface
-            FileInfoPointer fileInfo = file->fileInfo();
-            if (!fileInfo) {
-                fileInfo = getFileInfoFromFileItem(file);
-                if (!fileInfo) {
-                    continue;
+            int bucket = -1;
+            if (ordinal >= 0) {
+                if (ordinal >= bucketOfOrdinal.size()) {
+                    bucketOfOrdinal.resize(ordinal + 1, -1);
                 }
+                bucket = bucketOfOrdinal.at(ordinal);
+                if (bucket < 0) {
+                    const QString groupKey = strategy->getGroupKeyOfOrdinal(ordinal);
+                    if (groupKey.isEmpty()) {
+                        fmWarning() << "GroupingEngine: Empty group key for ordinal" << ordinal;
+                        continue;
+                    }
+                    bucket = bucketForKey(groupKey);
+                    bucketOfOrdinal[ordinal] = bucket;
+                }
+            } else {
+                bucket = bucketForKey(keys.at(i));
             }
 
-            // Pass the SortFileInfo too when available — search-strategy dimensions
-            // (Match Method) read match metadata from it rather than from FileInfo.
-            QString groupKey = strategy->getGroupKey(fileInfo, file->fileSortInfo());
-            if (groupKey.isEmpty()) {
-                fmWarning() << "GroupingEngine: Empty group key for file" << file->data(DFMBASE_NAMESPACE::Global::kItemUrlRole).toUrl();
-                continue;
-            }
-
-            groupMap[groupKey].append(file);
+            const FileItemDataPointer &file = files.at(i);
+            buckets[bucket].append(file);
             // a item is expanded tree item
             const auto &expandedFiles = findExpandedFiles(file);
             if (!expandedFiles.isEmpty()) {
-                groupMap[groupKey].append(expandedFiles);
+                buckets[bucket].append(expandedFiles);
             }
         }
 
-        // Convert hash map to result groups
-        result.groups.reserve(groupMap.size());
+        // Convert buckets to result groups
+        result.groups.reserve(buckets.size());
 
-        for (auto it = groupMap.constBegin(); it != groupMap.constEnd(); ++it) {
+        for (int i = 0; i < buckets.size(); ++i) {
             // Check for cancellation when processing groups
             if (shouldCancel()) {
                 fmInfo() << "GroupingEngine: Group conversion canceled by user";
@@ -643,8 +697,8 @@ GroupingEngine::GroupingResult GroupingEngine::performGrouping(const QList<FileI
                 return result;
             }
 
-            const QString &groupKey = it.key();
-            const QList<FileItemDataPointer> &groupFiles = it.value();
+            const QString &groupKey = bucketKeys.at(i);
+            const QList<FileItemDataPointer> &groupFiles = buckets.at(i);
 
             // Early optimization: Skip empty groups for performance
             // Most strategies (except NoGroupStrategy) simply check !infos.isEmpty()
@@ -684,6 +738,42 @@ GroupingEngine::GroupingResult GroupingEngine::performGrouping(const QList<FileI
     return result;
 }
 
+void GroupingEngine::classifyFile(const FileItemDataPointer &file,
+                                  AbstractGroupStrategy *strategy,
+                                  int *ordinal,
+                                  QString *groupKey) const
+{
+    if (!file) {
+        return;   // Skip null pointers
+    }
+
+    // Convert FileItemDataPointer to FileInfoPointer for strategy interface
+    FileInfoPointer fileInfo = file->fileInfo();
+    if (!fileInfo) {
+        fileInfo = getFileInfoFromFileItem(file);
+        if (!fileInfo) {
+            return;
+        }
+    }
+
+    // Pass the SortFileInfo too when available — search-strategy dimensions
+    // (Match Method) read match metadata from it rather than from FileInfo.
+    const int groupOrdinal = strategy->getGroupOrdinal(fileInfo, file->fileSortInfo());
+    if (groupOrdinal >= 0) {
+        *ordinal = groupOrdinal;
+        return;
+    }
+
+    QString key = strategy->getGroupKey(fileInfo, file->fileSortInfo());
+    if (key.isEmpty()) {
+        fmWarning() << "GroupingEngine: Empty group key for file" << file->data(DFMBASE_NAMESPACE::Global::kItemUrlRole).toUrl();
+        return;
+    }
+
+    *ordinal = AbstractGroupStrategy::kInvalidGroupOrdinal;
+    *groupKey = std::move(key);
+}
+
 void GroupingEngine::sortGroupsByDisplayOrder(QList<FileGroupData> &groups) const
 {
     if (groups.isEmpty()) {
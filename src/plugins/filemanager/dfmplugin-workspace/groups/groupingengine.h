@@ -209,6 +209,19 @@ private:
     GroupingResult performGrouping(const QList<FileItemDataPointer> &files,
                                    DFMBASE_NAMESPACE::AbstractGroupStrategy *strategy) const;
 
+    /**
+     * @brief Classify a single file, may run on a pool thread
+     * @param file The file to classify
+     * @param strategy The grouping strategy
+     * @param ordinal Output group ordinal, kInvalidGroupOrdinal when groupKey is set,
+     *        left untouched when the file has no group
+     * @param groupKey Output group key for strategies without ordinals
+     */
+    void classifyFile(const FileItemDataPointer &file,
+                      DFMBASE_NAMESPACE::AbstractGroupStrategy *strategy,
+                      int *ordinal,
+                      QString *groupKey) const;
+
     /**
      * @brief Get FileInfoPointer from FileItemDataPointer
      * @param file The file item data pointer
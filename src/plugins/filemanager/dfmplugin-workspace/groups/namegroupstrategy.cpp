@@ -13,6 +13,20 @@
 DPWORKSPACE_USE_NAMESPACE
 DFMBASE_USE_NAMESPACE
 
+namespace {
+// Indexes into NameGroupStrategy::getNameOrder()
+enum NameGroupOrdinal {
+    kDigitOrdinal,
+    kLetterAHOrdinal,
+    kLetterIPOrdinal,
+    kLetterQZOrdinal,
+    kPinyinAHOrdinal,
+    kPinyinIPOrdinal,
+    kPinyinQZOrdinal,
+    kOthersOrdinal
+};
+}   // namespace
+
 QStringList NameGroupStrategy::getNameOrder()
 {
     return {
@@ -66,7 +80,7 @@ QString NameGroupStrategy::getGroupKey(const FileInfoPointer &info) const
         return "others";
     }
 
-    QString groupKey = classifyFirstCharacter(name.at(0));
+    QString groupKey = getNameOrder().at(classifyFirstCharacter(name.at(0)));
 
     fmDebug() << "NameGroupStrategy: File" << info->urlOf(UrlInfoType::kUrl).toString()
               << "name:" << name << "first char:" << name.at(0) << "-> group:" << groupKey;
@@ -74,6 +88,39 @@ QString NameGroupStrategy::getGroupKey(const FileInfoPointer &info) const
     return groupKey;
 }
 
+int NameGroupStrategy::getGroupOrdinal(const FileInfoPointer &info, const SortInfoPointer &sortInfo) const
+{
+    Q_UNUSED(sortInfo)
+
+    if (!info) {
+        return kOthersOrdinal;
+    }
+
+    const QString name = info->displayOf(DisPlayInfoType::kFileDisplayName);
+    if (name.isEmpty()) {
+        return kOthersOrdinal;
+    }
+
+    return classifyFirstCharacter(name.at(0));
+}
+
+QString NameGroupStrategy::getGroupKeyOfOrdinal(int ordinal) const
+{
+    return getNameOrder().value(ordinal);
+}
+
+void NameGroupStrategy::beginGroupClassification()
+{
+    // Build the pinyin table up front so the classification threads do not
+    // all block on its first use
+    Pinyin::InitialOf(QChar());
+}
+
+bool NameGroupStrategy::isConcurrentClassificationSafe() const
+{
+    return true;
+}
+
 QString NameGroupStrategy::getGroupDisplayName(const QString &groupKey) const
 {
     return getDisplayNames().value(groupKey, groupKey);
@@ -107,22 +154,22 @@ QString NameGroupStrategy::getStrategyName() const
     return GroupStrategy::kName;
 }
 
-QString NameGroupStrategy::classifyFirstCharacter(const QChar &ch) const
+int NameGroupStrategy::classifyFirstCharacter(const QChar &ch) const
 {
     // Check for digits
     if (ch.isDigit()) {
-        return "0-9";
+        return kDigitOrdinal;
     }
 
     // Check for English letters
     if (ch.isLetter() && ch.unicode() < 128) {
         char upper = ch.toUpper().toLatin1();
         if (upper >= 'A' && upper <= 'H') {
-            return "A-H";
+            return kLetterAHOrdinal;
         } else if (upper >= 'I' && upper <= 'P') {
-            return "I-P";
+            return kLetterIPOrdinal;
         } else if (upper >= 'Q' && upper <= 'Z') {
-            return "Q-Z";
+            return kLetterQZOrdinal;
         }
     }
 
@@ -132,17 +179,17 @@ QString NameGroupStrategy::classifyFirstCharacter(const QChar &ch) const
         if (!pinyin.isEmpty()) {
             char first = pinyin.at(0).toUpper().toLatin1();
             if (first >= 'A' && first <= 'H') {
-                return "pinyin-A-H";
+                return kPinyinAHOrdinal;
             } else if (first >= 'I' && first <= 'P') {
-                return "pinyin-I-P";
+                return kPinyinIPOrdinal;
             } else if (first >= 'Q' && first <= 'Z') {
-                return "pinyin-Q-Z";
+                return kPinyinQZOrdinal;
             }
         }
     }
 
     // Everything else goes to "others"
-    return "others";
+    return kOthersOrdinal;
 }
 
 bool NameGroupStrategy::isChinese(const QChar &ch) const
@@ -155,17 +202,10 @@ bool NameGroupStrategy::isChinese(const QChar &ch) const
 
 QString NameGroupStrategy::getPinyin(const QChar &ch) const
 {
-    // Use the existing Pinyin::Chinese2Pinyin function
-    QString singleChar = QString(ch);
-    QString pinyinResult = Pinyin::Chinese2Pinyin(singleChar);
-
-    if (!pinyinResult.isEmpty()) {
-        // The function returns a space-separated string, take the first word
-        QStringList pinyinWords = pinyinResult.split(' ', Qt::SkipEmptyParts);
-        if (!pinyinWords.isEmpty() && !pinyinWords.first().isEmpty()) {
-            return pinyinWords.first();
-        }
-    }
+    // Only the initial is needed to pick a group, look it up directly
+    const QChar initial = Pinyin::InitialOf(ch);
+    if (!initial.isNull())
+        return QString(initial);
 
     fmDebug() << "NameGroupStrategy: Failed to convert Chinese character to pinyin:" << ch;
     return QString();   // Conversion failed
@@ -43,14 +43,18 @@ public:
     int getGroupDisplayOrder(const QString &groupKey) const override;
     bool isGroupVisible(const QString &groupKey, const QList<FileInfoPointer> &infos) const override;
     QString getStrategyName() const override;
+    int getGroupOrdinal(const FileInfoPointer &info, const SortInfoPointer &sortInfo) const override;
+    QString getGroupKeyOfOrdinal(int ordinal) const override;
+    void beginGroupClassification() override;
+    bool isConcurrentClassificationSafe() const override;
 
 private:
     /**
      * @brief Classify the first character of a name
      * @param ch The first character to classify
-     * @return The corresponding group key
+     * @return The index of the name group in getNameOrder()
      */
-    QString classifyFirstCharacter(const QChar &ch) const;
+    int classifyFirstCharacter(const QChar &ch) const;
 
     /**
      * @brief Check if a character is Chinese
@@ -62,4 +62,21 @@ QString NoGroupStrategy::getStrategyName() const
     return GroupStrategy::kNoGroup;
 }
 
+int NoGroupStrategy::getGroupOrdinal(const FileInfoPointer &info, const SortInfoPointer &sortInfo) const
+{
+    Q_UNUSED(info)
+    Q_UNUSED(sortInfo)
+    return 0;
+}
+
+QString NoGroupStrategy::getGroupKeyOfOrdinal(int ordinal) const
+{
+    return ordinal == 0 ? QString::fromLatin1(kNoGroupKey) : QString();
+}
+
+bool NoGroupStrategy::isConcurrentClassificationSafe() const
+{
+    return true;
+}
+
 DPWORKSPACE_END_NAMESPACE
@@ -43,6 +43,9 @@ public:
     int getGroupDisplayOrder(const QString &groupKey) const override;
     bool isGroupVisible(const QString &groupKey, const QList<FileInfoPointer> &infos) const override;
     QString getStrategyName() const override;
+    int getGroupOrdinal(const FileInfoPointer &info, const SortInfoPointer &sortInfo) const override;
+    QString getGroupKeyOfOrdinal(int ordinal) const override;
+    bool isConcurrentClassificationSafe() const override;
 
 private:
     static constexpr const char *kNoGroupKey = "no-group";
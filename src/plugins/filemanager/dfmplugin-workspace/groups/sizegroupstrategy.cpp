@@ -14,6 +14,20 @@ DFMBASE_USE_NAMESPACE
 
 namespace dfmplugin_workspace {
 
+namespace {
+// Indexes into SizeGroupStrategy::getSizeOrder()
+enum SizeGroupOrdinal {
+    kUnknownOrdinal,
+    kEmptyOrdinal,
+    kTinyOrdinal,
+    kSmallOrdinal,
+    kMediumOrdinal,
+    kLargeOrdinal,
+    kHugeOrdinal,
+    kGiganticOrdinal
+};
+}   // namespace
+
 QStringList SizeGroupStrategy::getSizeOrder()
 {
     return {
@@ -65,22 +79,8 @@ QString SizeGroupStrategy::getGroupKey(const FileInfoPointer &info) const
         return "unknown";
     }
 
-    // Get file size for classification
-    // Priority: Use expected size (for files being copied/moved), fallback to actual size
-    qint64 size = 0;
-    QVariant expectedSize = info->extendAttributes(ExtInfoType::kExpectedSize);
-
-    if (expectedSize.isValid() && expectedSize.toLongLong() > 0) {
-        // Use expected size for files being operated on (copying/moving)
-        size = expectedSize.toLongLong();
-        fmDebug() << "SizeGroupStrategy: Using expected size for file:" << info->urlOf(UrlInfoType::kUrl).toString()
-                  << "expected:" << size << "bytes";
-    } else {
-        // Use actual size
-        size = info->size();
-    }
-
-    QString groupKey = classifyBySize(size);
+    const qint64 size = classifiedSizeOf(info);
+    QString groupKey = getSizeOrder().at(classifyBySize(size));
 
     fmDebug() << "SizeGroupStrategy: File" << info->urlOf(UrlInfoType::kUrl).toString()
               << "size:" << size << "bytes -> group:" << groupKey;
@@ -88,6 +88,27 @@ QString SizeGroupStrategy::getGroupKey(const FileInfoPointer &info) const
     return groupKey;
 }
 
+int SizeGroupStrategy::getGroupOrdinal(const FileInfoPointer &info, const SortInfoPointer &sortInfo) const
+{
+    Q_UNUSED(sortInfo)
+
+    if (!info || info->isAttributes(OptInfoType::kIsDir)) {
+        return kUnknownOrdinal;
+    }
+
+    return classifyBySize(classifiedSizeOf(info));
+}
+
+QString SizeGroupStrategy::getGroupKeyOfOrdinal(int ordinal) const
+{
+    return getSizeOrder().value(ordinal);
+}
+
+bool SizeGroupStrategy::isConcurrentClassificationSafe() const
+{
+    return true;
+}
+
 QString SizeGroupStrategy::getGroupDisplayName(const QString &groupKey) const
 {
     return getDisplayNames().value(groupKey, groupKey);
@@ -121,7 +142,18 @@ QString SizeGroupStrategy::getStrategyName() const
     return GroupStrategy::kSize;
 }
 
-QString SizeGroupStrategy::classifyBySize(qint64 size) const
+qint64 SizeGroupStrategy::classifiedSizeOf(const FileInfoPointer &info) const
+{
+    // Priority: Use expected size (for files being copied/moved), fallback to actual size
+    const QVariant expectedSize = info->extendAttributes(ExtInfoType::kExpectedSize);
+    if (expectedSize.isValid() && expectedSize.toLongLong() > 0) {
+        return expectedSize.toLongLong();
+    }
+
+    return info->size();
+}
+
+int SizeGroupStrategy::classifyBySize(qint64 size) const
 {
     // Define size constants
     const qint64 KB = 1024;
@@ -130,19 +162,19 @@ QString SizeGroupStrategy::classifyBySize(qint64 size) const
 
     // Classify by size ranges according to requirements
     if (size == 0) {
-        return "empty";
+        return kEmptyOrdinal;
     } else if (size <= 16 * KB) {
-        return "tiny";
+        return kTinyOrdinal;
     } else if (size <= 1 * MB) {
-        return "small";
+        return kSmallOrdinal;
     } else if (size <= 128 * MB) {
-        return "medium";
+        return kMediumOrdinal;
     } else if (size <= 1 * GB) {
-        return "large";
+        return kLargeOrdinal;
     } else if (size <= 4 * GB) {
-        return "huge";
+        return kHugeOrdinal;
     } else {
-        return "gigantic";
+        return kGiganticOrdinal;
     }
 }
 
@@ -39,14 +39,24 @@ public:
     int getGroupDisplayOrder(const QString &groupKey) const override;
     bool isGroupVisible(const QString &groupKey, const QList<FileInfoPointer> &infos) const override;
     QString getStrategyName() const override;
+    int getGroupOrdinal(const FileInfoPointer &info, const SortInfoPointer &sortInfo) const override;
+    QString getGroupKeyOfOrdinal(int ordinal) const override;
+    bool isConcurrentClassificationSafe() const override;
 
 private:
     /**
      * @brief Classify file size into a group
      * @param size The file size in bytes
-     * @return The corresponding size group key
+     * @return The index of the size group in getSizeOrder()
      */
-    QString classifyBySize(qint64 size) const;
+    int classifyBySize(qint64 size) const;
+
+    /**
+     * @brief Get the size used for classification
+     * @param info The file info
+     * @return The expected size for files being operated on, otherwise the actual size
+     */
+    qint64 classifiedSizeOf(const FileInfoPointer &info) const;
 
     /**
      * @brief Get the size order list
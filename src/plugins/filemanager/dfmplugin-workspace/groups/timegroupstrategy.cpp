@@ -16,6 +16,18 @@
 DPWORKSPACE_USE_NAMESPACE
 DFMBASE_USE_NAMESPACE
 
+namespace {
+// 分组序号：今天、昨天、过去7天、过去30天、今年的 12 个月、过去 5 年、更早
+constexpr int kTodayOrdinal = 0;
+constexpr int kYesterdayOrdinal = 1;
+constexpr int kPast7DaysOrdinal = 2;
+constexpr int kPast30DaysOrdinal = 3;
+constexpr int kMonthOrdinalBase = 3;   // month-1 -> 4 ... month-12 -> 15
+constexpr int kYearOrdinalBase = 15;   // 1 年前 -> 16 ... 5 年前 -> 20
+constexpr int kMaxYearsAgo = 5;
+constexpr int kEarlierOrdinal = kYearOrdinalBase + kMaxYearsAgo + 1;
+}   // namespace
+
 QStringList TimeGroupStrategy::getTimeOrder()
 {
     return {
@@ -38,8 +50,19 @@ QHash<QString, QString> TimeGroupStrategy::getDisplayNames()
     };
 }
 
+TimeGroupStrategy::TimeReference TimeGroupStrategy::TimeReference::current()
+{
+    TimeReference reference;
+    reference.now = QDateTime::currentDateTime();
+    reference.today = reference.now.date();
+    reference.yesterday = reference.today.addDays(-1);
+    reference.past7Days = reference.now.addDays(-7);
+    reference.past30Days = reference.now.addDays(-30);
+    return reference;
+}
+
 TimeGroupStrategy::TimeGroupStrategy(TimeType timeType, QObject *parent)
-    : AbstractGroupStrategy(parent), m_timeType(timeType)
+    : AbstractGroupStrategy(parent), m_timeType(timeType), m_reference(TimeReference::current())
 {
     fmDebug() << "TimeGroupStrategy: Initialized with time type:" << (timeType == kModificationTime ? "Modification" : "Creation");
 }
@@ -56,6 +79,49 @@ QString TimeGroupStrategy::getGroupKey(const FileInfoPointer &info) const
         return "earlier";
     }
 
+    const QDateTime fileTime = groupingTimeOf(info);
+    if (!fileTime.isValid()) {
+        return "earlier";
+    }
+
+    const TimeReference reference = TimeReference::current();
+    QString groupKey = timeGroupKeyOf(calculateTimeOrdinal(fileTime, reference), reference);
+
+    fmDebug() << "TimeGroupStrategy: File" << info->urlOf(UrlInfoType::kUrl).toString()
+              << "time:" << fileTime.toString() << "-> group:" << groupKey;
+
+    return groupKey;
+}
+
+int TimeGroupStrategy::getGroupOrdinal(const FileInfoPointer &info, const SortInfoPointer &sortInfo) const
+{
+    Q_UNUSED(sortInfo)
+
+    if (!info) {
+        return kEarlierOrdinal;
+    }
+
+    return calculateTimeOrdinal(groupingTimeOf(info), m_reference);
+}
+
+QString TimeGroupStrategy::getGroupKeyOfOrdinal(int ordinal) const
+{
+    return timeGroupKeyOf(ordinal, m_reference);
+}
+
+void TimeGroupStrategy::beginGroupClassification()
+{
+    // 同一轮分组中的文件使用同一个参考时间，也避免逐个文件获取当前时间
+    m_reference = TimeReference::current();
+}
+
+bool TimeGroupStrategy::isConcurrentClassificationSafe() const
+{
+    return true;
+}
+
+QDateTime TimeGroupStrategy::groupingTimeOf(const FileInfoPointer &info) const
+{
     // AsyncFileinfo 的设计缺陷无法实时获取到时间相关属性
     FileInfoPointer newFileInfo { info };
     const auto url { info->urlOf(UrlInfoType::kUrl) };
@@ -75,15 +141,9 @@ QString TimeGroupStrategy::getGroupKey(const FileInfoPointer &info) const
 
     if (!fileTime.isValid()) {
         fmWarning() << "TimeGroupStrategy: Invalid file time for" << newFileInfo->urlOf(UrlInfoType::kUrl).toString();
-        return "earlier";
     }
 
-    QString groupKey = calculateTimeGroup(fileTime);
-
-    fmDebug() << "TimeGroupStrategy: File" << info->urlOf(UrlInfoType::kUrl).toString()
-              << "time:" << fileTime.toString() << "-> group:" << groupKey;
-
-    return groupKey;
+    return fileTime;
 }
 
 QString TimeGroupStrategy::getGroupDisplayName(const QString &groupKey) const
@@ -182,49 +242,73 @@ QString TimeGroupStrategy::getStrategyName() const
     }
 }
 
-QString TimeGroupStrategy::calculateTimeGroup(const QDateTime &fileTime) const
+int TimeGroupStrategy::calculateTimeOrdinal(const QDateTime &fileTime, const TimeReference &reference)
 {
     if (!fileTime.isValid()) {
-        return "earlier";
+        return kEarlierOrdinal;
     }
 
-    QDateTime now = QDateTime::currentDateTime();
-    QDate today = now.date();
-    QDate fileDate = fileTime.date();
+    const QDate fileDate = fileTime.date();
 
     // 今天：时间为当日 00：00-23：59的文件。
-    if (fileDate == today) {
-        return "today";
+    if (fileDate == reference.today) {
+        return kTodayOrdinal;
     }
 
     // 昨天：时间为昨天 00：00-23：59的文件。
-    if (fileDate == today.addDays(-1)) {
-        return "yesterday";
+    if (fileDate == reference.yesterday) {
+        return kYesterdayOrdinal;
     }
 
     // 过去 7天：按当前精确时分倒推 7*24h，排除今天和昨天。
-    if (fileTime >= now.addDays(-7)) {
-        return "past-7-days";
+    if (fileTime >= reference.past7Days) {
+        return kPast7DaysOrdinal;
     }
 
     // 过去 30天：按当前精确时分倒推 30*24h，排除已分组的。
-    if (fileTime >= now.addDays(-30)) {
-        return "past-30-days";
+    if (fileTime >= reference.past30Days) {
+        return kPast30DaysOrdinal;
     }
 
     // 月份：今年内的文件，排除以上所有。
-    if (fileDate.year() == today.year()) {
-        return QString("month-%1").arg(fileDate.month());
+    if (fileDate.year() == reference.today.year()) {
+        return kMonthOrdinalBase + fileDate.month();
     }
 
     // 年份：最多显示过去 5年。
     // 例如今年是 2025年，显示 2024, 2023, 2022, 2021, 2020 年。
-    int yearDiff = today.year() - fileDate.year();
-    if (yearDiff >= 1 && yearDiff <= 5) {
-        return QString("year-%1").arg(fileDate.year());
+    int yearDiff = reference.today.year() - fileDate.year();
+    if (yearDiff >= 1 && yearDiff <= kMaxYearsAgo) {
+        return kYearOrdinalBase + yearDiff;
     }
 
     // 更早：5年以前的文件。
     // 例如今年是 2025年，2019年及之前的文件。
+    return kEarlierOrdinal;
+}
+
+QString TimeGroupStrategy::timeGroupKeyOf(int ordinal, const TimeReference &reference)
+{
+    switch (ordinal) {
+    case kTodayOrdinal:
+        return "today";
+    case kYesterdayOrdinal:
+        return "yesterday";
+    case kPast7DaysOrdinal:
+        return "past-7-days";
+    case kPast30DaysOrdinal:
+        return "past-30-days";
+    default:
+        break;
+    }
+
+    if (ordinal > kMonthOrdinalBase && ordinal <= kMonthOrdinalBase + 12) {
+        return QString("month-%1").arg(ordinal - kMonthOrdinalBase);
+    }
+
+    if (ordinal > kYearOrdinalBase && ordinal <= kYearOrdinalBase + kMaxYearsAgo) {
+        return QString("year-%1").arg(reference.today.year() - (ordinal - kYearOrdinalBase));
+    }
+
     return "earlier";
 }
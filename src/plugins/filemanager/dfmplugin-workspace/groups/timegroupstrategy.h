@@ -54,14 +54,53 @@ public:
     int getGroupDisplayOrder(const QString &groupKey) const override;
     bool isGroupVisible(const QString &groupKey, const QList<FileInfoPointer> &infos) const override;
     QString getStrategyName() const override;
+    int getGroupOrdinal(const FileInfoPointer &info, const SortInfoPointer &sortInfo) const override;
+    QString getGroupKeyOfOrdinal(int ordinal) const override;
+    void beginGroupClassification() override;
+    bool isConcurrentClassificationSafe() const override;
 
 private:
+    /**
+     * @brief Reference points the time groups are computed against
+     */
+    struct TimeReference
+    {
+        QDateTime now;
+        QDate today;
+        QDate yesterday;
+        QDateTime past7Days;
+        QDateTime past30Days;
+
+        static TimeReference current();
+    };
+
     /**
      * @brief Calculate time group for a given file time
      * @param fileTime The file timestamp
-     * @return The corresponding time group key
+     * @param reference The reference time
+     * @return The corresponding time group ordinal
+     */
+    static int calculateTimeOrdinal(const QDateTime &fileTime, const TimeReference &reference);
+
+    /**
+     * @brief Get the group key of a time group ordinal
+     * @param ordinal The time group ordinal
+     * @param reference The reference time the ordinal was computed against
+     * @return The time group key
+     */
+    static QString timeGroupKeyOf(int ordinal, const TimeReference &reference);
+
+    /**
+     * @brief Get the timestamp used for grouping
+     * @param info The file info
+     * @return The timestamp selected by m_timeType, invalid if unavailable
+     */
+    QDateTime groupingTimeOf(const FileInfoPointer &info) const;
+
+    /**
+     * @brief Reference time of the current classification pass
      */
-    QString calculateTimeGroup(const QDateTime &fileTime) const;
+    TimeReference m_reference;
 
     /**
      * @brief The type of time to use for grouping
@@ -15,6 +15,21 @@
 DPWORKSPACE_USE_NAMESPACE
 DFMBASE_USE_NAMESPACE
 
+namespace {
+// Indexes into TypeGroupStrategy::getTypeOrder()
+enum TypeGroupOrdinal {
+    kDirectoryOrdinal,
+    kDocumentOrdinal,
+    kImageOrdinal,
+    kVideoOrdinal,
+    kAudioOrdinal,
+    kArchiveOrdinal,
+    kApplicationOrdinal,
+    kExecutableOrdinal,
+    kUnknownOrdinal
+};
+}   // namespace
+
 QStringList TypeGroupStrategy::getTypeOrder()
 {
     return {
@@ -68,11 +83,7 @@ QString TypeGroupStrategy::getGroupKey(const FileInfoPointer &info) const
         return "directory";
     }
 
-    // asyncfile 无法准确获取 mimetype
-    static QMimeDatabase mimeDb;
-    QMimeType mimeType = mimeDb.mimeTypeForFile(info->pathOf(PathInfoType::kFilePath));
-    QString mimeTypeName = mimeType.name();
-
+    const QString mimeTypeName = mimeTypeNameOf(info);
     QString groupKey = mapMimeTypeToGroup(mimeTypeName);
 
     fmDebug() << "TypeGroupStrategy: File" << info->urlOf(UrlInfoType::kUrl).toString()
@@ -81,6 +92,38 @@ QString TypeGroupStrategy::getGroupKey(const FileInfoPointer &info) const
     return groupKey;
 }
 
+int TypeGroupStrategy::getGroupOrdinal(const FileInfoPointer &info, const SortInfoPointer &sortInfo) const
+{
+    Q_UNUSED(sortInfo)
+
+    if (!info) {
+        return kUnknownOrdinal;
+    }
+
+    if (info->isAttributes(OptInfoType::kIsDir)) {
+        return kDirectoryOrdinal;
+    }
+
+    return mapMimeTypeToOrdinal(mimeTypeNameOf(info));
+}
+
+QString TypeGroupStrategy::getGroupKeyOfOrdinal(int ordinal) const
+{
+    return getTypeOrder().value(ordinal);
+}
+
+bool TypeGroupStrategy::isConcurrentClassificationSafe() const
+{
+    return true;
+}
+
+QString TypeGroupStrategy::mimeTypeNameOf(const FileInfoPointer &info) const
+{
+    // asyncfile 无法准确获取 mimetype
+    static QMimeDatabase mimeDb;
+    return mimeDb.mimeTypeForFile(info->pathOf(PathInfoType::kFilePath)).name();
+}
+
 QString TypeGroupStrategy::getGroupDisplayName(const QString &groupKey) const
 {
     return getDisplayNames().value(groupKey, groupKey);
@@ -115,9 +158,14 @@ QString TypeGroupStrategy::getStrategyName() const
 }
 
 QString TypeGroupStrategy::mapMimeTypeToGroup(const QString &mimeType) const
+{
+    return getTypeOrder().at(mapMimeTypeToOrdinal(mimeType));
+}
+
+int TypeGroupStrategy::mapMimeTypeToOrdinal(const QString &mimeType) const
 {
     if (mimeType.isEmpty()) {
-        return "unknown";
+        return kUnknownOrdinal;
     }
 
     // Use MimeTypeDisplayManager to get the file type classification
@@ -125,24 +173,24 @@ QString TypeGroupStrategy::mapMimeTypeToGroup(const QString &mimeType) const
 
     switch (displayType) {
     case FileInfo::FileType::kDirectory:
-        return "directory";
+        return kDirectoryOrdinal;
     case FileInfo::FileType::kDocuments:
-        return "document";
+        return kDocumentOrdinal;
     case FileInfo::FileType::kImages:
-        return "image";
+        return kImageOrdinal;
     case FileInfo::FileType::kVideos:
-        return "video";
+        return kVideoOrdinal;
     case FileInfo::FileType::kAudios:
-        return "audio";
+        return kAudioOrdinal;
     case FileInfo::FileType::kArchives:
-        return "archive";
+        return kArchiveOrdinal;
     case FileInfo::FileType::kExecutable:
-        return "executable";
+        return kExecutableOrdinal;
     case FileInfo::FileType::kBackups:
-        return "archive";   // Backup files are classified as archive files
+        return kArchiveOrdinal;   // Backup files are classified as archive files
     case FileInfo::FileType::kDesktopApplication:
-        return "application";
+        return kApplicationOrdinal;
     default:
-        return "unknown";
+        return kUnknownOrdinal;
     }
 }
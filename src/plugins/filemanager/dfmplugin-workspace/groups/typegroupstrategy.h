@@ -43,6 +43,9 @@ public:
     int getGroupDisplayOrder(const QString &groupKey) const override;
     bool isGroupVisible(const QString &groupKey, const QList<FileInfoPointer> &infos) const override;
     QString getStrategyName() const override;
+    int getGroupOrdinal(const FileInfoPointer &info, const SortInfoPointer &sortInfo) const override;
+    QString getGroupKeyOfOrdinal(int ordinal) const override;
+    bool isConcurrentClassificationSafe() const override;
 
 private:
     /**
@@ -52,6 +55,18 @@ private:
      */
     QString mapMimeTypeToGroup(const QString &mimeType) const;
 
+    /**
+     * @brief Map MIME type to group ordinal
+     * @param mimeType The MIME type string
+     * @return The index of the type group in getTypeOrder()
+     */
+    int mapMimeTypeToOrdinal(const QString &mimeType) const;
+
+    /**
+     * @brief Get the MIME type name used for classification
+     */
+    QString mimeTypeNameOf(const FileInfoPointer &info) const;
+
     /**
      * @brief Get the type order list
      * @return The type order according to requirements (directories first, then by frequency)
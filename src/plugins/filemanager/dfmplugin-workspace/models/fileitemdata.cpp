@@ -118,6 +118,13 @@ void FileItemData::clearThumbnail()
     }
 }
 
+void FileItemData::resetHighlightRequest()
+{
+    // 请求被 HighlightProvider 丢弃后清除标记，行再次可见时重新请求
+    if (sortInfo)
+        sortInfo->setCustomData(highlightRequestedKey(), false);
+}
+
 FileInfoPointer FileItemData::fileInfo() const
 {
     return info;
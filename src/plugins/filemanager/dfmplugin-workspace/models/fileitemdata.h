@@ -24,6 +24,7 @@ public:
 
     void refreshInfo();
     void clearThumbnail();
+    void resetHighlightRequest();
     FileInfoPointer fileInfo() const;
     FileItemData *parentData() const;
     QIcon fileIcon() const;
@@ -55,6 +55,7 @@ FileViewModel::FileViewModel(QAbstractItemView *parent)
 
     connect(ThumbnailFactory::instance(), &ThumbnailFactory::produceFinished, this, &FileViewModel::onFileThumbUpdated);
     connect(HighlightProvider::instance(), &HighlightProvider::highlightReady, this, &FileViewModel::onHighlightReady);
+    connect(HighlightProvider::instance(), &HighlightProvider::highlightDropped, this, &FileViewModel::onHighlightDropped);
     connect(Application::instance(), &Application::genericAttributeChanged, this, &FileViewModel::onGenericAttributeChanged);
     connect(Application::instance(), &Application::showedHiddenFilesChanged, this, &FileViewModel::onHiddenSettingChanged);
     connect(DConfigManager::instance(), &DConfigManager::valueChanged, this, &FileViewModel::onDConfigChanged);
@@ -1106,6 +1107,22 @@ void FileViewModel::onHighlightReady(const QString &taskId, const QString &path,
     }
 }
 
+void FileViewModel::onHighlightDropped(const QString &taskId, const QString &path)
+{
+    Q_UNUSED(taskId)
+
+    if (!filterSortWorker)
+        return;
+
+    auto updateIndex = getIndexByUrl(QUrl::fromLocalFile(path));
+    if (!updateIndex.isValid())
+        return;
+
+    auto itemData = filterSortWorker->childData(updateIndex.row());
+    if (itemData)
+        itemData->resetHighlightRequest();
+}
+
 void FileViewModel::onFileUpdated(int show)
 {
     // NOTE: Use dataChanged instead of view->update() here.
@@ -128,8 +128,7 @@ void RootInfo::startWork(const QString &key)
     fmInfo() << "Starting directory traversal for URL:" << url.toString();
     {
         QWriteLocker lk(&childrenLock);
-        childrenUrlList.clear();
-        sourceDataList.clear();
+        clearChildrenLocked();
     }
     traversalThreads.value(key)->traversalThread->start();
 }
@@ -215,8 +214,7 @@ void RootInfo::reset()
 
     {
         QWriteLocker lk(&childrenLock);
-        childrenUrlList.clear();
-        sourceDataList.clear();
+        clearChildrenLocked();
     }
 
     if (watcher) {
@@ -387,8 +385,7 @@ void RootInfo::doWatcherEvent()
                 emit requestCloseTab(fileUrl);
                 emit requestClearRoot(fileUrl);
                 QWriteLocker lk(&childrenLock);
-                childrenUrlList.clear();
-                sourceDataList.clear();
+                clearChildrenLocked();
                 break;
             }
         }
@@ -476,13 +473,20 @@ void RootInfo::handleTraversalResultsUpdate(const QList<SortInfoPointer> childre
         return;
     }
 
-    QWriteLocker lk(&childrenLock);
-    // 更新已存在的文件信息
-    sourceDataList = children;
+    // 迭代器只发送新增或变化的结果，按 url 合并：已存在的替换，新的追加
+    {
+        QWriteLocker lk(&childrenLock);
+        for (const auto &child : children) {
+            if (!child)
+                continue;
+
+            setChildLocked(child->fileUrl(), child);
+        }
+    }
 
     bool isFirst = isFirstBatch.exchange(false);   // Get and reset the flag
     fmDebug() << "Emitting iterator update files signal - children:" << children.size() << "isFirst:" << isFirst;
-    Q_EMIT iteratorUpdateFiles(travseToken, sourceDataList, isFirst);
+    Q_EMIT iteratorUpdateFiles(travseToken, children, isFirst);
 }
 
 void RootInfo::handleTraversalLocalResult(QList<SortInfoPointer> children,
@@ -595,8 +599,7 @@ void RootInfo::addChildren(const QList<SortInfoPointer> &children)
             continue;
 
         QWriteLocker lk(&childrenLock);
-        childrenUrlList.append(file->fileUrl());
-        sourceDataList.append(file);
+        setChildLocked(file->fileUrl(), file);
     }
 }
 
@@ -618,19 +621,46 @@ SortInfoPointer RootInfo::addChild(const FileInfoPointer &child)
 
     {
         QWriteLocker lk(&childrenLock);
-        if (childrenUrlList.contains(childUrl)) {
+        if (!setChildLocked(childUrl, sort)) {
             fmDebug() << "Replacing existing child:" << childUrl.toString();
-            sourceDataList.replace(childrenUrlList.indexOf(childUrl), sort);
             return sort;
         }
-        childrenUrlList.append(childUrl);
-        sourceDataList.append(sort);
         fmDebug() << "Added new child:" << childUrl.toString() << "total children:" << childrenUrlList.size();
     }
 
     return sort;
 }
 
+bool RootInfo::setChildLocked(const QUrl &childUrl, const SortInfoPointer &child)
+{
+    auto it = childrenIndex.constFind(childUrl);
+    if (it != childrenIndex.constEnd()) {
+        sourceDataList.replace(it.value(), child);
+        return false;
+    }
+
+    childrenIndex.insert(childUrl, childrenUrlList.size());
+    childrenUrlList.append(childUrl);
+    sourceDataList.append(child);
+    return true;
+}
+
+SortInfoPointer RootInfo::takeChildLocked(int index)
+{
+    childrenIndex.remove(childrenUrlList.takeAt(index));
+    // rows after the removed one move up by one
+    for (int i = index; i < childrenUrlList.size(); ++i)
+        childrenIndex[childrenUrlList.at(i)] = i;
+    return sourceDataList.takeAt(index);
+}
+
+void RootInfo::clearChildrenLocked()
+{
+    childrenUrlList.clear();
+    sourceDataList.clear();
+    childrenIndex.clear();
+}
+
 SortInfoPointer RootInfo::sortFileInfo(const FileInfoPointer &info)
 {
     if (!info) {
@@ -673,13 +703,12 @@ void RootInfo::removeChildren(const QList<QUrl> &urlList)
         auto realUrl = child->urlOf(UrlInfoType::kUrl);
         removeUrls.append(realUrl);
         QWriteLocker lk(&childrenLock);
-        childIndex = childrenUrlList.indexOf(realUrl);
+        childIndex = childrenIndex.value(realUrl, -1);
         if (childIndex < 0 || childIndex >= childrenUrlList.length()) {
             removeChildren.append(sortFileInfo(child));
             continue;
         }
-        childrenUrlList.removeAt(childIndex);
-        removeChildren.append(sourceDataList.takeAt(childIndex));
+        removeChildren.append(takeChildLocked(childIndex));
     }
 
     if (removeUrls.count() > 0)
@@ -695,7 +724,7 @@ void RootInfo::removeChildren(const QList<QUrl> &urlList)
 bool RootInfo::containsChild(const QUrl &url)
 {
     QReadLocker lk(&childrenLock);
-    return childrenUrlList.contains(url);
+    return childrenIndex.contains(url);
 }
 
 SortInfoPointer RootInfo::updateChild(const QUrl &url)
@@ -718,7 +747,7 @@ SortInfoPointer RootInfo::updateChild(const QUrl &url)
 
     {
         QWriteLocker lk(&childrenLock);
-        int index = childrenUrlList.indexOf(realUrl);
+        int index = childrenIndex.value(realUrl, -1);
         if (index < 0) {
             fmDebug() << "Child no longer in list for update:" << realUrl.toString();
             return nullptr;
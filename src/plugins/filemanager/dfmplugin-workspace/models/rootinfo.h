@@ -113,6 +113,10 @@ private:
     void addChildren(const QList<SortInfoPointer> &children);
     SortInfoPointer addChild(const FileInfoPointer &child);
     SortInfoPointer sortFileInfo(const FileInfoPointer &info);
+    // caller holds childrenLock for writing; returns false when an existing row was replaced
+    bool setChildLocked(const QUrl &childUrl, const SortInfoPointer &child);
+    SortInfoPointer takeChildLocked(int index);
+    void clearChildrenLocked();
     void removeChildren(const QList<QUrl> &urlList);
     bool containsChild(const QUrl &url);
     SortInfoPointer updateChild(const QUrl &url);
@@ -136,6 +140,7 @@ private:
     QReadWriteLock childrenLock;
     QList<QUrl> childrenUrlList {};
     QList<SortInfoPointer> sourceDataList {};
+    QHash<QUrl, int> childrenIndex {};   // url -> row in childrenUrlList/sourceDataList
     // origin data sort information
     dfmio::DEnumerator::SortRoleCompareFlag originSortRole { dfmio::DEnumerator::SortRoleCompareFlag::kSortRoleCompareDefault };
     Qt::SortOrder originSortOrder { Qt::AscendingOrder };
@@ -14,6 +14,7 @@
 #include <dfm-base/utils/fileutils.h>
 #include <dfm-base/base/application/application.h>
 #include <dfm-base/base/application/settings.h>
+#include <dfm-base/base/application/viewstatestore.h>
 #include <dfm-base/utils/universalutils.h>
 
 #include <dfm-framework/dpf.h>
@@ -647,14 +648,11 @@ QUrl WorkspaceHelper::transformViewModeUrl(const QUrl &url) const
 QVariant WorkspaceHelper::getFileViewStateValue(const QUrl &url, const QString &key, const QVariant &defaultValue) const
 {
     QUrl viewModeUrl = transformViewModeUrl(url);
-    QMap<QString, QVariant> valueMap = Application::appObtuselySetting()->value("FileViewState", viewModeUrl).toMap();
-    return valueMap.value(key, defaultValue);
+    return ViewStateStore::instance()->value(viewModeUrl, key, defaultValue);
 }
 
 void WorkspaceHelper::setFileViewStateValue(const QUrl &url, const QString &key, const QVariant &value)
 {
     QUrl viewModeUrl = transformViewModeUrl(url);
-    QVariantMap map = Application::appObtuselySetting()->value("FileViewState", viewModeUrl).toMap();
-    map[key] = value;
-    Application::appObtuselySetting()->setValue("FileViewState", viewModeUrl, map);
+    ViewStateStore::instance()->setValue(viewModeUrl, key, value);
 }
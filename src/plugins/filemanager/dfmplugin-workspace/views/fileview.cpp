@@ -32,6 +32,7 @@
 #include <dfm-base/dfm_global_defines.h>
 #include <dfm-base/base/application/application.h>
 #include <dfm-base/base/application/settings.h>
+#include <dfm-base/base/application/viewstatestore.h>
 #include <dfm-base/utils/windowutils.h>
 #include <dfm-base/utils/universalutils.h>
 #include <dfm-base/utils/networkutils.h>
@@ -1467,21 +1468,19 @@ void FileView::onHeaderViewSectionChanged(const QUrl &url)
     }
 }
 
-void FileView::onAppAttributeChanged(const QString &group, const QString &key, const QVariant &value)
+void FileView::onFileViewStateChanged()
 {
-    if (group == "FileViewState") {
-        if (isListViewMode() || isTreeViewMode()) {
-            int configListHeightLevel = d->fileViewStateValue(rootUrl(), "listHeightLevel", d->currentListHeightLevel).toInt();
-            onItemHeightLevelChanged(configListHeightLevel);
-        }
+    if (isListViewMode() || isTreeViewMode()) {
+        int configListHeightLevel = d->fileViewStateValue(rootUrl(), "listHeightLevel", d->currentListHeightLevel).toInt();
+        onItemHeightLevelChanged(configListHeightLevel);
+    }
 
-        if (isIconViewMode()) {
-            int configGridDensityLevel = d->fileViewStateValue(rootUrl(), "gridDensityLevel", d->currentGridDensityLevel).toInt();
-            onItemWidthLevelChanged(configGridDensityLevel);
+    if (isIconViewMode()) {
+        int configGridDensityLevel = d->fileViewStateValue(rootUrl(), "gridDensityLevel", d->currentGridDensityLevel).toInt();
+        onItemWidthLevelChanged(configGridDensityLevel);
 
-            int configIconSizeLevel = d->fileViewStateValue(rootUrl(), "iconSizeLevel", d->currentIconSizeLevel).toInt();
-            onIconSizeChanged(configIconSizeLevel);
-        }
+        int configIconSizeLevel = d->fileViewStateValue(rootUrl(), "iconSizeLevel", d->currentIconSizeLevel).toInt();
+        onIconSizeChanged(configIconSizeLevel);
     }
 }
 
@@ -2441,7 +2440,7 @@ void FileView::initializeConnect()
     connect(Application::instance(), &Application::showedFileSuffixChanged, this, &FileView::onShowFileSuffixChanged);
     connect(Application::instance(), &Application::previewAttributeChanged, this, &FileView::onWidgetUpdate);
     connect(Application::instance(), &Application::viewModeChanged, this, &FileView::onDefaultViewModeChanged);
-    connect(Application::appObtuselySetting(), &Settings::valueChanged, this, &FileView::onAppAttributeChanged);
+    connect(ViewStateStore::instance(), &ViewStateStore::valueChanged, this, &FileView::onFileViewStateChanged);
     connect(DGuiApplicationHelper::instance(), &DGuiApplicationHelper::sizeModeChanged, this, [this]() {
         if (d->currentViewMode == Global::ViewMode::kIconMode)
             d->adjustIconModeSpacing(model()->groupingStrategy());
@@ -150,7 +150,7 @@ public slots:
     void onRowCountChanged();
     void trashStateChanged();
     void onHeaderViewSectionChanged(const QUrl &url);
-    void onAppAttributeChanged(const QString &group, const QString &key, const QVariant &value);
+    void onFileViewStateChanged();
 
     void onSelectAndEdit(const QUrl &url);
 
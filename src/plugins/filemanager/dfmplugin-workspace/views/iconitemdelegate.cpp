@@ -256,6 +256,8 @@ void IconItemDelegate::updateItemSizeHint()
 {
     Q_D(IconItemDelegate);
 
+    d->textLayoutCache.clear();
+
     int width = parent()->parent()->iconSize().width();
     if (d->viewDefines.indexOfIconSize(width) >= 0)
         width += kIconModeIconSpacing * 2;
@@ -476,6 +478,7 @@ QList<QRectF> IconItemDelegate::calcFileNameRect(const QModelIndex &index, const
     int lineHeight = UniversalUtils::getTextLineHeight(name, parent()->parent()->fontMetrics());
     QScopedPointer<ElideTextLayout> layout(ItemDelegateHelper::createTextLayout(name, QTextOption::WrapAtWordBoundaryOrAnywhere,
                                                                                 lineHeight, Qt::AlignCenter));
+    layout->setLayoutCache(&d->textLayoutCache);
 
     // Add tag support by calling hook, same as Canvas implementation
     const FileInfoPointer &info = parent()->fileInfo(index);
@@ -736,6 +739,7 @@ void IconItemDelegate::paintItemFileName(QPainter *painter, QRectF iconRect, QPa
     int lineHeight = UniversalUtils::getTextLineHeight(displayName, parent()->parent()->fontMetrics());
     QScopedPointer<ElideTextLayout> layout(ItemDelegateHelper::createTextLayout(displayName, QTextOption::WrapAtWordBoundaryOrAnywhere,
                                                                                 lineHeight, Qt::AlignCenter, painter));
+    layout->setLayoutCache(&d->textLayoutCache);
     layout->setHighlightEnabled(!isSelected);
     layout->setHighlightKeywords(effectiveHighlightKeywords(index));
     layout->setHighlightColor(QColor(ThemeColor::kHighlightPressColor));
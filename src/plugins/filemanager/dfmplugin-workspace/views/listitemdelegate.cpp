@@ -342,6 +342,8 @@ void ListItemDelegate::updateItemSizeHint()
 {
     Q_D(ListItemDelegate);
 
+    d->textLayoutCache.clear();
+
     d->textLineHeight = parent()->parent()->fontMetrics().height();
     d->itemSizeHint = QSize(-1, qMax(int(d->viewDefines.listHeight(d->currentHeightLevel)), d->textLineHeight));
 }
@@ -580,6 +582,7 @@ void ListItemDelegate::paintItemColumn(QPainter *painter, const QStyleOptionView
                                                                                             QTextOption::WrapAtWordBoundaryOrAnywhere,
                                                                                             d->textLineHeight, index.data(Qt::TextAlignmentRole).toInt(),
                                                                                             painter));
+                layout->setLayoutCache(&d->textLayoutCache);
                 layout->layout(textRect, elideMode, painter);
             }
         }
@@ -622,6 +625,7 @@ void ListItemDelegate::paintFileName(QPainter *painter, const QStyleOptionViewIt
                 index.data(Qt::TextAlignmentRole).toInt(),
                 painter));
 
+        nameLayout->setLayoutCache(&d->textLayoutCache);
         nameLayout->setHighlightEnabled(!isSelected);
         nameLayout->setHighlightKeywords(effectiveHighlightKeywords(index));
         nameLayout->setHighlightColor(QColor(ThemeColor::kHighlightPressColor));
@@ -648,6 +652,7 @@ void ListItemDelegate::paintFileName(QPainter *painter, const QStyleOptionViewIt
                 index.data(Qt::TextAlignmentRole).toInt(),
                 painter));
 
+        contentLayout->setLayoutCache(&d->textLayoutCache);
         contentLayout->setHighlightEnabled(!isSelected);
         contentLayout->setHighlightKeywords(effectiveHighlightKeywords(index));
         contentLayout->setHighlightColor(QColor(ThemeColor::kHighlightPressColor));
@@ -665,6 +670,7 @@ void ListItemDelegate::paintFileName(QPainter *painter, const QStyleOptionViewIt
                 index.data(Qt::TextAlignmentRole).toInt(),
                 painter));
 
+        layout->setLayoutCache(&d->textLayoutCache);
         layout->setHighlightEnabled(!isSelected);
         layout->setHighlightKeywords(effectiveHighlightKeywords(index));
         layout->setHighlightColor(QColor(ThemeColor::kHighlightPressColor));
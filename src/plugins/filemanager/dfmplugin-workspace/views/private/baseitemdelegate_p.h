@@ -43,6 +43,8 @@ public:
     QWidget *commitDataCurentWidget { nullptr };
     QStringList highlightKeywords {};
     DFMBASE_NAMESPACE::ViewDefines viewDefines;
+    // 文本排版缓存，字体或缩放级别变化时在 updateItemSizeHint() 中清空
+    mutable DFMBASE_NAMESPACE::ElideTextLayoutCache textLayoutCache;
     QString hoveredTruncateGroupKey {};
     QString pressedTruncateGroupKey {};
 
@@ -36,15 +36,18 @@ public:
         m_requestTimeoutTimer.setSingleShot(true);
         m_idleShutdownTimer.setSingleShot(true);
 
-        connect(m_pipe, &EXTRACTOR_NAMESPACE::ControllerPipe::extractionFinished, this,
-                [this](const QString &path, const QByteArray &data) {
+        connect(m_pipe, &EXTRACTOR_NAMESPACE::ControllerPipe::payloadReady, this,
+                [this](const QString &path, const EXTRACTOR_NAMESPACE::ExtractionPayload &payload) {
                     if (!m_activeExtraction || path != m_activeExtraction->filePath) {
                         return;
                     }
 
                     fmDebug() << "ProcessExtractorProxy: extraction finished for:" << path
-                              << "size:" << data.size();
-                    finishActiveExtraction({ true, QString::fromUtf8(data).trimmed(), QString() });
+                              << "size:" << payload.size() << "shared:" << payload.isShared();
+                    // Decode straight from the payload, large results are still
+                    // mapped from the extractor's memfd at this point
+                    finishActiveExtraction({ true, QString::fromUtf8(payload.constData(), payload.size()).trimmed(),
+                                             QString() });
                 });
 
         connect(m_pipe, &EXTRACTOR_NAMESPACE::ControllerPipe::extractionFailed, this,
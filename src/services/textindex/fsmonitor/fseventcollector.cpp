@@ -5,6 +5,8 @@
 #include "fseventcollector_p.h"
 #include "utils/textindexconfig.h"
 
+#include <dfm-base/utils/dirsizecache.h>
+
 #include <algorithm>
 
 #include <QDir>
@@ -124,36 +126,45 @@ bool FSEventCollectorPrivate::startCollecting()
     // Connect to FSMonitor signals
     QObject::connect(&fsMonitor, &FSMonitor::fileCreated,
                      q_ptr, [this](const QString &path, const QString &name) {
+                         sizeDirtyDirs.insert(path);
                          handleFileCreated(path, name);
                      });
 
     QObject::connect(&fsMonitor, &FSMonitor::fileDeleted,
                      q_ptr, [this](const QString &path, const QString &name) {
+                         sizeDirtyDirs.insert(path);
                          handleFileDeleted(path, name);
                      });
 
     QObject::connect(&fsMonitor, &FSMonitor::fileClosed,
                      q_ptr, [this](const QString &path, const QString &name) {
+                         sizeDirtyDirs.insert(path);
                          handleFileClosed(path, name);
                      });
 
     QObject::connect(&fsMonitor, &FSMonitor::fileMoved,
                      q_ptr, [this](const QString &fromPath, const QString &fromName, const QString &toPath, const QString &toName) {
+                         sizeDirtyDirs.insert(fromPath);
+                         sizeDirtyDirs.insert(toPath);
                          handleFileMoved(fromPath, fromName, toPath, toName);
                      });
 
     QObject::connect(&fsMonitor, &FSMonitor::directoryCreated,
                      q_ptr, [this](const QString &path, const QString &name) {
+                         sizeDirtyDirs.insert(path);
                          handleDirectoryCreated(path, name);
                      });
 
     QObject::connect(&fsMonitor, &FSMonitor::directoryDeleted,
                      q_ptr, [this](const QString &path, const QString &name) {
+                         sizeDirtyDirs.insert(path);
                          handleDirectoryDeleted(path, name);
                      });
 
     QObject::connect(&fsMonitor, &FSMonitor::directoryMoved,
                      q_ptr, [this](const QString &fromPath, const QString &fromName, const QString &toPath, const QString &toName) {
+                         sizeDirtyDirs.insert(fromPath);
+                         sizeDirtyDirs.insert(toPath);
                          handleDirectoryMoved(fromPath, fromName, toPath, toName);
                      });
 
@@ -231,6 +242,7 @@ void FSEventCollectorPrivate::stopCollecting()
     deletedFilesList.clear();
     modifiedFilesList.clear();
     movedFilesList.clear();
+    flushSizeDirtyDirs();
 
     fmInfo() << "FSEventCollector: Stopped event collection";
 }
@@ -526,6 +538,7 @@ void FSEventCollectorPrivate::flushCollectedEvents()
     modifiedFilesList.clear();
     movedFilesList.clear();
     deletedDirectoriesMarker.clear();
+    flushSizeDirtyDirs();
 
     // Log statistics
     fmDebug() << "FSEventCollector: Flushing events - Created:" << created.size()
@@ -553,6 +566,19 @@ void FSEventCollectorPrivate::flushCollectedEvents()
     Q_EMIT q_ptr->flushFinished();
 }
 
+void FSEventCollectorPrivate::flushSizeDirtyDirs()
+{
+    // Directory size cache lives in the file manager process; hand over
+    // the touched directories through its journal so cached subtree sizes
+    // are invalidated even for directories the file manager isn't watching.
+    sizeDirtyDirs.remove(QString());
+    if (sizeDirtyDirs.isEmpty())
+        return;
+
+    DFMBASE_NAMESPACE::DirSizeCache::appendJournal(sizeDirtyDirs.values());
+    sizeDirtyDirs.clear();
+}
+
 void FSEventCollectorPrivate::removeRedundantEntries(QSet<QString> &filesList)
 {
     QSet<QString> directoryPaths;
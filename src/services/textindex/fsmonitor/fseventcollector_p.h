@@ -55,6 +55,9 @@ public:
     // Flush collected events (emit signals and clear)
     void flushCollectedEvents();
 
+    // Write directories touched since the last flush to the directory size cache journal
+    void flushSizeDirtyDirs();
+
     // Check if max event count exceeded
     bool isMaxEventCountExceeded() const;
 
@@ -114,6 +117,9 @@ public:
 
     // Marker for deleted directories
     QSet<QString> deletedDirectoriesMarker;
+
+    // Parent directories of every event, used to invalidate cached directory sizes
+    QSet<QString> sizeDirtyDirs;
 };
 
 SERVICETEXTINDEX_END_NAMESPACE
@@ -7,6 +7,7 @@
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonParseError>
@@ -16,6 +17,8 @@ SERVICETEXTINDEX_BEGIN_NAMESPACE
 
 namespace {
 
+constexpr qint64 kCrawlCheckpointMaxAgeSecs { 2 * 24 * 60 * 60 };
+
 QJsonObject readStatusJson(const QString &filePath)
 {
     QFile file(filePath);
@@ -69,6 +72,24 @@ bool writeStatusJson(const QString &filePath, const QJsonObject &obj)
     return true;
 }
 
+QJsonArray toJsonArray(const QStringList &list)
+{
+    QJsonArray array;
+    for (const QString &item : list)
+        array.append(item);
+    return array;
+}
+
+QStringList fromJsonArray(const QJsonValue &value)
+{
+    QStringList list;
+    const QJsonArray array = value.toArray();
+    list.reserve(array.size());
+    for (const QJsonValue &item : array)
+        list.append(item.toString());
+    return list;
+}
+
 }   // namespace
 
 IndexStateStore::IndexStateStore(IndexProfile profile)
@@ -209,4 +230,87 @@ void IndexStateStore::saveLastUpdateTime(const QDateTime &lastUpdateTime) const
     writeStatusJson(statusFilePath(), obj);
 }
 
+QString IndexStateStore::crawlCheckpointFilePath() const
+{
+    const QString indexDir = m_profile.indexDirectory();
+    if (indexDir.isEmpty()) {
+        return QString();
+    }
+
+    return indexDir + QLatin1String("/crawl_checkpoint.json");
+}
+
+CrawlCheckpoint IndexStateStore::loadCrawlCheckpoint() const
+{
+    const QString filePath = crawlCheckpointFilePath();
+    if (filePath.isEmpty() || !QFile::exists(filePath)) {
+        return CrawlCheckpoint();
+    }
+
+    const QJsonObject obj = readStatusJson(filePath);
+    if (obj.value(QLatin1String("version")).toInt(-1) != m_profile.runtimeIndexVersion()) {
+        fmInfo() << "IndexStateStore::loadCrawlCheckpoint: discarding checkpoint of another index version for profile:"
+                 << m_profile.id();
+        return CrawlCheckpoint();
+    }
+
+    // 断点过旧时已遍历部分的变化无法保证被覆盖，重新完整遍历
+    const QDateTime updatedAt = QDateTime::fromString(obj.value(QLatin1String("updatedAt")).toString(), Qt::ISODate);
+    if (!updatedAt.isValid() || updatedAt.secsTo(QDateTime::currentDateTime()) > kCrawlCheckpointMaxAgeSecs) {
+        fmInfo() << "IndexStateStore::loadCrawlCheckpoint: discarding expired checkpoint for profile:" << m_profile.id();
+        return CrawlCheckpoint();
+    }
+
+    CrawlCheckpoint checkpoint;
+    checkpoint.taskType = obj.value(QLatin1String("taskType")).toString();
+    checkpoint.roots = fromJsonArray(obj.value(QLatin1String("roots")));
+    checkpoint.completedRoots = fromJsonArray(obj.value(QLatin1String("completedRoots")));
+    checkpoint.currentRoot = obj.value(QLatin1String("currentRoot")).toString();
+    checkpoint.pendingDirs = fromJsonArray(obj.value(QLatin1String("pendingDirs")));
+    checkpoint.cleanupDone = obj.value(QLatin1String("cleanupDone")).toBool();
+    return checkpoint;
+}
+
+void IndexStateStore::saveCrawlCheckpoint(const CrawlCheckpoint &checkpoint) const
+{
+    const QString filePath = crawlCheckpointFilePath();
+    if (filePath.isEmpty()) {
+        return;
+    }
+
+    QJsonObject obj;
+    obj[QLatin1String("version")] = m_profile.runtimeIndexVersion();
+    obj[QLatin1String("updatedAt")] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    obj[QLatin1String("taskType")] = checkpoint.taskType;
+    obj[QLatin1String("roots")] = toJsonArray(checkpoint.roots);
+    obj[QLatin1String("completedRoots")] = toJsonArray(checkpoint.completedRoots);
+    obj[QLatin1String("currentRoot")] = checkpoint.currentRoot;
+    obj[QLatin1String("pendingDirs")] = toJsonArray(checkpoint.pendingDirs);
+    obj[QLatin1String("cleanupDone")] = checkpoint.cleanupDone;
+    writeStatusJson(filePath, obj);
+}
+
+void IndexStateStore::markCrawlRootCompleted(const QString &root) const
+{
+    CrawlCheckpoint checkpoint = loadCrawlCheckpoint();
+    if (!checkpoint.isValid()) {
+        return;
+    }
+
+    if (!checkpoint.completedRoots.contains(root)) {
+        checkpoint.completedRoots.append(root);
+    }
+    checkpoint.currentRoot.clear();
+    checkpoint.pendingDirs.clear();
+    saveCrawlCheckpoint(checkpoint);
+}
+
+void IndexStateStore::removeCrawlCheckpoint() const
+{
+    const QString filePath = crawlCheckpointFilePath();
+    if (!filePath.isEmpty() && QFile::exists(filePath)) {
+        QFile::remove(filePath);
+    }
+}
+
 SERVICETEXTINDEX_END_NAMESPACE
@@ -9,9 +9,27 @@
 #include "utils/indexutility.h"
 
 #include <QDateTime>
+#include <QStringList>
 
 SERVICETEXTINDEX_BEGIN_NAMESPACE
 
+// 全量扫描任务（Create/Update）的断点，被打断或进程重启后据此继续遍历
+struct CrawlCheckpoint
+{
+    QString taskType;
+    QStringList roots;   // 任务的全部根路径
+    QStringList completedRoots;   // 已完整遍历并提交的根路径
+    QString currentRoot;
+    QStringList pendingDirs;   // 当前根路径下尚未遍历完的目录，首项可能已部分处理
+    bool cleanupDone { false };   // Update 任务对整个索引的失效清理是否已完成并提交
+
+    bool isValid() const { return !taskType.isEmpty(); }
+    bool matches(const QString &type, const QStringList &paths) const
+    {
+        return taskType == type && roots == paths;
+    }
+};
+
 class IndexStateStore
 {
 public:
@@ -39,6 +57,14 @@ public:
     // Used by incremental tasks which should not change the version number
     void saveLastUpdateTime(const QDateTime &lastUpdateTime) const;
 
+    // Crawl checkpoint lives in the index directory next to the status file,
+    // so clearing the index directory also drops it
+    QString crawlCheckpointFilePath() const;
+    CrawlCheckpoint loadCrawlCheckpoint() const;
+    void saveCrawlCheckpoint(const CrawlCheckpoint &checkpoint) const;
+    void markCrawlRootCompleted(const QString &root) const;
+    void removeCrawlCheckpoint() const;
+
 private:
     IndexProfile m_profile;
 };
@@ -33,8 +33,17 @@ void FileSystemProvider::traverse(TaskState &state, const FileHandler &handler)
 
     QMap<QString, QString> bindPathTable = IndexTraverseUtils::fstabBindInfo();
     QSet<QString> visitedDirs;
-    QQueue<QString> dirQueue;
-    dirQueue.enqueue(m_rootPath);
+    QQueue<QString> &dirQueue = m_dirQueue;
+    dirQueue.clear();
+    m_currentDir.clear();
+    if (m_resumeDirs.isEmpty()) {
+        dirQueue.enqueue(m_rootPath);
+    } else {
+        fmInfo() << "[FileSystemProvider::traverse] Resuming from checkpoint with" << m_resumeDirs.size()
+                 << "pending directories";
+        for (const QString &dir : std::as_const(m_resumeDirs))
+            dirQueue.enqueue(dir);
+    }
 
     int processedDirs = 0;
     int processedFiles = 0;
@@ -83,6 +92,7 @@ void FileSystemProvider::traverse(TaskState &state, const FileHandler &handler)
 
         ScopeGuard dirCloser([dir]() { closedir(dir); });
         processedDirs++;
+        m_currentDir = currentPath;
 
         struct dirent *entry;
         while ((entry = readdir(dir))) {
@@ -119,12 +129,40 @@ void FileSystemProvider::traverse(TaskState &state, const FileHandler &handler)
                 }
             }
         }
+
+        // 被打断时保留当前目录，续传时需要重新读取
+        if (state.isRunning())
+            m_currentDir.clear();
     }
 
     fmInfo() << "[FileSystemProvider::traverse] Traversal completed - processed directories:" << processedDirs
              << "files:" << processedFiles;
 }
 
+QStringList FileSystemProvider::pendingDirectories() const
+{
+    QStringList dirs;
+    dirs.reserve(m_dirQueue.size() + 1);
+    if (!m_currentDir.isEmpty())
+        dirs.append(m_currentDir);
+    for (const QString &dir : m_dirQueue)
+        dirs.append(dir);
+    return dirs;
+}
+
+bool FileSystemProvider::resumeFrom(const QStringList &dirs)
+{
+    for (const QString &dir : dirs) {
+        if (dir != m_rootPath && !dir.startsWith(m_rootPath.endsWith('/') ? m_rootPath : m_rootPath + '/')) {
+            fmWarning() << "[FileSystemProvider::resumeFrom] Checkpoint directory outside of root, ignoring checkpoint:" << dir;
+            return false;
+        }
+    }
+
+    m_resumeDirs = dirs;
+    return !m_resumeDirs.isEmpty();
+}
+
 DirectFileListProvider::DirectFileListProvider(const dfmsearch::SearchResultList &files)
     : m_fileList(files)
 {
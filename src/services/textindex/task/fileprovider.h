@@ -11,6 +11,7 @@
 
 #include <dfm-search/searchresult.h>
 
+#include <QQueue>
 #include <QString>
 #include <QStringList>
 #include <functional>
@@ -30,6 +31,15 @@ public:
     virtual void traverse(TaskState &state, const FileHandler &handler) = 0;
     virtual qint64 totalCount() { return 0; }
     virtual QString name() { return ""; }
+
+    // 断点续传：返回尚未遍历完成的目录，首项可能已部分处理；不支持时返回空
+    virtual QStringList pendingDirectories() const { return {}; }
+    // 从断点目录继续遍历，不支持时返回 false
+    virtual bool resumeFrom(const QStringList &dirs)
+    {
+        Q_UNUSED(dirs)
+        return false;
+    }
 };
 
 // 文件系统遍历提供者
@@ -40,9 +50,15 @@ public:
     void traverse(TaskState &state, const FileHandler &handler) override;
     QString name() override { return "FileSystemProvider"; }
 
+    QStringList pendingDirectories() const override;
+    bool resumeFrom(const QStringList &dirs) override;
+
 private:
     IndexProfile m_profile;
     QString m_rootPath;
+    QStringList m_resumeDirs;
+    QQueue<QString> m_dirQueue;
+    QString m_currentDir;   // 正在读取的目录，读取完毕后清空
 };
 
 // 直接文件列表提供者
@@ -153,6 +153,8 @@ public:
                 m_writer->commit();
                 m_lastCommitCount = processedCount;
                 fmDebug() << "[ProgressReporter::increment] Batch commit completed at count:" << processedCount;
+                if (m_commitCallback)
+                    m_commitCallback();
             } catch (const std::exception &e) {
                 fmWarning() << "[ProgressReporter::increment] Batch commit failed at count:" << processedCount
                             << "error:" << e.what();
@@ -179,6 +181,12 @@ public:
         m_indexChanged = true;
     }
 
+    // 每次批量提交成功后回调，此时已处理的文件均已落盘，可用于记录断点
+    void setCommitCallback(std::function<void()> callback)
+    {
+        m_commitCallback = std::move(callback);
+    }
+
     bool indexChanged() const
     {
         return m_indexChanged;
@@ -192,8 +200,78 @@ private:
     int m_batchCommitInterval;
     qint64 m_lastCommitCount;
     bool m_indexChanged { false };
+    std::function<void()> m_commitCallback;
 };
 
+// 全量扫描任务的断点记录
+// 每次批量提交后都要写入：断点之后提交的目录在续传时会被当作未处理，重新添加产生重复文档
+class CrawlCheckpointRecorder
+{
+public:
+    CrawlCheckpointRecorder(const IndexContext &context, const QString &taskType, const QString &root)
+        : m_store(context.stateStore())
+    {
+        if (!m_store)
+            return;
+
+        m_checkpoint = m_store->loadCrawlCheckpoint();
+        if (m_checkpoint.taskType != taskType) {
+            // TaskManager 在启动任务时写入任务信息，类型不符说明断点属于其他任务
+            m_checkpoint = CrawlCheckpoint();
+            m_checkpoint.taskType = taskType;
+            m_checkpoint.roots = QStringList { root };
+        }
+        if (m_checkpoint.currentRoot != root) {
+            m_checkpoint.currentRoot = root;
+            m_checkpoint.pendingDirs.clear();
+        }
+    }
+
+    // 上次在此根路径下中断时尚未完成的目录
+    QStringList resumeDirectories() const { return m_checkpoint.pendingDirs; }
+    bool cleanupDone() const { return m_checkpoint.cleanupDone; }
+
+    void setCleanupDone()
+    {
+        m_checkpoint.cleanupDone = true;
+        save();
+    }
+
+    void record(const FileProvider *provider, bool force = false)
+    {
+        if (!m_store)
+            return;
+
+        const QStringList pending = provider->pendingDirectories();
+        // 不支持断点的提供者（如 ANYTHING 文件列表）不记录目录队列
+        if (pending.isEmpty() && !force)
+            return;
+
+        m_checkpoint.pendingDirs = pending;
+        save();
+    }
+
+private:
+    void save()
+    {
+        if (!m_store)
+            return;
+        m_store->saveCrawlCheckpoint(m_checkpoint);
+    }
+
+    const IndexStateStore *m_store { nullptr };
+    CrawlCheckpoint m_checkpoint;
+};
+
+// 判断文件是否直接位于目录下
+bool isDirectChild(const QString &dir, const QString &file)
+{
+    const int slash = file.lastIndexOf('/');
+    if (slash < 0)
+        return false;
+    return slash == 0 ? dir == QLatin1String("/") : QStringView(file).left(slash) == dir;
+}
+
 // 目录遍历相关函数
 using FileHandler = std::function<void(const QString &path)>;
 
@@ -672,9 +750,31 @@ TaskHandler TaskHandlers::CreateIndexHandler(const IndexContext &context)
         QString indexDir = context.profile().indexDirectory();
 
         try {
+            // 使用文件提供者遍历文件
+            auto provider = createFileProvider(context, path);
+            if (!provider) {
+                fmCritical() << "[CreateIndexHandler] Failed to create file provider for path:" << path;
+                return result;
+            }
+
+            if (provider->name() == "DirectFileListProvider") {
+                result.useAnything = true;
+                fmInfo() << "[CreateIndexHandler] Using ANYTHING for file discovery";
+            }
+
+            // 上次被打断的创建任务已提交的部分保留在索引中，从断点继续遍历
+            CrawlCheckpointRecorder checkpoint(context, QStringLiteral("create"), path);
+            const QStringList resumeDirs = checkpoint.resumeDirectories();
+            const bool resume = !resumeDirs.isEmpty() && QDir(indexDir).exists() && provider->resumeFrom(resumeDirs);
+            if (resume)
+                fmInfo() << "[CreateIndexHandler] Resuming interrupted index creation from checkpoint, pending directories:"
+                         << resumeDirs.size();
+
             // 尝试从旧索引迁移内容（版本升级时避免重新提取）
+            // 续传时当前索引目录即为未完成的新索引，只复用已有的 .old 残留
             IndexContentMigrator migrator;
-            migrator.prepare(indexDir, context.profile());
+            if (!resume || IndexContentMigrator::hasResidue(indexDir))
+                migrator.prepare(indexDir, context.profile());
 
             // ensure index directory exists (prepare() may have renamed it away)
             if (!dir.exists(indexDir)) {
@@ -692,10 +792,24 @@ TaskHandler TaskHandlers::CreateIndexHandler(const IndexContext &context)
                 fmInfo() << "[CreateIndexHandler] Re-saved index status after migration rename";
             }
 
+            // 续传时断点处的目录可能已有部分文件提交，需要对照已有索引避免重复添加
+            IndexReaderPtr reader;
+            if (resume)
+                reader = IndexReader::open(FSDirectory::open(indexDir.toStdWString()), true);
+
+            ScopeGuard readerCloser([&reader]() {
+                try {
+                    if (reader)
+                        reader->close();
+                } catch (...) {
+                    fmWarning() << "[CreateIndexHandler] Exception occurred while closing index reader";
+                }
+            });
+
             IndexWriterPtr writer = newLucene<IndexWriter>(
                     FSDirectory::open(indexDir.toStdWString()),
                     boost::static_pointer_cast<Lucene::Analyzer>(context.profile().createAnalyzer()),
-                    true,
+                    !resume,
                     IndexWriter::MaxFieldLengthUNLIMITED);
 
             // 添加 writer 的 ScopeGuard
@@ -712,28 +826,25 @@ TaskHandler TaskHandlers::CreateIndexHandler(const IndexContext &context)
 
             fmInfo() << "[CreateIndexHandler] Index writer initialized, target directory:" << indexDir;
 
-            writer->deleteAll();
-            fmInfo() << "[CreateIndexHandler] Cleared existing index data";
-
-            // 使用文件提供者遍历文件
-            auto provider = createFileProvider(context, path);
-            if (!provider) {
-                fmCritical() << "[CreateIndexHandler] Failed to create file provider for path:" << path;
-                return result;
-            }
-
-            if (provider->name() == "DirectFileListProvider") {
-                result.useAnything = true;
-                fmInfo() << "[CreateIndexHandler] Using ANYTHING for file discovery";
+            if (!resume) {
+                writer->deleteAll();
+                fmInfo() << "[CreateIndexHandler] Cleared existing index data";
             }
 
             ProgressReporter reporter(writer);
+            reporter.setCommitCallback([&]() { checkpoint.record(provider.get()); });
             const PathExcludeMatcher excludeMatcher = PathExcludeMatcher::createForIndex();
             qint64 totalCount = provider->totalCount();
             reporter.setTotal(totalCount);
             fmInfo() << "[CreateIndexHandler] Starting file processing, estimated total files:" << totalCount;
 
+            const QString partialDir = resume ? resumeDirs.first() : QString();
             provider->traverse(running, [&](const QString &file) {
+                if (reader && isDirectChild(partialDir, file)) {
+                    updateFile(context, file, excludeMatcher, reader, writer, &reporter,
+                               migrator.isActive() ? &migrator : nullptr);
+                    return;
+                }
                 processFile(context, file, excludeMatcher, writer, &reporter,
                       migrator.isActive() ? &migrator : nullptr);
             });
@@ -742,6 +853,9 @@ TaskHandler TaskHandlers::CreateIndexHandler(const IndexContext &context)
             // Created indexes must be guaranteed to be complete
             if (!running.isRunning()) {
                 fmWarning() << "[CreateIndexHandler] Index creation was interrupted by user request";
+                // 提交已处理的文件并记录断点，下次创建任务从此处继续
+                writer->commit();
+                checkpoint.record(provider.get(), true);
                 result.interrupted = true;
                 result.success = false;   // 创建被打断若不失败索引是不完整的
                 return result;
@@ -826,13 +940,19 @@ TaskHandler TaskHandlers::UpdateIndexHandler(const IndexContext &context)
             fmDebug() << "[UpdateIndexHandler] Index reader and writer initialized for directory:" << indexDir;
 
             ProgressReporter reporter(writer);
+            CrawlCheckpointRecorder checkpoint(context, QStringLiteral("update"), path);
 
-            // 清理已删除文件的索引
-            if (!cleanupIndexs(context, reader, writer, running, &reporter)) {
+            // 清理已删除文件的索引，被打断前已完成的清理不再重复
+            if (checkpoint.cleanupDone()) {
+                fmInfo() << "[UpdateIndexHandler] Index cleanup already done before interruption, skipping";
+            } else if (!cleanupIndexs(context, reader, writer, running, &reporter)) {
                 fmCritical() << "[UpdateIndexHandler] Index cleanup failed, aborting update";
                 result.success = false;
                 result.fatal = true;
                 return result;
+            } else if (running.isRunning()) {
+                writer->commit();
+                checkpoint.setCleanupDone();
             }
 
             // 使用文件提供者遍历文件
@@ -847,6 +967,12 @@ TaskHandler TaskHandlers::UpdateIndexHandler(const IndexContext &context)
                 fmInfo() << "[UpdateIndexHandler] Using ANYTHING for file discovery";
             }
 
+            const QStringList resumeDirs = checkpoint.resumeDirectories();
+            if (!resumeDirs.isEmpty() && provider->resumeFrom(resumeDirs))
+                fmInfo() << "[UpdateIndexHandler] Resuming interrupted index update from checkpoint, pending directories:"
+                         << resumeDirs.size();
+            reporter.setCommitCallback([&]() { checkpoint.record(provider.get()); });
+
             const PathExcludeMatcher excludeMatcher = PathExcludeMatcher::createForIndex();
             qint64 totalCount = provider->totalCount();
             reporter.setTotal(totalCount);
@@ -865,6 +991,8 @@ TaskHandler TaskHandlers::UpdateIndexHandler(const IndexContext &context)
             // ProgressReporter的析构函数会处理最后的commit，确保所有更改都已提交
             fmDebug() << "[UpdateIndexHandler] Ensuring all changes are committed";
             writer->commit();
+            if (result.interrupted)
+                checkpoint.record(provider.get(), true);
 
             // 不再调用 optimize()：增量更新场景下 lucene++ 的自动合并策略已足够保证查询性能
             // optimize() 会强制合并所有 segment 为单个 segment，产生巨大的 IO 开销
@@ -172,10 +172,27 @@ bool TaskManager::startTask(IndexTask::Type type, const QStringList &pathList, b
         return false;
     }
 
+    // 同一任务之前被打断时保留了断点，沿用断点跳过已完成的根路径；否则为本任务写入新断点
+    const IndexStateStore *stateStore = m_context ? m_context->stateStore() : nullptr;
+    QStringList completedRoots;
+    if (stateStore) {
+        CrawlCheckpoint checkpoint = stateStore->loadCrawlCheckpoint();
+        if (checkpoint.matches(typeToString(type), pathList)) {
+            completedRoots = checkpoint.completedRoots;
+            fmInfo() << "[TaskManager::startTask] Resuming from crawl checkpoint - completed roots:" << completedRoots.size()
+                     << "current root:" << checkpoint.currentRoot << "pending directories:" << checkpoint.pendingDirs.size();
+        } else {
+            checkpoint = CrawlCheckpoint();
+            checkpoint.taskType = typeToString(type);
+            checkpoint.roots = pathList;
+            stateStore->saveCrawlCheckpoint(checkpoint);
+        }
+    }
+
     Q_ASSERT(!currentTask);
     // 创建新的任务对象，使用路径列表作为输入
     // 注意：为了最小修改现有代码，我们仍然将主路径作为任务路径，但在handler中会使用整个路径列表
-    currentTask = new IndexTask(type, primaryPath, [handler, pathList](const QString &, TaskState &state) -> HandlerResult {
+    currentTask = new IndexTask(type, primaryPath, [handler, pathList, completedRoots, stateStore](const QString &, TaskState &state) -> HandlerResult {
         fmDebug() << "[TaskManager::startTask] Executing task handler for" << pathList.size() << "paths";
         // 在这个lambda中，我们会对每个路径执行原始的handler
         HandlerResult finalResult { true, false, false, false };
@@ -187,6 +204,11 @@ bool TaskManager::startTask(IndexTask::Type type, const QStringList &pathList, b
                 break;
             }
 
+            if (completedRoots.contains(path)) {
+                fmInfo() << "[TaskManager::startTask] Path already completed before interruption, skipping:" << path;
+                continue;
+            }
+
             fmDebug() << "[TaskManager::startTask] Processing path:" << path;
             // 对每个路径执行handler
             HandlerResult pathResult = handler(path, state);
@@ -218,6 +240,10 @@ bool TaskManager::startTask(IndexTask::Type type, const QStringList &pathList, b
             if (pathResult.indexChanged) {
                 finalResult.indexChanged = true;
             }
+
+            if (pathResult.success && stateStore) {
+                stateStore->markCrawlRootCompleted(path);
+            }
         }
 
         fmInfo() << "[TaskManager::startTask] Task handler execution completed - success:" << finalResult.success
@@ -440,6 +466,10 @@ void TaskManager::onTaskFinished(IndexTask::Type type, HandlerResult result)
     if (handleCorruptedIndex(type, result, taskPath))
         return;
 
+    // 全量扫描未被打断即结束（无论成败），断点不再有意义
+    if (isFullScanTask(type) && !result.interrupted && m_context && m_context->stateStore())
+        m_context->stateStore()->removeCrawlCheckpoint();
+
     fmDebug() << "[TaskManager::onTaskFinished] Task" << typeToString(type) << "for path" << taskPath
               << (result.success ? "completed successfully" : "failed");
 
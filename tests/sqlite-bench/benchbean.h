@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef BENCHBEAN_H
+#define BENCHBEAN_H
+
+#include <QObject>
+
+class BenchBean : public QObject
+{
+    Q_OBJECT
+
+    Q_CLASSINFO("TableName", "bench")
+    Q_PROPERTY(int rowId READ getRowId WRITE setRowId)
+    Q_PROPERTY(QString filePath READ getFilePath WRITE setFilePath)
+    Q_PROPERTY(QString tagName READ getTagName WRITE setTagName)
+    Q_PROPERTY(int tagOrder READ getTagOrder WRITE setTagOrder)
+
+public:
+    explicit BenchBean(QObject *parent = nullptr)
+        : QObject(parent) { }
+
+    int getRowId() const { return rowId; }
+    void setRowId(int value) { rowId = value; }
+
+    QString getFilePath() const { return filePath; }
+    void setFilePath(const QString &value) { filePath = value; }
+
+    QString getTagName() const { return tagName; }
+    void setTagName(const QString &value) { tagName = value; }
+
+    int getTagOrder() const { return tagOrder; }
+    void setTagOrder(int value) { tagOrder = value; }
+
+private:
+    int rowId {};
+    QString filePath {};
+    QString tagName {};
+    int tagOrder {};
+};
+
+#endif   // BENCHBEAN_H
@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// SqliteHandle 微基准：对比逐条拼接 SQL、预编译单条插入与批量接口的耗时
+// 用法：test-sqlite-bench [行数] [--wal]
+
+#include "benchbean.h"
+
+#include <dfm-base/base/db/sqlitehandle.h>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+#include <memory>
+#include <vector>
+
+DFMBASE_USE_NAMESPACE
+
+namespace {
+
+// 改动前的插入路径：值直接拼进 SQL 文本，每次重新编译
+bool legacyInsert(SqliteHandle *handle, const BenchBean &bean)
+{
+    return handle->excute(QString("INSERT INTO bench(filePath,tagName,tagOrder) VALUES ('%1','%2',%3);")
+                                  .arg(bean.getFilePath(), bean.getTagName())
+                                  .arg(bean.getTagOrder()));
+}
+
+void report(const char *name, int rows, qint64 ms)
+{
+    QTextStream(stdout) << QString("%1 %2 rows: %3 ms (%4 rows/s)\n")
+                                   .arg(name, -24)
+                                   .arg(rows)
+                                   .arg(ms)
+                                   .arg(ms > 0 ? rows * 1000 / ms : rows);
+}
+
+}   // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    const QStringList args = app.arguments();
+    const int rows = args.size() > 1 && args.at(1).toInt() > 0 ? args.at(1).toInt() : 5000;
+    const bool wal = args.contains("--wal");
+
+    QTemporaryDir dir;
+    if (!dir.isValid())
+        return 1;
+
+    std::vector<std::unique_ptr<BenchBean>> beans;
+    beans.reserve(static_cast<size_t>(rows));
+    for (int i = 0; i < rows; ++i) {
+        std::unique_ptr<BenchBean> bean(new BenchBean);
+        bean->setFilePath(QString("/home/user/Documents/file_%1.txt").arg(i));
+        bean->setTagName(QString("tag%1").arg(i % 8));
+        bean->setTagOrder(i);
+        beans.push_back(std::move(bean));
+    }
+
+    auto freshHandle = [&dir, wal](const QString &name) {
+        std::unique_ptr<SqliteHandle> handle(new SqliteHandle(dir.filePath(name)));
+        if (wal) {
+            SqliteConnectionOptions options;
+            options.walMode = true;
+            options.synchronous = SqliteConnectionOptions::Synchronous::kNormal;
+            handle->setConnectionOptions(options);
+        }
+        handle->createTable<BenchBean>(SqliteConstraint::primary("rowId"),
+                                       SqliteConstraint::autoIncreament("rowId"));
+        return handle;
+    };
+
+    QElapsedTimer timer;
+
+    {
+        auto handle = freshHandle("legacy.db");
+        timer.start();
+        handle->transaction([&]() {
+            for (const auto &bean : beans)
+                legacyInsert(handle.get(), *bean);
+            return true;
+        });
+        report("string-built insert", rows, timer.elapsed());
+    }
+
+    {
+        auto handle = freshHandle("prepared.db");
+        timer.start();
+        handle->transaction([&]() {
+            for (const auto &bean : beans)
+                handle->insert<BenchBean>(*bean);
+            return true;
+        });
+        report("prepared insert", rows, timer.elapsed());
+    }
+
+    {
+        auto handle = freshHandle("bulk.db");
+        timer.start();
+        handle->insertMany<BenchBean>(beans);
+        report("insertMany", rows, timer.elapsed());
+
+        QVariantList paths;
+        QVariantList orders;
+        for (const auto &bean : beans) {
+            paths.append(bean->getFilePath());
+            orders.append(bean->getTagOrder() + 1);
+        }
+
+        timer.start();
+        handle->updateMany<BenchBean>("tagOrder", orders, "filePath", paths);
+        report("updateMany", rows, timer.elapsed());
+
+        timer.start();
+        handle->removeMany<BenchBean>("filePath", paths);
+        report("removeMany", rows, timer.elapsed());
+    }
+
+    return 0;
+}